@@ -0,0 +1,280 @@
+/**
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * CS 5008
+ * Implementation of the all-pairs shortest path table
+ */
+
+#include "apsp.h"
+#include "parallel.h"
+#include <math.h>   // For log2
+#include <stdlib.h> // For malloc, free
+
+#define APSP_EDGE_COST 12.0 // Floyd-Warshall steps one road relaxation costs (measured by bench apsp)
+#define APSP_HEAP_COST 34.0 // Floyd-Warshall steps one heap level of one settled vertex costs
+#define UNRESOLVED -2           // Next hop not worked out yet
+
+// Shared state of one Floyd-Warshall phase or one round of Dijkstra rows
+typedef struct ApspJob {
+    Graph* graph;
+    AllPairsTable* table;
+    int kb;                   // First vertex of the current pivot tile (Floyd-Warshall)
+    int num_tiles;            // Tiles per matrix side
+    DijkstraWorkspace** ws;   // One per worker (Dijkstra)
+    int** stack;              // One per worker, for resolving next hops
+} ApspJob;
+
+/**
+ * d[j] = min(d[j], dik + dk[j]) over one tile row, moving next hops along
+ * Written without branches so the compiler turns it into vector min/blend
+ * instructions (16 ints per 64-byte line).
+ */
+static void relax_row(int* restrict d, int* restrict next, const int* restrict dk, int dik, int nik) {
+    for (int j = 0; j < APSP_BLOCK; j++) {
+        int through = dik + dk[j];
+        int better = through < d[j];
+        d[j] = better ? through : d[j];
+        next[j] = better ? nik : next[j];
+    }
+}
+
+/**
+ * Relax tile (ib, jb) through every pivot of tile kb, pivots outermost
+ * Row k is skipped as a target: d[k][k] = 0 leaves it unchanged anyway.
+ */
+static void relax_tile(AllPairsTable* table, int ib, int jb, int kb) {
+    int stride = table->stride;
+    for (int k = kb; k < kb + APSP_BLOCK; k++) {
+        const int* dk = table->dist + (size_t)k * stride + jb;
+        for (int i = ib; i < ib + APSP_BLOCK; i++) {
+            size_t ik = (size_t)i * stride + k;
+            int dik = table->dist[ik];
+            if (i == k || dik >= APSP_INFINITY) continue;
+            relax_row(table->dist + (size_t)i * stride + jb, table->next + (size_t)i * stride + jb, dk,
+                      dik, table->next[ik]);
+        }
+    }
+}
+
+/**
+ * parallel_for task: the tiles sharing a row or column with the pivot tile
+ */
+static void relax_cross_tile(void* context, int worker, int index) {
+    (void)worker;
+    ApspJob* job = (ApspJob*)context;
+    int t = index % job->num_tiles * APSP_BLOCK;
+    if (t == job->kb) return;  // The pivot tile itself is done first
+    if (index < job->num_tiles) relax_tile(job->table, job->kb, t, job->kb);  // Pivot row
+    else relax_tile(job->table, t, job->kb, job->kb);                           // Pivot column
+}
+
+/**
+ * parallel_for task: a tile outside the pivot row and column
+ */
+static void relax_other_tile(void* context, int worker, int index) {
+    (void)worker;
+    ApspJob* job = (ApspJob*)context;
+    int ib = index / job->num_tiles * APSP_BLOCK;
+    int jb = index % job->num_tiles * APSP_BLOCK;
+    if (ib == job->kb || jb == job->kb) return;
+    relax_tile(job->table, ib, jb, job->kb);
+}
+
+/**
+ * Blocked Floyd-Warshall: for each pivot tile, settle it, then its row and
+ * column, then everything else, which only reads those and runs in parallel
+ */
+static void fill_floyd(AllPairsTable* table, const CsrGraph* csr, int num_threads) {
+    int n = table->num_vertices;
+    int stride = table->stride;
+    size_t cells = (size_t)stride * stride;
+    for (size_t c = 0; c < cells; c++) {
+        table->dist[c] = APSP_INFINITY;
+        table->next[c] = -1;
+    }
+    for (int u = 0; u < n; u++) {
+        size_t row = (size_t)u * stride;
+        table->dist[row + u] = 0;
+        table->next[row + u] = u;
+        for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++) {
+            int v = csr->dest[e];
+            if (csr->weight[e] < table->dist[row + v]) {
+                table->dist[row + v] = csr->weight[e];
+                table->next[row + v] = v;
+            }
+        }
+    }
+
+    ApspJob job;
+    job.table = table;
+    job.num_tiles = stride / APSP_BLOCK;
+    for (job.kb = 0; job.kb < stride; job.kb += APSP_BLOCK) {
+        relax_tile(table, job.kb, job.kb, job.kb);
+        parallel_for(2 * job.num_tiles, num_threads, relax_cross_tile, &job);
+        parallel_for(job.num_tiles * job.num_tiles, num_threads, relax_other_tile, &job);
+    }
+}
+
+/**
+ * parallel_for task: one full Dijkstra from source fills its rows
+ * The next hop toward v is the ancestor of v whose parent is the source;
+ * each is found once, by walking up to the first vertex already resolved.
+ */
+static void fill_dijkstra_row(void* context, int worker, int source) {
+    ApspJob* job = (ApspJob*)context;
+    AllPairsTable* table = job->table;
+    DijkstraWorkspace* ws = job->ws[worker];
+    int* stack = job->stack[worker];
+    int n = table->num_vertices;
+    int* dist = table->dist + (size_t)source * table->stride;
+    int* next = table->next + (size_t)source * table->stride;
+
+    dijkstra_search_all(job->graph, ws, source);
+    for (int v = 0; v < table->stride; v++) {
+        int d = v < n ? dijkstra_workspace_distance(ws, v) : INT_MAX;
+        dist[v] = d == INT_MAX ? APSP_INFINITY : d;
+        next[v] = d == INT_MAX ? -1 : UNRESOLVED;
+    }
+    next[source] = source;
+
+    for (int v = 0; v < n; v++) {
+        int depth = 0;
+        int u = v;
+        while (next[u] == UNRESOLVED && ws->parent[u] != source) {
+            stack[depth++] = u;
+            u = ws->parent[u];
+        }
+        if (next[u] == UNRESOLVED) next[u] = u;  // u hangs off the source directly
+        while (depth > 0) next[stack[--depth]] = next[u];
+    }
+}
+
+/**
+ * One Dijkstra per source, spread over threads with a workspace each
+ */
+static void fill_dijkstra(AllPairsTable* table, Graph* graph, int num_threads) {
+    int n = table->num_vertices;
+    ApspJob job;
+    job.graph = graph;
+    job.table = table;
+    job.ws = (DijkstraWorkspace**)malloc(sizeof(DijkstraWorkspace*) * num_threads);
+    job.stack = (int**)malloc(sizeof(int*) * num_threads);
+    for (int t = 0; t < num_threads; t++) {
+        job.ws[t] = dijkstra_workspace_create(n);
+        job.stack[t] = (int*)malloc(sizeof(int) * (n > 0 ? n : 1));
+    }
+
+    parallel_for(n, num_threads, fill_dijkstra_row, &job);
+    for (size_t c = (size_t)n * table->stride; c < (size_t)table->stride * table->stride; c++) {
+        table->dist[c] = APSP_INFINITY;  // Padding rows
+        table->next[c] = -1;
+    }
+
+    for (int t = 0; t < num_threads; t++) {
+        dijkstra_workspace_destroy(job.ws[t]);
+        free(job.stack[t]);
+    }
+    free(job.ws);
+    free(job.stack);
+}
+
+/**
+ * True if some road has length 0 or less
+ * Read from the frozen layout, which is all a snapshot graph has.
+ */
+static bool has_free_road(const CsrGraph* csr) {
+    for (int e = 0; e < csr->num_edges; e++) {
+        if (csr->weight[e] <= 0) return true;
+    }
+    return false;
+}
+
+/**
+ * Pick the cheaper method for this graph
+ * Floyd-Warshall does V^3 vectorised steps whatever the roads; repeated
+ * Dijkstra relaxes E roads and pops V vertices off a log V deep heap per
+ * source, each worth many of those steps.
+ * Roads of length 0 or less always go to Floyd-Warshall: next hops taken
+ * from separate Dijkstra trees could loop on them.
+ */
+ApspMethod apsp_choose(Graph* graph) {
+    const CsrGraph* csr = graph_freeze(graph);
+    if (has_free_road(csr)) return APSP_FLOYD;
+    double n = graph->num_vertices;
+    double edges = csr->num_edges;
+    double floyd = n * n * n;
+    double dijkstra = n * (APSP_EDGE_COST * edges + APSP_HEAP_COST * n * log2(n + 2));
+    return floyd < dijkstra ? APSP_FLOYD : APSP_DIJKSTRA;
+}
+
+/**
+ * Name of a method for reports
+ */
+const char* apsp_method_name(ApspMethod method) {
+    switch (method) {
+        case APSP_FLOYD: return "floyd-warshall";
+        case APSP_DIJKSTRA: return "dijkstra";
+        default: return "auto";
+    }
+}
+
+/**
+ * Build the table with the given method (APSP_AUTO picks one)
+ */
+AllPairsTable* apsp_build(Graph* graph, ApspMethod method, int num_threads) {
+    int n = graph->num_vertices;
+    if (n > APSP_MAX_VERTICES) return NULL;
+    const CsrGraph* csr = graph_freeze(graph);
+    if (num_threads < 1) num_threads = 1;
+
+    if (method == APSP_AUTO) method = apsp_choose(graph);
+    else if (method == APSP_DIJKSTRA && has_free_road(csr)) method = APSP_FLOYD;
+
+    AllPairsTable* table = (AllPairsTable*)malloc(sizeof(AllPairsTable));
+    table->num_vertices = n;
+    table->stride = (n + APSP_BLOCK - 1) / APSP_BLOCK * APSP_BLOCK;
+    if (table->stride == 0) table->stride = APSP_BLOCK;
+    size_t cells = (size_t)table->stride * table->stride;
+    table->dist = (int*)malloc(sizeof(int) * cells);
+    table->next = (int*)malloc(sizeof(int) * cells);
+    table->method = method;
+    table->graph_version = graph->version;
+
+    if (method == APSP_FLOYD) fill_floyd(table, csr, num_threads);
+    else fill_dijkstra(table, graph, num_threads);
+    return table;
+}
+
+/**
+ * Free a table
+ */
+void apsp_destroy(AllPairsTable* table) {
+    if (!table) return;
+    free(table->dist);
+    free(table->next);
+    free(table);
+}
+
+/**
+ * Shortest path from the table: follow next hops from `from` until `to`
+ */
+PathResult apsp_path(const AllPairsTable* table, int from, int to) {
+    PathResult result = path_result_unreachable();
+    int d = apsp_distance(table, from, to);
+    if (d == INT_MAX) return result;
+
+    const int* next = table->next;
+    int length = 1;
+    for (int v = from; v != to; v = next[(size_t)v * table->stride + to]) length++;
+
+    result.path = (int*)malloc(sizeof(int) * length);
+    int i = 0;
+    for (int v = from; ; v = next[(size_t)v * table->stride + to]) {
+        result.path[i++] = v;
+        if (v == to) break;
+    }
+    result.path_length = length;
+    result.total_distance = d;
+    result.found = true;
+    return result;
+}
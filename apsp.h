@@ -0,0 +1,62 @@
+/**
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * CS 5008
+ * All-pairs shortest path table for small and medium graphs
+ *
+ * Every distance is computed once into a dense matrix, together with the
+ * next hop from each city toward each other city, so a query is a table
+ * lookup and a path is a walk along next hops. Dense graphs are filled by
+ * a cache-blocked Floyd-Warshall, sparse ones by one Dijkstra search per
+ * source spread over threads. Memory is 8 bytes per pair.
+ */
+
+#ifndef APSP_H
+#define APSP_H
+
+#include "graph.h"
+#include "dijkstra.h"
+#include <limits.h>
+#include <stdbool.h>
+
+#define APSP_MAX_VERTICES 8192 // Largest graph a table is built for (512 MB of matrices)
+#define APSP_BLOCK 64          // Floyd-Warshall tile side; the matrix stride is a multiple of it
+#define APSP_INFINITY (INT_MAX / 2) // Stored distance of an unreachable pair (two still add up safely)
+
+// How the table is filled
+typedef enum ApspMethod {
+    APSP_AUTO,     // Pick by density (see apsp_choose)
+    APSP_FLOYD,    // Blocked Floyd-Warshall, O(V^3) with vectorisable inner loops
+    APSP_DIJKSTRA  // One full Dijkstra per source, O(V (E + V) log V)
+} ApspMethod;
+
+// Distances and next hops between every pair of vertices
+typedef struct AllPairsTable {
+    int num_vertices;
+    int stride;         // Row length of both matrices (num_vertices rounded up to APSP_BLOCK)
+    int* dist;          // dist[from * stride + to], APSP_INFINITY if unreachable
+    int* next;          // First vertex after from on a shortest path to to, -1 if unreachable
+    ApspMethod method;  // Method that filled the table
+    unsigned int graph_version; // Graph version the table describes
+} AllPairsTable;
+
+// Build the table (freezes the graph); NULL if the graph has more than APSP_MAX_VERTICES vertices
+AllPairsTable* apsp_build(Graph* graph, ApspMethod method, int num_threads);
+void apsp_destroy(AllPairsTable* table);
+
+// Method APSP_AUTO picks for this graph (freezes the graph)
+ApspMethod apsp_choose(Graph* graph);
+const char* apsp_method_name(ApspMethod method);
+
+// Shortest path read from the table (settled is 0: nothing is searched)
+PathResult apsp_path(const AllPairsTable* table, int from, int to);
+
+/**
+ * Distance from one vertex to another, INT_MAX if unreachable
+ */
+static inline int apsp_distance(const AllPairsTable* table, int from, int to) {
+    int d = table->dist[(size_t)from * table->stride + to];
+    return d >= APSP_INFINITY ? INT_MAX : d;
+}
+
+#endif
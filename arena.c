@@ -0,0 +1,98 @@
+/**
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * CS 5008
+ * Implementation of the bump (arena) allocator
+ */
+
+#include "arena.h"
+#include <stdlib.h> // For malloc, free
+#include <string.h> // For memcpy, strlen
+
+#define ARENA_ALIGNMENT sizeof(void*)          // Alignment of arena_alloc results
+#define ARENA_MAX_BLOCK_SIZE (16u << 20)       // Stop doubling blocks at 16 MB
+
+/**
+ * Add a block with room for at least min_size bytes
+ */
+static void add_block(Arena* arena, size_t min_size) {
+    size_t size = arena->next_block_size;
+    while (size < min_size) size *= 2;
+
+    ArenaBlock* block = (ArenaBlock*)malloc(sizeof(ArenaBlock) + size);
+    block->next = arena->head;
+    block->size = size;
+    block->used = 0;
+    arena->head = block;
+
+    arena->bytes_reserved += size;
+    arena->num_blocks++;
+    if (arena->next_block_size < ARENA_MAX_BLOCK_SIZE) arena->next_block_size *= 2;
+}
+
+/**
+ * Create an empty arena; no memory is reserved until the first allocation
+ */
+Arena* arena_create(size_t initial_block_size) {
+    Arena* arena = (Arena*)malloc(sizeof(Arena));
+    arena->head = NULL;
+    arena->next_block_size = initial_block_size > 0 ? initial_block_size : 4096;
+    arena->bytes_used = 0;
+    arena->bytes_reserved = 0;
+    arena->num_blocks = 0;
+    return arena;
+}
+
+/**
+ * Free every block and the arena itself
+ */
+void arena_destroy(Arena* arena) {
+    if (!arena) return;
+
+    ArenaBlock* block = arena->head;
+    while (block) {
+        ArenaBlock* temp = block;  // Save current block
+        block = block->next;       // Move to previous block
+        free(temp);
+    }
+
+    free(arena);
+}
+
+/**
+ * Allocate size bytes aligned to a pointer boundary
+ */
+void* arena_alloc(Arena* arena, size_t size) {
+    ArenaBlock* block = arena->head;
+    size_t offset = block ? (block->used + ARENA_ALIGNMENT - 1) & ~(ARENA_ALIGNMENT - 1) : 0;
+
+    // Start a new block when the current one is full
+    if (!block || offset + size > block->size) {
+        add_block(arena, size);
+        block = arena->head;
+        offset = 0;
+    }
+
+    block->used = offset + size;
+    arena->bytes_used += size;
+    return block->data + offset;
+}
+
+/**
+ * Copy a string into the arena (no alignment padding)
+ */
+char* arena_strdup(Arena* arena, const char* str) {
+    size_t size = strlen(str) + 1;  // +1 for null terminator
+    ArenaBlock* block = arena->head;
+
+    if (!block || block->used + size > block->size) {
+        add_block(arena, size);
+        block = arena->head;
+    }
+
+    char* copy = block->data + block->used;
+    memcpy(copy, str, size);
+    block->used += size;
+    arena->bytes_used += size;
+    return copy;
+}
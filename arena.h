@@ -0,0 +1,36 @@
+/**
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * CS 5008
+ * Bump (arena) allocator - many small allocations, freed all at once
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+// One contiguous chunk of arena memory
+typedef struct ArenaBlock {
+    struct ArenaBlock* next; // Previously filled block
+    size_t size;             // Usable bytes in data
+    size_t used;             // Bytes handed out so far
+    char data[];             // Block storage
+} ArenaBlock;
+
+// Arena made of a chain of blocks; each new block is twice the previous size
+typedef struct Arena {
+    ArenaBlock* head;        // Block currently being filled
+    size_t next_block_size;  // Size of the next block to allocate
+    size_t bytes_used;       // Total bytes handed out
+    size_t bytes_reserved;   // Total bytes obtained from malloc
+    int num_blocks;          // Number of blocks (= number of free calls on destroy)
+} Arena;
+
+// Arena operations
+Arena* arena_create(size_t initial_block_size);
+void arena_destroy(Arena* arena);
+void* arena_alloc(Arena* arena, size_t size);
+char* arena_strdup(Arena* arena, const char* str);
+
+#endif
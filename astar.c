@@ -0,0 +1,268 @@
+/**
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * CS 5008
+ * Implementation of A* search with coordinate and landmark (ALT) heuristics
+ */
+
+#include "astar.h"
+#include <limits.h> // For INT_MAX
+#include <math.h>   // For sin, cos, asin, sqrt
+#include <stdlib.h> // For malloc, free
+
+#define EARTH_RADIUS_KM 6371.0   // Mean Earth radius
+#define DEGREES_TO_RADIANS (3.14159265358979323846 / 180.0)
+#define SCALE_SAFETY 0.999999    // Shave the scale so rounding never overestimates
+
+/**
+ * Great-circle (haversine) distance between two positions in km
+ */
+double great_circle_km(Coordinate a, Coordinate b) {
+    double lat1 = a.latitude * DEGREES_TO_RADIANS;
+    double lat2 = b.latitude * DEGREES_TO_RADIANS;
+    double dlat = lat2 - lat1;
+    double dlon = (b.longitude - a.longitude) * DEGREES_TO_RADIANS;
+
+    double h = sin(dlat / 2) * sin(dlat / 2) + cos(lat1) * cos(lat2) * sin(dlon / 2) * sin(dlon / 2);
+    if (h > 1.0) h = 1.0;  // Guard asin against rounding
+    return 2.0 * EARTH_RADIUS_KM * asin(sqrt(h));
+}
+
+/**
+ * Build the coordinate heuristic
+ * The scale is the smallest weight per km over all roads, so scale * great-circle
+ * never exceeds a road and, by the triangle inequality, never exceeds a path.
+ * Freezes the graph. Returns NULL if some city has no coordinates.
+ */
+Heuristic* heuristic_coordinates(Graph* graph) {
+    if (!graph_has_coordinates(graph)) return NULL;
+
+    // Read roads from the frozen layout, which is all a snapshot graph has
+    const CsrGraph* csr = graph_freeze(graph);
+    double scale = INFINITY;
+    for (int u = 0; u < csr->num_vertices; u++) {
+        for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++) {
+            double km = great_circle_km(graph->coords[u], graph->coords[csr->dest[e]]);
+            if (km > 0 && csr->weight[e] / km < scale) scale = csr->weight[e] / km;
+        }
+    }
+    if (scale == INFINITY) scale = 0;  // No roads: nothing to estimate
+
+    Heuristic* heuristic = (Heuristic*)malloc(sizeof(Heuristic));
+    heuristic->kind = HEURISTIC_COORDINATES;
+    heuristic->num_vertices = graph->num_vertices;
+    heuristic->coords = graph->coords;
+    heuristic->scale = scale * SCALE_SAFETY;
+    heuristic->num_landmarks = 0;
+    heuristic->landmarks = NULL;
+    heuristic->landmark_dist = NULL;
+    return heuristic;
+}
+
+/**
+ * Build the ALT heuristic with up to num_landmarks landmarks
+ * Landmarks are picked farthest-first: each new one maximises its distance
+ * to the landmarks already chosen, which spreads them around the graph edge.
+ */
+Heuristic* heuristic_landmarks(Graph* graph, int num_landmarks) {
+    int n = graph->num_vertices;
+    if (num_landmarks > n) num_landmarks = n;
+    if (num_landmarks < 1) num_landmarks = 1;
+
+    Heuristic* heuristic = (Heuristic*)malloc(sizeof(Heuristic));
+    heuristic->kind = HEURISTIC_LANDMARKS;
+    heuristic->num_vertices = n;
+    heuristic->coords = NULL;
+    heuristic->scale = 0;
+    heuristic->num_landmarks = num_landmarks;
+    heuristic->landmarks = (int*)malloc(sizeof(int) * num_landmarks);
+    heuristic->landmark_dist = (int*)malloc(sizeof(int) * (size_t)(n > 0 ? n : 1) * num_landmarks);
+
+    DijkstraWorkspace* ws = dijkstra_workspace_create(n);
+    int* nearest = (int*)malloc(sizeof(int) * (n > 0 ? n : 1));  // Distance to closest chosen landmark
+
+    // Seed: the vertex farthest from vertex 0
+    int next = 0;
+    if (n > 0) {
+        dijkstra_search_all(graph, ws, 0);
+        for (int v = 0; v < n; v++) {
+            int d = dijkstra_workspace_distance(ws, v);
+            if (d != INT_MAX && d > dijkstra_workspace_distance(ws, next)) next = v;
+            nearest[v] = INT_MAX;
+        }
+    }
+
+    for (int l = 0; l < num_landmarks; l++) {
+        heuristic->landmarks[l] = next;
+        dijkstra_search_all(graph, ws, next);
+
+        // Store this landmark's column and update the farthest-first score
+        int best = -1;
+        for (int v = 0; v < n; v++) {
+            int d = dijkstra_workspace_distance(ws, v);
+            heuristic->landmark_dist[(size_t)v * num_landmarks + l] = d;
+            if (d < nearest[v]) nearest[v] = d;
+            if (nearest[v] != INT_MAX && nearest[v] > 0 && (best == -1 || nearest[v] > nearest[best])) {
+                best = v;
+            }
+        }
+        next = best != -1 ? best : next;
+    }
+
+    free(nearest);
+    dijkstra_workspace_destroy(ws);
+    return heuristic;
+}
+
+/**
+ * Free a heuristic
+ */
+void heuristic_destroy(Heuristic* heuristic) {
+    if (!heuristic) return;
+    free(heuristic->landmarks);
+    free(heuristic->landmark_dist);
+    free(heuristic);
+}
+
+/**
+ * Lower landmark l's stored distances after the road a -> b got weight w
+ * Only vertices whose distance improves are visited, in Dijkstra order from b.
+ */
+static void lower_landmark(Heuristic* heuristic, Graph* graph, PriorityQueue* pq, int l, int a, int b, int w) {
+    int k = heuristic->num_landmarks;
+    int* dist = heuristic->landmark_dist;
+    int through = dist[(size_t)a * k + l];
+    if (through == INT_MAX || through + w >= dist[(size_t)b * k + l]) return;  // b does not improve
+    pq_push(pq, b, through + w);
+
+    const CsrGraph* csr = graph->csr;
+    while (!pq_is_empty(pq)) {
+        int du;
+        int u = pq_pop(pq, &du);
+        dist[(size_t)u * k + l] = du;
+        if (csr) {
+            for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++) {
+                int v = csr->dest[e];
+                if (du + csr->weight[e] < dist[(size_t)v * k + l]) pq_push(pq, v, du + csr->weight[e]);
+            }
+        } else {
+            for (EdgeNode* edge = graph->vertices[u].edges; edge; edge = edge->next) {
+                if (du + edge->weight < dist[(size_t)edge->dest * k + l]) pq_push(pq, edge->dest, du + edge->weight);
+            }
+        }
+    }
+}
+
+/**
+ * Keep the heuristic admissible after one road change (call right after the change)
+ * A longer or closed road leaves every bound valid, just looser. For a shorter
+ * or new road, the coordinate scale drops if this road is cheaper per km than
+ * any before, and landmark distances that the road shortens are lowered.
+ */
+void heuristic_repair(Heuristic* heuristic, Graph* graph, const RoadChange* change) {
+    if (graph_change_lengthens(change)) return;
+    int a = change->from;
+    int b = change->to;
+    int w = change->new_weight;
+
+    if (heuristic->kind == HEURISTIC_COORDINATES) {
+        double km = great_circle_km(heuristic->coords[a], heuristic->coords[b]);
+        if (km > 0 && w / km * SCALE_SAFETY < heuristic->scale) heuristic->scale = w / km * SCALE_SAFETY;
+        return;
+    }
+
+    PriorityQueue* pq = pq_create(heuristic->num_vertices);
+    for (int l = 0; l < heuristic->num_landmarks; l++) {
+        lower_landmark(heuristic, graph, pq, l, a, b, w);
+        lower_landmark(heuristic, graph, pq, l, b, a, w);
+    }
+    pq_destroy(pq);
+}
+
+/**
+ * Lower bound on the distance from v to target
+ */
+int heuristic_estimate(const Heuristic* heuristic, int v, int target) {
+    if (heuristic->kind == HEURISTIC_COORDINATES) {
+        return (int)(heuristic->scale * great_circle_km(heuristic->coords[v], heuristic->coords[target]));
+    }
+
+    // ALT: |d(l, target) - d(l, v)| <= d(v, target) for every landmark l
+    int k = heuristic->num_landmarks;
+    const int* from_v = &heuristic->landmark_dist[(size_t)v * k];
+    const int* from_t = &heuristic->landmark_dist[(size_t)target * k];
+    int best = 0;
+    for (int l = 0; l < k; l++) {
+        if (from_v[l] == INT_MAX || from_t[l] == INT_MAX) continue;  // Landmark in another component
+        int bound = from_t[l] > from_v[l] ? from_t[l] - from_v[l] : from_v[l] - from_t[l];
+        if (bound > best) best = bound;
+    }
+    return best;
+}
+
+/**
+ * Improve the tentative distance of v and queue it by distance + estimate
+ */
+static inline void relax_astar(DijkstraWorkspace* ws, const Heuristic* heuristic,
+                               int u, int v, int new_dist, int end) {
+    unsigned int gen = ws->generation;
+    PROFILE_COUNT(ws->counters.relaxed, 1);
+    if (ws->settled[v] == gen) return;  // Already final
+
+    if (ws->reached[v] != gen || new_dist < ws->dist[v]) {
+        PROFILE_COUNT(ws->counters.heap_pushes, 1);
+        ws->reached[v] = gen;
+        ws->dist[v] = new_dist;
+        ws->parent[v] = u;
+        pq_push(ws->pq, v, new_dist + heuristic_estimate(heuristic, v, end));
+    }
+}
+
+/**
+ * A* reusing a caller-owned workspace
+ * Vertices are queued by distance + estimate; both heuristics are consistent,
+ * so a vertex is final when it is popped, exactly as in Dijkstra.
+ */
+PathResult astar_shortest_path_ws(Graph* graph, const Heuristic* heuristic, DijkstraWorkspace* ws,
+                                  int start, int end) {
+    if (!graph_same_component(graph, start, end)) return path_result_unreachable();
+    const CsrGraph* csr = graph->csr;
+    dijkstra_workspace_reset(ws, graph->num_vertices);
+    PROFILE_COUNT(ws->counters.searches, 1);
+
+    ws->reached[start] = ws->generation;
+    ws->dist[start] = 0;
+    ws->parent[start] = -1;
+    pq_push(ws->pq, start, heuristic_estimate(heuristic, start, end));
+
+    while (!pq_is_empty(ws->pq)) {
+        int u = pq_pop(ws->pq, NULL);
+        ws->settled[u] = ws->generation;
+        ws->settled_count++;
+        PROFILE_COUNT(ws->counters.settled, 1);
+        if (u == end) break;  // Early exit
+
+        int du = ws->dist[u];
+        if (csr) {
+            for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++) {
+                relax_astar(ws, heuristic, u, csr->dest[e], du + csr->weight[e], end);
+            }
+        } else {
+            for (EdgeNode* edge = graph->vertices[u].edges; edge; edge = edge->next) {
+                relax_astar(ws, heuristic, u, edge->dest, du + edge->weight, end);
+            }
+        }
+    }
+
+    return dijkstra_workspace_result(ws, end);
+}
+
+/**
+ * A* with a one-off workspace
+ */
+PathResult astar_shortest_path(Graph* graph, const Heuristic* heuristic, int start, int end) {
+    DijkstraWorkspace* ws = dijkstra_workspace_create(graph->num_vertices);
+    PathResult result = astar_shortest_path_ws(graph, heuristic, ws, start, end);
+    dijkstra_workspace_destroy(ws);
+    return result;
+}
@@ -0,0 +1,51 @@
+/**
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * CS 5008
+ * A* search with admissible lower-bound heuristics
+ *
+ * Two heuristics are available:
+ *   coordinates - great-circle distance to the target, scaled so it never
+ *                 exceeds any road (needs a position for every city)
+ *   landmarks   - ALT: precomputed distances from a few landmarks and the
+ *                 triangle inequality (works on any graph)
+ */
+
+#ifndef ASTAR_H
+#define ASTAR_H
+
+#include "graph.h"
+#include "dijkstra.h"
+
+#define DEFAULT_LANDMARKS 8  // Landmarks used when the caller has no preference
+
+typedef enum HeuristicKind {
+    HEURISTIC_COORDINATES,  // Scaled great-circle distance
+    HEURISTIC_LANDMARKS     // ALT triangle inequality bounds
+} HeuristicKind;
+
+// Precomputed data for estimating the remaining distance to a target
+typedef struct Heuristic {
+    HeuristicKind kind;
+    int num_vertices;         // Size of the graph the heuristic was built for
+    const Coordinate* coords; // Graph coordinates (coordinates kind)
+    double scale;             // Weight units per km of great-circle distance (coordinates kind)
+    int num_landmarks;        // Number of landmarks (landmarks kind)
+    int* landmarks;           // Landmark vertex indices
+    int* landmark_dist;       // dist[v * num_landmarks + l] = distance between landmark l and v
+} Heuristic;
+
+// Heuristic construction
+Heuristic* heuristic_coordinates(Graph* graph);
+Heuristic* heuristic_landmarks(Graph* graph, int num_landmarks);
+void heuristic_destroy(Heuristic* heuristic);
+int heuristic_estimate(const Heuristic* heuristic, int v, int target);
+void heuristic_repair(Heuristic* heuristic, Graph* graph, const RoadChange* change);
+double great_circle_km(Coordinate a, Coordinate b);
+
+// A* shortest path; returns the same PathResult as dijkstra_shortest_path
+PathResult astar_shortest_path(Graph* graph, const Heuristic* heuristic, int start, int end);
+PathResult astar_shortest_path_ws(Graph* graph, const Heuristic* heuristic, DijkstraWorkspace* ws,
+                                  int start, int end);
+
+#endif
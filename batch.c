@@ -0,0 +1,199 @@
+/**
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * CS 5008
+ * Implementation of route queries and the multi-threaded batch mode
+ */
+
+#define _POSIX_C_SOURCE 200809L  // For clock_gettime
+
+#include "batch.h"
+#include "parallel.h"
+#include <stdlib.h> // For malloc, free
+#include <string.h> // For strtok_r, memset
+#include <time.h>   // For clock_gettime
+
+#define MAX_LINE 256      // Maximum length of a query line
+#define BATCH_WINDOW 4096 // Queries read, solved and written per round
+
+// One query line and, once solved, its answer
+typedef struct BatchQuery {
+    int start;         // -1 if the line was invalid
+    int end;
+    PathResult result;
+} BatchQuery;
+
+// Shared state for the workers of one window
+typedef struct BatchJob {
+    const RouteEngine* engine;
+    BatchQuery* queries;
+    DijkstraWorkspace** forward;  // One workspace pair per worker
+    DijkstraWorkspace** backward;
+    LatencyHistogram* latency;    // One histogram per worker, merged at the end
+} BatchJob;
+
+/**
+ * Shortest route: hierarchy if built, then A* if a heuristic exists, else Dijkstra
+ * A pair in different components is answered from the component labels alone.
+ */
+PathResult route_find(const RouteEngine* engine, DijkstraWorkspace* forward,
+                      DijkstraWorkspace* backward, int start, int end) {
+    if (!graph_same_component(engine->graph, start, end)) {
+        return path_result_unreachable();  // Different components: no engine needs to search
+    }
+    if (engine->apsp) {
+        return apsp_path(engine->apsp, start, end);
+    }
+    if (engine->ch) {
+        return ch_shortest_path_ws(engine->ch, forward, backward, start, end);
+    }
+    if (engine->heuristic) {
+        return astar_shortest_path_ws(engine->graph, engine->heuristic, forward, start, end);
+    }
+    if (engine->compact) {
+        return compact_shortest_path(engine->compact, forward, start, end);
+    }
+    if (engine->buckets) {
+        return dijkstra_shortest_path_dial(engine->graph, forward, start, end);
+    }
+    return dijkstra_shortest_path_ws(engine->graph, forward, start, end);
+}
+
+/**
+ * Write a result in the interactive prompt's format
+ */
+void route_print(FILE* out, const Graph* graph, const PathResult* result) {
+    if (!result->found) {
+        fputs("Path Not Found...\n", out);
+        return;
+    }
+
+    fputs("Path Found...\n\t", out);
+    for (int i = 0; i < result->path_length; i++) {
+        fputs(graph->vertices[result->path[i]].name, out);
+        if (i < result->path_length - 1) fputc(' ', out);  // Space between cities
+    }
+    fprintf(out, "\n\tTotal Distance: %d\n", result->total_distance);
+}
+
+/**
+ * Worker task: solve one query with this worker's workspaces
+ */
+static void solve_query(void* context, int worker, int index) {
+    BatchJob* job = (BatchJob*)context;
+    BatchQuery* query = &job->queries[index];
+    if (query->start == -1) return;
+    PROFILE_START(begin);
+    query->result = route_find(job->engine, job->forward[worker], job->backward[worker],
+                               query->start, query->end);
+    PROFILE_RECORD(&job->latency[worker], begin, query->result.settled);
+}
+
+/**
+ * Parse a query line; returns false unless it names two known cities
+ * Blank lines are reported through *blank so they can be skipped silently
+ */
+static bool parse_query(Graph* graph, char* line, BatchQuery* query, bool* blank) {
+    char* save = NULL;
+    char* token1 = strtok_r(line, " \t\n\r", &save);
+    char* token2 = token1 ? strtok_r(NULL, " \t\n\r", &save) : NULL;
+    *blank = token1 == NULL;
+    query->start = -1;
+    query->end = -1;
+    if (!token1 || !token2) return false;
+
+    int start = graph_find_vertex(graph, token1);
+    int end = graph_find_vertex(graph, token2);
+    if (start == -1 || end == -1) return false;
+    query->start = start;
+    query->end = end;
+    return true;
+}
+
+/**
+ * Answer every query in `in` and write the results to `out` in input order
+ * Lines are processed in windows of BATCH_WINDOW so memory stays bounded;
+ * within a window the queries run on num_threads threads, started once for
+ * the whole run.
+ */
+bool batch_run(const RouteEngine* engine, FILE* in, FILE* out, int num_threads, BatchStats* stats) {
+    struct timespec begin, finish;
+    clock_gettime(CLOCK_MONOTONIC, &begin);
+    if (num_threads < 1) num_threads = 1;
+
+    BatchJob job;
+    job.engine = engine;
+    job.queries = (BatchQuery*)malloc(sizeof(BatchQuery) * BATCH_WINDOW);
+    job.forward = (DijkstraWorkspace**)malloc(sizeof(DijkstraWorkspace*) * num_threads);
+    job.backward = (DijkstraWorkspace**)malloc(sizeof(DijkstraWorkspace*) * num_threads);
+    job.latency = (LatencyHistogram*)calloc(num_threads, sizeof(LatencyHistogram));
+    if (!job.queries || !job.forward || !job.backward || !job.latency) {
+        fprintf(stderr, "Error: Out of memory for batch queries\n");
+        free(job.queries);
+        free(job.forward);
+        free(job.backward);
+        free(job.latency);
+        return false;
+    }
+    for (int t = 0; t < num_threads; t++) {
+        job.forward[t] = dijkstra_workspace_create(engine->graph->num_vertices);
+        job.backward[t] = dijkstra_workspace_create(engine->graph->num_vertices);
+    }
+
+    ParallelPool* pool = parallel_pool_create(num_threads);
+
+    BatchStats totals;
+    memset(&totals, 0, sizeof(BatchStats));
+    char line[MAX_LINE];
+    bool more = true;
+    while (more) {
+        // Read one window of queries
+        int count = 0;
+        while (count < BATCH_WINDOW) {
+            if (!fgets(line, sizeof(line), in)) {
+                more = false;
+                break;
+            }
+            bool blank;
+            BatchQuery* query = &job.queries[count];
+            if (parse_query(engine->graph, line, query, &blank)) totals.queries++;
+            else if (blank) continue;
+            else totals.invalid++;
+            query->result.path = NULL;
+            query->result.found = false;
+            count++;
+        }
+
+        parallel_pool_run(pool, count, solve_query, &job);
+
+        // Write in input order
+        for (int i = 0; i < count; i++) {
+            BatchQuery* query = &job.queries[i];
+            if (query->start == -1) {
+                fputs("Invalid Command\n", out);
+                continue;
+            }
+            route_print(out, engine->graph, &query->result);
+            path_result_destroy(&query->result);
+        }
+    }
+    fflush(out);
+    parallel_pool_destroy(pool);
+
+    for (int t = 0; t < num_threads; t++) {
+        latency_merge(&totals.latency, &job.latency[t]);
+        search_counters_add(&totals.search, &job.forward[t]->counters);
+        search_counters_add(&totals.search, &job.backward[t]->counters);
+        dijkstra_workspace_destroy(job.forward[t]);
+        dijkstra_workspace_destroy(job.backward[t]);
+    }
+    free(job.queries);
+    free(job.forward);
+    free(job.backward);
+    free(job.latency);
+
+    clock_gettime(CLOCK_MONOTONIC, &finish);
+    totals.seconds = (finish.tv_sec - begin.tv_sec) + (finish.tv_nsec - begin.tv_nsec) / 1e9;
+    if (stats) *stats = totals;
+    return true;
+}
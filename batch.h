@@ -0,0 +1,52 @@
+/**
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * CS 5008
+ * Route queries shared by the interactive prompt and the batch mode
+ *
+ * A batch file holds one "<city1> <city2>" pair per line. Queries are solved
+ * by a pool of threads that share the read-only graph (each thread has its
+ * own workspaces) and the answers are written in input order.
+ */
+
+#ifndef BATCH_H
+#define BATCH_H
+
+#include "graph.h"
+#include "dijkstra.h"
+#include "astar.h"
+#include "ch.h"
+#include "apsp.h"
+#include "compact.h"
+#include <stdio.h>
+
+// Read-only search configuration; safe to share between threads
+typedef struct RouteEngine {
+    Graph* graph;                  // Cities and roads (not modified by queries)
+    const Heuristic* heuristic;    // A* lower bounds, NULL for plain Dijkstra
+    const ContractionHierarchy* ch; // Preprocessed hierarchy, NULL if not built
+    bool buckets;                  // Plain Dijkstra runs on the bucket queue (integer weights)
+    const AllPairsTable* apsp;     // Every distance precomputed, NULL if not built (checked first)
+    const CompactGraph* compact;   // Packed adjacency plain Dijkstra decodes instead of the CSR, NULL if not built
+} RouteEngine;
+
+// Totals for one batch run
+typedef struct BatchStats {
+    int queries;    // Lines that named two known cities
+    int invalid;    // Lines that did not
+    double seconds; // Wall time including output
+    LatencyHistogram latency; // Per-query search time (empty unless built with PROFILE=on)
+    SearchCounters search;    // Work done by every worker's searches
+} BatchStats;
+
+// Shortest route with the engine's best available method
+PathResult route_find(const RouteEngine* engine, DijkstraWorkspace* forward,
+                      DijkstraWorkspace* backward, int start, int end);
+
+// Write a result in the same format as the interactive prompt
+void route_print(FILE* out, const Graph* graph, const PathResult* result);
+
+// Answer every query in `in`, writing results to `out` in input order
+bool batch_run(const RouteEngine* engine, FILE* in, FILE* out, int num_threads, BatchStats* stats);
+
+#endif
@@ -0,0 +1,1859 @@
+/**
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * CS 5008
+ * Benchmarks on generated sparse graphs
+ *   heap - linear-scan vs heap based Dijkstra
+ *   load - load_vertices/load_distances time, memory and teardown as the city count grows
+ *   csr  - adjacency list vs frozen CSR layout for heap Dijkstra
+ *   workspace - one-off allocation vs a reused DijkstraWorkspace on short queries
+ *   bidir - unidirectional vs bidirectional Dijkstra (time and settled vertices)
+ *   astar - Dijkstra vs A* with coordinate and landmark heuristics on road-like grids
+ *   ch    - contraction hierarchy preprocessing, shortcuts and query latency
+ *   batch - batch mode throughput as the worker thread count grows
+ *   table - N x M point-to-point queries vs one-to-many distance tables
+ *   snapshot - text loading + freeze vs mapping a compiled snapshot
+ *   parse - distances file throughput: raw reads vs fgets/sscanf vs the streaming loader
+ *           (sizes are road counts)
+ *   pload - load_distances vs load_distances_parallel on 1, 2, 4 and 8 threads
+ *   cache - skewed query traffic with and without the LRU route cache
+ *   tree  - many destinations from one origin: fresh searches vs a kept shortest path tree
+ *   update - road changes: repairing landmarks in place vs rebuilding them
+ *   reorder - Dijkstra on shuffled cities vs BFS (Cuthill-McKee) and Hilbert curve orders
+ *   dial  - binary/pairing heap vs bucket queue (Dial) Dijkstra latency on large sparse graphs
+ *   delta - full-graph Dijkstra vs parallel delta-stepping on 1, 2, 4, 8 threads
+ *   apsp  - all-pairs table build (blocked Floyd-Warshall vs repeated Dijkstra) on sparse
+ *           and dense graphs, and table lookups vs Dijkstra searches
+ *   compact - bytes per edge of adjacency lists, CSR and the varint packed adjacency, the
+ *           whole graph's bytes per edge before and after the packed copy replaces the
+ *           lists and CSR, and Dijkstra latency on the CSR vs decoding the packed adjacency
+ *   suite - grid, random geometric, scale-free and road-like graphs from 1k vertices up
+ *           (pass 10000000 for the largest): load time, memory and the query latency
+ *           distribution of every engine, optionally appended to a CSV file
+ * Every mode draws from --seed (default 5008), so a run can be repeated exactly.
+ */
+
+#define _POSIX_C_SOURCE 200809L // For clock_gettime
+
+// Project Headers
+#include "graph.h"
+#include "dijkstra.h"
+#include "heap.h"
+#include "loader.h"
+#include "astar.h"
+#include "ch.h"
+#include "batch.h"
+#include "parallel.h"
+#include "snapshot.h"
+#include "cache.h"
+#include "reorder.h"
+#include "delta.h"
+#include "apsp.h"
+#include "compact.h"
+
+// Standard Libraries
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <math.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define DEFAULT_QUERIES 20      // Queries per graph size
+#define AVERAGE_DEGREE 6        // Directed edges per vertex in generated graphs
+#define MAX_WEIGHT 1000         // Largest generated edge weight
+#define BENCH_SEED 5008         // Fixed seed so runs are reproducible
+
+static uint64_t rng_state = BENCH_SEED;
+
+/**
+ * xorshift64 pseudo random number generator
+ */
+static uint64_t next_random(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+/**
+ * Random integer in [0, bound)
+ */
+static int random_below(int bound) {
+    return (int)(next_random() % (uint64_t)bound);
+}
+
+/**
+ * Current time in seconds
+ */
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * Build a connected sparse graph: a random spanning tree plus random extra roads
+ */
+static Graph* generate_sparse_graph(int num_vertices) {
+    Graph* graph = graph_create(num_vertices);
+    char name[32];
+
+    for (int i = 0; i < num_vertices; i++) {
+        snprintf(name, sizeof(name), "c%d", i);
+        graph_add_vertex(graph, name);
+    }
+
+    // Spanning tree keeps every pair reachable
+    for (int i = 1; i < num_vertices; i++) {
+        graph_add_edge_index(graph, i, random_below(i), 1 + random_below(MAX_WEIGHT));
+    }
+
+    // Extra edges up to the target average degree
+    long extra = (long)num_vertices * AVERAGE_DEGREE / 2 - (num_vertices - 1);
+    for (long e = 0; e < extra; e++) {
+        int a = random_below(num_vertices);
+        int b = random_below(num_vertices);
+        if (a != b) graph_add_edge_index(graph, a, b, 1 + random_below(MAX_WEIGHT));
+    }
+
+    return graph;
+}
+
+/**
+ * Build a connected dense graph: a random spanning tree plus random roads
+ * up to an average degree of an eighth of the city count
+ */
+static Graph* generate_dense_graph(int num_vertices) {
+    Graph* graph = graph_create(num_vertices);
+    char name[32];
+
+    for (int i = 0; i < num_vertices; i++) {
+        snprintf(name, sizeof(name), "d%d", i);
+        graph_add_vertex(graph, name);
+    }
+    for (int i = 1; i < num_vertices; i++) {
+        graph_add_edge_index(graph, i, random_below(i), 1 + random_below(MAX_WEIGHT));
+    }
+
+    long extra = (long)num_vertices * (num_vertices / 8) / 2 - (num_vertices - 1);
+    for (long e = 0; e < extra; e++) {
+        int a = random_below(num_vertices);
+        int b = random_below(num_vertices);
+        if (a != b) graph_add_edge_index(graph, a, b, 1 + random_below(MAX_WEIGHT));
+    }
+
+    return graph;
+}
+
+/**
+ * Build a road-like graph: a jittered grid of cities with coordinates,
+ * joined to their grid neighbours by roads 0-30% longer than the straight line
+ */
+static Graph* generate_road_graph(int num_vertices) {
+    int side = (int)sqrt((double)num_vertices);
+    if (side < 2) side = 2;
+    Graph* graph = graph_create(side * side);
+    char name[32];
+
+    for (int i = 0; i < side * side; i++) {
+        snprintf(name, sizeof(name), "r%d", i);
+        graph_add_vertex(graph, name);
+        double jitter_lat = random_below(1000) / 1e5;
+        double jitter_lon = random_below(1000) / 1e5;
+        graph_set_coordinates(graph, i, 30.0 + (i / side) * 0.02 + jitter_lat, -120.0 + (i % side) * 0.02 + jitter_lon);
+    }
+
+    for (int i = 0; i < side * side; i++) {
+        int right = i % side + 1 < side ? i + 1 : -1;
+        int down = i + side < side * side ? i + side : -1;
+        int neighbours[2] = {right, down};
+        for (int k = 0; k < 2; k++) {
+            if (neighbours[k] == -1) continue;
+            double km = great_circle_km(graph->coords[i], graph->coords[neighbours[k]]);
+            int weight = (int)(km * 10 * (1.0 + random_below(30) / 100.0)) + 1;  // Units of 100 m
+            graph_add_edge_index(graph, i, neighbours[k], weight);
+        }
+    }
+
+    return graph;
+}
+
+/**
+ * Build a plain grid: every city joined to its right and lower neighbour,
+ * with random weights and no coordinates
+ */
+static Graph* generate_grid_graph(int num_vertices) {
+    int side = (int)sqrt((double)num_vertices);
+    if (side < 2) side = 2;
+    Graph* graph = graph_create(side * side);
+    char name[32];
+
+    for (int i = 0; i < side * side; i++) {
+        snprintf(name, sizeof(name), "g%d", i);
+        graph_add_vertex(graph, name);
+    }
+    for (int i = 0; i < side * side; i++) {
+        if (i % side + 1 < side) graph_append_edge_index(graph, i, i + 1, 1 + random_below(MAX_WEIGHT));
+        if (i + side < side * side) graph_append_edge_index(graph, i, i + side, 1 + random_below(MAX_WEIGHT));
+    }
+
+    return graph;
+}
+
+/**
+ * Build a random geometric graph: cities scattered uniformly over a square,
+ * joined when closer than the radius that gives AVERAGE_DEGREE neighbours on
+ * average. A cell grid of that radius keeps the neighbour search linear.
+ * Small graphs may fall apart into components; unreachable queries still count.
+ */
+static Graph* generate_geometric_graph(int num_vertices) {
+    int n = num_vertices < 2 ? 2 : num_vertices;
+    double radius = sqrt(AVERAGE_DEGREE / (3.14159265358979323846 * n));  // In unit-square units
+    int cells = (int)(1.0 / radius);
+    if (cells < 1) cells = 1;
+    double span = sqrt((double)n) * 0.02;  // Degrees, same density as the road grid
+    Graph* graph = graph_create(n);
+    char name[32];
+
+    double* x = (double*)malloc(sizeof(double) * n);
+    double* y = (double*)malloc(sizeof(double) * n);
+    int* head = (int*)malloc(sizeof(int) * (size_t)cells * cells);  // First city in each cell
+    int* next = (int*)malloc(sizeof(int) * n);                      // Next city in the same cell
+    for (int c = 0; c < cells * cells; c++) head[c] = -1;
+
+    for (int i = 0; i < n; i++) {
+        snprintf(name, sizeof(name), "p%d", i);
+        graph_add_vertex(graph, name);
+        x[i] = (double)(next_random() >> 11) / 9007199254740992.0;  // 53 random bits in [0, 1)
+        y[i] = (double)(next_random() >> 11) / 9007199254740992.0;
+        graph_set_coordinates(graph, i, 30.0 + y[i] * span, -120.0 + x[i] * span);
+
+        int cell = (int)(y[i] * cells) * cells + (int)(x[i] * cells);
+        next[i] = head[cell];
+        head[cell] = i;
+    }
+
+    // Each pair is found from its higher-numbered end only
+    for (int i = 0; i < n; i++) {
+        int cx = (int)(x[i] * cells);
+        int cy = (int)(y[i] * cells);
+        for (int dy = -1; dy <= 1; dy++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                if (cx + dx < 0 || cx + dx >= cells || cy + dy < 0 || cy + dy >= cells) continue;
+                for (int j = head[(cy + dy) * cells + cx + dx]; j != -1; j = next[j]) {
+                    if (j >= i) continue;
+                    double ddx = x[i] - x[j], ddy = y[i] - y[j];
+                    if (ddx * ddx + ddy * ddy > radius * radius) continue;
+                    double km = great_circle_km(graph->coords[i], graph->coords[j]);
+                    int weight = (int)(km * 10 * (1.0 + random_below(30) / 100.0)) + 1;  // Units of 100 m
+                    graph_append_edge_index(graph, i, j, weight);
+                }
+            }
+        }
+    }
+
+    free(x);
+    free(y);
+    free(head);
+    free(next);
+    return graph;
+}
+
+/**
+ * Build a scale-free graph by preferential attachment (Barabasi-Albert):
+ * each new city links to AVERAGE_DEGREE / 2 distinct earlier cities, picked
+ * with probability proportional to their degree, so a few hubs get very busy
+ */
+static Graph* generate_scale_free_graph(int num_vertices) {
+    const int links = AVERAGE_DEGREE / 2;
+    int n = num_vertices < links + 1 ? links + 1 : num_vertices;
+    Graph* graph = graph_create(n);
+    char name[32];
+
+    // Every road end goes into this list, so a uniform pick from it is degree-biased
+    int* ends = (int*)malloc(sizeof(int) * 2 * ((size_t)n * links + 1));
+    long num_ends = 0;
+
+    for (int i = 0; i < n; i++) {
+        snprintf(name, sizeof(name), "s%d", i);
+        graph_add_vertex(graph, name);
+    }
+
+    // Start from a small clique
+    for (int i = 0; i <= links; i++) {
+        for (int j = 0; j < i; j++) {
+            graph_append_edge_index(graph, i, j, 1 + random_below(MAX_WEIGHT));
+            ends[num_ends++] = i;
+            ends[num_ends++] = j;
+        }
+    }
+
+    for (int i = links + 1; i < n; i++) {
+        int chosen[AVERAGE_DEGREE / 2];
+        for (int k = 0; k < links; k++) {
+            bool repeat;
+            do {
+                chosen[k] = ends[next_random() % (uint64_t)num_ends];
+                repeat = false;
+                for (int p = 0; p < k; p++) repeat = repeat || chosen[p] == chosen[k];
+            } while (repeat);
+        }
+        for (int k = 0; k < links; k++) {
+            graph_append_edge_index(graph, i, chosen[k], 1 + random_below(MAX_WEIGHT));
+            ends[num_ends++] = i;
+            ends[num_ends++] = chosen[k];
+        }
+    }
+
+    free(ends);
+    return graph;
+}
+
+/**
+ * Time one engine over the query list, returning the sum of distances as a checksum
+ */
+static long run_queries(PathResult (*engine)(Graph*, int, int), Graph* graph,
+                        const int* starts, const int* ends, int queries, double* seconds) {
+    long checksum = 0;
+    double begin = now_seconds();
+
+    for (int q = 0; q < queries; q++) {
+        PathResult result = engine(graph, starts[q], ends[q]);
+        if (result.found) checksum += result.total_distance;
+        path_result_destroy(&result);
+    }
+
+    *seconds = now_seconds() - begin;
+    return checksum;
+}
+
+/**
+ * Compare the scan and heap engines at each graph size
+ */
+static void bench_heap(const int* sizes, int num_sizes) {
+    printf("Priority queue: %s heap, %d queries per size\n", pq_name(), DEFAULT_QUERIES);
+    printf("%10s %10s %14s %14s %10s\n", "vertices", "edges", "scan ms/query", "heap ms/query", "speedup");
+
+    for (int s = 0; s < num_sizes; s++) {
+        int n = sizes[s];
+        if (n < 2) continue;
+
+        Graph* graph = generate_sparse_graph(n);
+        int starts[DEFAULT_QUERIES], ends[DEFAULT_QUERIES];
+        for (int q = 0; q < DEFAULT_QUERIES; q++) {
+            starts[q] = random_below(n);
+            ends[q] = random_below(n);
+        }
+
+        double scan_time, heap_time;
+        long scan_sum = run_queries(dijkstra_shortest_path_scan, graph, starts, ends, DEFAULT_QUERIES, &scan_time);
+        long heap_sum = run_queries(dijkstra_shortest_path, graph, starts, ends, DEFAULT_QUERIES, &heap_time);
+
+        printf("%10d %10d %14.3f %14.3f %9.1fx%s\n", n, n * AVERAGE_DEGREE,
+               scan_time * 1000 / DEFAULT_QUERIES, heap_time * 1000 / DEFAULT_QUERIES,
+               heap_time > 0 ? scan_time / heap_time : 0.0,
+               scan_sum == heap_sum ? "" : "  MISMATCH");
+
+        graph_destroy(graph);
+    }
+}
+
+/**
+ * Write a generated graph as vertices and distances text files
+ */
+static void write_graph_files(Graph* graph, const char* vertices_file, const char* distances_file) {
+    FILE* vertices = fopen(vertices_file, "w");
+    FILE* distances = fopen(distances_file, "w");
+
+    for (int u = 0; u < graph->num_vertices; u++) {
+        fprintf(vertices, "%s\n", graph->vertices[u].name);
+        for (EdgeNode* edge = graph->vertices[u].edges; edge; edge = edge->next) {
+            // Each road is stored in both directions, write it once
+            if (u < edge->dest) {
+                fprintf(distances, "%s %s %d\n", graph->vertices[u].name,
+                        graph->vertices[edge->dest].name, edge->weight);
+            }
+        }
+    }
+
+    fclose(vertices);
+    fclose(distances);
+}
+
+/**
+ * Time loading text files of each size; flat us/city means linear scaling
+ */
+static void bench_load(const int* sizes, int num_sizes) {
+    char vertices_file[64], distances_file[64];
+    snprintf(vertices_file, sizeof(vertices_file), "/tmp/bench_vertices_%d.txt", (int)getpid());
+    snprintf(distances_file, sizeof(distances_file), "/tmp/bench_distances_%d.txt", (int)getpid());
+
+    printf("%10s %10s %12s %12s %10s %10s %8s %10s\n", "cities", "roads", "vertices ms", "distances ms",
+           "us/city", "memory MB", "blocks", "destroy ms");
+
+    for (int s = 0; s < num_sizes; s++) {
+        int n = sizes[s];
+        if (n < 2) continue;
+
+        Graph* generated = generate_sparse_graph(n);
+        write_graph_files(generated, vertices_file, distances_file);
+        graph_destroy(generated);
+
+        Graph* graph = graph_create(50);  // Same starting capacity as map.out
+        double begin = now_seconds();
+        load_vertices(graph, vertices_file);
+        double middle = now_seconds();
+        load_distances(graph, distances_file);
+        double end = now_seconds();
+
+        GraphMemoryStats stats;
+        graph_memory_stats(graph, &stats);
+
+        double destroy_begin = now_seconds();
+        graph_destroy(graph);
+        double destroy_time = now_seconds() - destroy_begin;
+
+        printf("%10d %10d %12.1f %12.1f %10.3f %10.1f %8d %10.2f\n", n, n * AVERAGE_DEGREE / 2,
+               (middle - begin) * 1000, (end - middle) * 1000, (end - begin) * 1e6 / n,
+               stats.total_bytes / 1e6, stats.arena_blocks, destroy_time * 1000);
+    }
+
+    remove(vertices_file);
+    remove(distances_file);
+}
+
+/**
+ * Compare searching the linked adjacency lists with the frozen CSR arrays
+ */
+static void bench_csr(const int* sizes, int num_sizes) {
+    printf("%10s %10s %14s %14s %10s %10s\n", "vertices", "edges", "list ms/query", "csr ms/query",
+           "speedup", "freeze ms");
+
+    for (int s = 0; s < num_sizes; s++) {
+        int n = sizes[s];
+        if (n < 2) continue;
+
+        Graph* graph = generate_sparse_graph(n);
+        int starts[DEFAULT_QUERIES], ends[DEFAULT_QUERIES];
+        for (int q = 0; q < DEFAULT_QUERIES; q++) {
+            starts[q] = random_below(n);
+            ends[q] = random_below(n);
+        }
+
+        double list_time, csr_time;
+        long list_sum = run_queries(dijkstra_shortest_path, graph, starts, ends, DEFAULT_QUERIES, &list_time);
+
+        double begin = now_seconds();
+        graph_freeze(graph);
+        double freeze_time = now_seconds() - begin;
+        long csr_sum = run_queries(dijkstra_shortest_path, graph, starts, ends, DEFAULT_QUERIES, &csr_time);
+
+        printf("%10d %10d %14.3f %14.3f %9.1fx %10.1f%s\n", n, graph->csr->num_edges,
+               list_time * 1000 / DEFAULT_QUERIES, csr_time * 1000 / DEFAULT_QUERIES,
+               csr_time > 0 ? list_time / csr_time : 0.0, freeze_time * 1000,
+               list_sum == csr_sum ? "" : "  MISMATCH");
+
+        graph_destroy(graph);
+    }
+}
+
+/**
+ * Compare per-query allocation with a reused workspace on nearest-neighbour
+ * queries, where the search itself is tiny and setup cost dominates
+ */
+static void bench_workspace(const int* sizes, int num_sizes) {
+    const int queries = 1000;
+    printf("%10s %16s %16s %10s\n", "vertices", "one-off us/query", "reused us/query", "speedup");
+
+    for (int s = 0; s < num_sizes; s++) {
+        int n = sizes[s];
+        if (n < 2) continue;
+
+        Graph* graph = generate_sparse_graph(n);
+        const CsrGraph* csr = graph_freeze(graph);
+
+        // Target is the nearest neighbour of each start
+        int* starts = (int*)malloc(sizeof(int) * queries);
+        int* ends = (int*)malloc(sizeof(int) * queries);
+        for (int q = 0; q < queries; q++) {
+            int u = random_below(n);
+            int best = csr->offsets[u];
+            for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++) {
+                if (csr->weight[e] < csr->weight[best]) best = e;
+            }
+            starts[q] = u;
+            ends[q] = csr->dest[best];
+        }
+
+        double one_off_time, reused_time;
+        long one_off_sum = run_queries(dijkstra_shortest_path, graph, starts, ends, queries, &one_off_time);
+
+        DijkstraWorkspace* ws = dijkstra_workspace_create(n);
+        long reused_sum = 0;
+        double begin = now_seconds();
+        for (int q = 0; q < queries; q++) {
+            PathResult result = dijkstra_shortest_path_ws(graph, ws, starts[q], ends[q]);
+            if (result.found) reused_sum += result.total_distance;
+            path_result_destroy(&result);
+        }
+        reused_time = now_seconds() - begin;
+        dijkstra_workspace_destroy(ws);
+
+        printf("%10d %16.2f %16.2f %9.1fx%s\n", n, one_off_time * 1e6 / queries,
+               reused_time * 1e6 / queries, reused_time > 0 ? one_off_time / reused_time : 0.0,
+               one_off_sum == reused_sum ? "" : "  MISMATCH");
+
+        free(starts);
+        free(ends);
+        graph_destroy(graph);
+    }
+}
+
+/**
+ * Compare unidirectional and bidirectional search on random point-to-point queries
+ */
+static void bench_bidirectional(const int* sizes, int num_sizes) {
+    const int queries = 200;
+    printf("%10s %14s %14s %14s %14s %10s\n", "vertices", "uni ms/query", "bi ms/query",
+           "uni settled", "bi settled", "speedup");
+
+    for (int s = 0; s < num_sizes; s++) {
+        int n = sizes[s];
+        if (n < 2) continue;
+
+        Graph* graph = generate_sparse_graph(n);
+        graph_freeze(graph);
+        DijkstraWorkspace* ws = dijkstra_workspace_create(n);
+        DijkstraWorkspace* forward = dijkstra_workspace_create(n);
+        DijkstraWorkspace* backward = dijkstra_workspace_create(n);
+
+        double uni_time = 0, bi_time = 0;
+        long uni_settled = 0, bi_settled = 0;
+        bool match = true;
+        for (int q = 0; q < queries; q++) {
+            int start = random_below(n);
+            int end = random_below(n);
+
+            double begin = now_seconds();
+            PathResult uni = dijkstra_shortest_path_ws(graph, ws, start, end);
+            double middle = now_seconds();
+            PathResult bi = dijkstra_bidirectional_ws(graph, forward, backward, start, end);
+            double finish = now_seconds();
+
+            uni_time += middle - begin;
+            bi_time += finish - middle;
+            uni_settled += uni.settled;
+            bi_settled += bi.settled;
+            if (uni.total_distance != bi.total_distance) match = false;
+            path_result_destroy(&uni);
+            path_result_destroy(&bi);
+        }
+
+        printf("%10d %14.3f %14.3f %14ld %14ld %9.1fx%s\n", n, uni_time * 1000 / queries,
+               bi_time * 1000 / queries, uni_settled / queries, bi_settled / queries,
+               bi_time > 0 ? uni_time / bi_time : 0.0, match ? "" : "  MISMATCH");
+
+        dijkstra_workspace_destroy(ws);
+        dijkstra_workspace_destroy(forward);
+        dijkstra_workspace_destroy(backward);
+        graph_destroy(graph);
+    }
+}
+
+/**
+ * Compare plain Dijkstra with A* (coordinates and landmarks) on road-like grids
+ */
+static void bench_astar(const int* sizes, int num_sizes) {
+    const int queries = 100;
+    printf("%10s %12s %12s %12s %12s %12s %12s %10s\n", "vertices", "dijkstra ms", "coords ms",
+           "alt ms", "dij settled", "crd settled", "alt settled", "alt prep s");
+
+    for (int s = 0; s < num_sizes; s++) {
+        Graph* graph = generate_road_graph(sizes[s]);
+        int n = graph->num_vertices;
+        graph_freeze(graph);
+
+        double begin = now_seconds();
+        Heuristic* coords = heuristic_coordinates(graph);
+        Heuristic* landmarks = heuristic_landmarks(graph, DEFAULT_LANDMARKS);
+        double prep_time = now_seconds() - begin;
+
+        DijkstraWorkspace* ws = dijkstra_workspace_create(n);
+        double times[3] = {0, 0, 0};
+        long settled[3] = {0, 0, 0};
+        bool match = true;
+
+        for (int q = 0; q < queries; q++) {
+            int start = random_below(n);
+            int end = random_below(n);
+            PathResult results[3];
+
+            double t0 = now_seconds();
+            results[0] = dijkstra_shortest_path_ws(graph, ws, start, end);
+            double t1 = now_seconds();
+            results[1] = astar_shortest_path_ws(graph, coords, ws, start, end);
+            double t2 = now_seconds();
+            results[2] = astar_shortest_path_ws(graph, landmarks, ws, start, end);
+            double t3 = now_seconds();
+
+            times[0] += t1 - t0;
+            times[1] += t2 - t1;
+            times[2] += t3 - t2;
+            for (int k = 0; k < 3; k++) {
+                settled[k] += results[k].settled;
+                if (results[k].total_distance != results[0].total_distance) match = false;
+                path_result_destroy(&results[k]);
+            }
+        }
+
+        printf("%10d %12.3f %12.3f %12.3f %12ld %12ld %12ld %10.2f%s\n", n,
+               times[0] * 1000 / queries, times[1] * 1000 / queries, times[2] * 1000 / queries,
+               settled[0] / queries, settled[1] / queries, settled[2] / queries, prep_time,
+               match ? "" : "  MISMATCH");
+
+        dijkstra_workspace_destroy(ws);
+        heuristic_destroy(coords);
+        heuristic_destroy(landmarks);
+        graph_destroy(graph);
+    }
+}
+
+/**
+ * Preprocess road-like grids into contraction hierarchies and time queries
+ * against bidirectional Dijkstra
+ */
+static void bench_ch(const int* sizes, int num_sizes) {
+    const int queries = 1000;
+    printf("%10s %10s %10s %10s %12s %12s %12s %12s\n", "vertices", "roads", "prep s", "shortcuts",
+           "bidir us", "ch us", "bidir settl", "ch settled");
+
+    for (int s = 0; s < num_sizes; s++) {
+        Graph* graph = generate_road_graph(sizes[s]);
+        int n = graph->num_vertices;
+        const CsrGraph* csr = graph_freeze(graph);
+        ContractionHierarchy* ch = ch_build(graph);
+
+        DijkstraWorkspace* forward = dijkstra_workspace_create(n);
+        DijkstraWorkspace* backward = dijkstra_workspace_create(n);
+        double bidir_time = 0, ch_time = 0;
+        long bidir_settled = 0, ch_settled = 0;
+        bool match = true;
+
+        for (int q = 0; q < queries; q++) {
+            int start = random_below(n);
+            int end = random_below(n);
+
+            double t0 = now_seconds();
+            PathResult bi = dijkstra_bidirectional_ws(graph, forward, backward, start, end);
+            double t1 = now_seconds();
+            PathResult hierarchy = ch_shortest_path_ws(ch, forward, backward, start, end);
+            double t2 = now_seconds();
+
+            bidir_time += t1 - t0;
+            ch_time += t2 - t1;
+            bidir_settled += bi.settled;
+            ch_settled += hierarchy.settled;
+            if (bi.total_distance != hierarchy.total_distance) match = false;
+            path_result_destroy(&bi);
+            path_result_destroy(&hierarchy);
+        }
+
+        printf("%10d %10d %10.2f %10d %12.1f %12.1f %12ld %12ld%s\n", n, csr->num_edges / 2,
+               ch->preprocess_seconds, ch->num_shortcuts, bidir_time * 1e6 / queries,
+               ch_time * 1e6 / queries, bidir_settled / queries, ch_settled / queries,
+               match ? "" : "  MISMATCH");
+
+        dijkstra_workspace_destroy(forward);
+        dijkstra_workspace_destroy(backward);
+        ch_destroy(ch);
+        graph_destroy(graph);
+    }
+}
+
+/**
+ * Batch mode throughput with 1, 2, 4 and 8 worker threads
+ * Output goes to /dev/null so the numbers are search plus formatting cost.
+ */
+static void bench_batch(const int* sizes, int num_sizes) {
+    const int queries = 1000;
+    const int thread_counts[] = {1, 2, 4, 8};
+    printf("(%d processors online)\n", parallel_default_threads());
+    printf("%10s %10s %10s %12s %10s\n", "vertices", "queries", "threads", "queries/s", "speedup");
+
+    for (int s = 0; s < num_sizes; s++) {
+        Graph* graph = generate_sparse_graph(sizes[s]);
+        int n = graph->num_vertices;
+        graph_freeze(graph);
+        RouteEngine engine = {graph, NULL, NULL, false, NULL, NULL};
+
+        FILE* input = tmpfile();
+        for (int q = 0; q < queries; q++) {
+            fprintf(input, "%s %s\n", graph->vertices[random_below(n)].name,
+                    graph->vertices[random_below(n)].name);
+        }
+        FILE* sink = fopen("/dev/null", "w");
+
+        double single = 0;
+        for (int t = 0; t < 4; t++) {
+            BatchStats stats;
+            rewind(input);
+            batch_run(&engine, input, sink, thread_counts[t], &stats);
+            double rate = stats.queries / stats.seconds;
+            if (t == 0) single = rate;
+            printf("%10d %10d %10d %12.0f %9.2fx\n", n, stats.queries, thread_counts[t], rate, rate / single);
+        }
+
+        fclose(sink);
+        fclose(input);
+        graph_destroy(graph);
+    }
+}
+
+/**
+ * Depot x customer distance matrix: pairwise queries vs one search per depot
+ */
+static void bench_table(const int* sizes, int num_sizes) {
+    const int n_src = 20, n_tgt = 100;
+    int threads = parallel_default_threads();
+    printf("%10s %8s %12s %12s %14s\n", "vertices", "table", "pairwise s", "table s", "parallel s");
+
+    for (int s = 0; s < num_sizes; s++) {
+        Graph* graph = generate_sparse_graph(sizes[s]);
+        int n = graph->num_vertices;
+        graph_freeze(graph);
+
+        int sources[n_src], targets[n_tgt];
+        for (int i = 0; i < n_src; i++) sources[i] = random_below(n);
+        for (int j = 0; j < n_tgt; j++) targets[j] = random_below(n);
+        int* pairwise = (int*)malloc(sizeof(int) * n_src * n_tgt);
+        int* table = (int*)malloc(sizeof(int) * n_src * n_tgt);
+        int* parallel = (int*)malloc(sizeof(int) * n_src * n_tgt);
+
+        // Pairwise: one early-exit search for every cell
+        DijkstraWorkspace* ws = dijkstra_workspace_create(n);
+        double t0 = now_seconds();
+        for (int i = 0; i < n_src; i++) {
+            for (int j = 0; j < n_tgt; j++) {
+                PathResult result = dijkstra_shortest_path_ws(graph, ws, sources[i], targets[j]);
+                pairwise[i * n_tgt + j] = result.found ? result.total_distance : INT_MAX;
+                path_result_destroy(&result);
+            }
+        }
+        double t1 = now_seconds();
+        dijkstra_distance_table(graph, sources, n_src, targets, n_tgt, table);
+        double t2 = now_seconds();
+        DistanceTableOptions options = {threads, NULL};
+        dijkstra_distance_table_parallel(graph, sources, n_src, targets, n_tgt, parallel, &options);
+        double t3 = now_seconds();
+
+        bool match = memcmp(pairwise, table, sizeof(int) * n_src * n_tgt) == 0 &&
+                     memcmp(pairwise, parallel, sizeof(int) * n_src * n_tgt) == 0;
+        printf("%10d %4dx%-3d %12.3f %12.3f %10.3f (%d)%s\n", n, n_src, n_tgt, t1 - t0, t2 - t1,
+               t3 - t2, threads, match ? "" : "  MISMATCH");
+
+        dijkstra_workspace_destroy(ws);
+        free(pairwise);
+        free(table);
+        free(parallel);
+        graph_destroy(graph);
+    }
+}
+
+/**
+ * Startup cost: parse the text files and freeze vs map and verify a snapshot
+ * The same query then runs on both graphs as a check.
+ */
+static void bench_snapshot(const int* sizes, int num_sizes) {
+    char vertices_file[64], distances_file[64], snapshot_file[64];
+    snprintf(vertices_file, sizeof(vertices_file), "/tmp/bench_vertices_%d.txt", (int)getpid());
+    snprintf(distances_file, sizeof(distances_file), "/tmp/bench_distances_%d.txt", (int)getpid());
+    snprintf(snapshot_file, sizeof(snapshot_file), "/tmp/bench_snapshot_%d.bin", (int)getpid());
+
+    printf("%10s %10s %10s %12s %12s %12s %10s\n", "cities", "roads", "file MB", "text ms",
+           "snapshot ms", "compile ms", "speedup");
+
+    for (int s = 0; s < num_sizes; s++) {
+        int n = sizes[s];
+        if (n < 2) continue;
+
+        Graph* generated = generate_sparse_graph(n);
+        write_graph_files(generated, vertices_file, distances_file);
+        double compile_begin = now_seconds();
+        snapshot_write(generated, snapshot_file);
+        double compile_time = now_seconds() - compile_begin;
+        graph_destroy(generated);
+        int start = random_below(n), end = random_below(n);
+
+        double t0 = now_seconds();
+        Graph* text = graph_create(50);
+        load_vertices(text, vertices_file);
+        load_distances(text, distances_file);
+        graph_freeze(text);
+        double t1 = now_seconds();
+        Graph* mapped = snapshot_load(snapshot_file);
+        double t2 = now_seconds();
+
+        PathResult text_result = dijkstra_shortest_path(text, start, end);
+        PathResult mapped_result = dijkstra_shortest_path(mapped, start, end);
+        printf("%10d %10d %10.1f %12.1f %12.1f %12.1f %9.1fx%s\n", n, mapped->csr->num_edges / 2,
+               mapped->mapped_bytes / 1e6, (t1 - t0) * 1000, (t2 - t1) * 1000, compile_time * 1000,
+               (t1 - t0) / (t2 - t1),
+               text_result.total_distance == mapped_result.total_distance ? "" : "  MISMATCH");
+
+        path_result_destroy(&text_result);
+        path_result_destroy(&mapped_result);
+        graph_destroy(text);
+        graph_destroy(mapped);
+    }
+
+    remove(vertices_file);
+    remove(distances_file);
+    remove(snapshot_file);
+}
+
+/**
+ * The original fgets/sscanf distances loader, kept as the parsing baseline
+ */
+static void load_distances_sscanf(Graph* graph, const char* filename) {
+    FILE* file = fopen(filename, "r");
+    char line[256];
+    while (fgets(line, sizeof(line), file)) {
+        char city1[100], city2[100];
+        int distance;
+        if (sscanf(line, "%s %s %d", city1, city2, &distance) != 3) continue;
+        // Same insertion as the streaming loader, so only the parsing differs
+        graph_append_edge_index(graph, graph_find_vertex(graph, city1), graph_find_vertex(graph, city2), distance);
+    }
+    graph_merge_parallel_edges(graph);
+    fclose(file);
+}
+
+/**
+ * Seconds to read a file in 1 MB blocks and discard it (the bandwidth ceiling)
+ */
+static double read_file_seconds(const char* filename, size_t* bytes) {
+    char* block = (char*)malloc(1 << 20);
+    double begin = now_seconds();
+    FILE* file = fopen(filename, "rb");
+    size_t got;
+    *bytes = 0;
+    while ((got = fread(block, 1, 1 << 20, file)) > 0) *bytes += got;
+    fclose(file);
+    double elapsed = now_seconds() - begin;
+    free(block);
+    return elapsed;
+}
+
+/**
+ * Distances file throughput in MB/s (graph insertion included for both loaders)
+ * Sizes are road counts over a fixed set of 1000 cities, so the name
+ * index stays in cache and the cost measured is mostly reading and parsing.
+ */
+static void bench_parse(const int* sizes, int num_sizes) {
+    const int cities = 1000;
+    char vertices_file[64], distances_file[64];
+    snprintf(vertices_file, sizeof(vertices_file), "/tmp/bench_vertices_%d.txt", (int)getpid());
+    snprintf(distances_file, sizeof(distances_file), "/tmp/bench_distances_%d.txt", (int)getpid());
+
+    printf("(%d cities)\n", cities);
+    printf("%10s %10s %12s %12s %12s %10s\n", "roads", "file MB", "read MB/s", "sscanf MB/s",
+           "stream MB/s", "speedup");
+
+    FILE* vertices = fopen(vertices_file, "w");
+    for (int c = 0; c < cities; c++) fprintf(vertices, "city_%d\n", c);
+    fclose(vertices);
+
+    for (int s = 0; s < num_sizes; s++) {
+        int roads = sizes[s];
+        FILE* distances = fopen(distances_file, "w");
+        for (int r = 0; r < roads; r++) {
+            fprintf(distances, "city_%d city_%d %d\n", random_below(cities), random_below(cities),
+                    1 + random_below(MAX_WEIGHT));
+        }
+        fclose(distances);
+
+        size_t bytes;
+        double read_time = read_file_seconds(distances_file, &bytes);
+
+        Graph* baseline = graph_create(50);
+        load_vertices(baseline, vertices_file);
+        double t0 = now_seconds();
+        load_distances_sscanf(baseline, distances_file);
+        double t1 = now_seconds();
+
+        Graph* streamed = graph_create(50);
+        load_vertices(streamed, vertices_file);
+        double t2 = now_seconds();
+        load_distances(streamed, distances_file);
+        double t3 = now_seconds();
+
+        double mb = bytes / 1e6;
+        printf("%10d %10.1f %12.0f %12.0f %12.0f %9.2fx\n", roads, mb, mb / read_time, mb / (t1 - t0),
+               mb / (t3 - t2), (t1 - t0) / (t3 - t2));
+
+        graph_destroy(baseline);
+        graph_destroy(streamed);
+    }
+
+    remove(vertices_file);
+    remove(distances_file);
+}
+
+/**
+ * Check that two graphs have identical adjacency lists, order included
+ */
+static bool same_adjacency(const Graph* a, const Graph* b) {
+    if (a->num_vertices != b->num_vertices) return false;
+    for (int v = 0; v < a->num_vertices; v++) {
+        EdgeNode* x = a->vertices[v].edges;
+        EdgeNode* y = b->vertices[v].edges;
+        for (; x && y; x = x->next, y = y->next) {
+            if (x->dest != y->dest || x->weight != y->weight) return false;
+        }
+        if (x || y) return false;
+    }
+    return true;
+}
+
+/**
+ * Distances load time as the thread count grows
+ */
+static void bench_parallel_load(const int* sizes, int num_sizes) {
+    const int thread_counts[] = {1, 2, 4, 8};
+    char vertices_file[64], distances_file[64];
+    snprintf(vertices_file, sizeof(vertices_file), "/tmp/bench_vertices_%d.txt", (int)getpid());
+    snprintf(distances_file, sizeof(distances_file), "/tmp/bench_distances_%d.txt", (int)getpid());
+
+    printf("(%d processors online)\n", parallel_default_threads());
+    printf("%10s %10s %10s %12s %10s\n", "cities", "roads", "threads", "load ms", "speedup");
+
+    for (int s = 0; s < num_sizes; s++) {
+        int n = sizes[s];
+        if (n < 2) continue;
+
+        Graph* generated = generate_sparse_graph(n);
+        write_graph_files(generated, vertices_file, distances_file);
+        graph_destroy(generated);
+
+        Graph* sequential = graph_create(50);
+        load_vertices(sequential, vertices_file);
+        double begin = now_seconds();
+        load_distances(sequential, distances_file);
+        double sequential_time = now_seconds() - begin;
+        printf("%10d %10d %10s %12.1f %9.2fx\n", n, n * AVERAGE_DEGREE / 2, "seq",
+               sequential_time * 1000, 1.0);
+
+        for (int t = 0; t < 4; t++) {
+            Graph* graph = graph_create(50);
+            load_vertices(graph, vertices_file);
+            begin = now_seconds();
+            load_distances_parallel(graph, distances_file, thread_counts[t]);
+            double elapsed = now_seconds() - begin;
+            printf("%10d %10d %10d %12.1f %9.2fx%s\n", n, n * AVERAGE_DEGREE / 2, thread_counts[t],
+                   elapsed * 1000, sequential_time / elapsed,
+                   same_adjacency(sequential, graph) ? "" : "  MISMATCH");
+            graph_destroy(graph);
+        }
+        graph_destroy(sequential);
+    }
+
+    remove(vertices_file);
+    remove(distances_file);
+}
+
+/**
+ * Skewed traffic: 80% of queries repeat one of 300 hot pairs (either direction)
+ */
+static void bench_cache(const int* sizes, int num_sizes) {
+    const int queries = 2000, hot_pairs = 300;
+    printf("%10s %10s %12s %12s %10s %10s\n", "vertices", "queries", "no cache s", "cache s",
+           "hit rate", "speedup");
+
+    for (int s = 0; s < num_sizes; s++) {
+        Graph* graph = generate_sparse_graph(sizes[s]);
+        int n = graph->num_vertices;
+        graph_freeze(graph);
+
+        int* starts = (int*)malloc(sizeof(int) * queries);
+        int* ends = (int*)malloc(sizeof(int) * queries);
+        int hot[300][2];
+        for (int h = 0; h < hot_pairs; h++) {
+            hot[h][0] = random_below(n);
+            hot[h][1] = random_below(n);
+        }
+        for (int q = 0; q < queries; q++) {
+            if (random_below(10) < 8) {
+                int h = random_below(hot_pairs);
+                bool flip = random_below(2);
+                starts[q] = hot[h][flip];
+                ends[q] = hot[h][!flip];
+            } else {
+                starts[q] = random_below(n);
+                ends[q] = random_below(n);
+            }
+        }
+
+        DijkstraWorkspace* ws = dijkstra_workspace_create(n);
+        RouteCache* cache = route_cache_create(DEFAULT_CACHE_ENTRIES);
+        long plain_total = 0, cached_total = 0;
+
+        double t0 = now_seconds();
+        for (int q = 0; q < queries; q++) {
+            PathResult result = dijkstra_shortest_path_ws(graph, ws, starts[q], ends[q]);
+            plain_total += result.total_distance;
+            path_result_destroy(&result);
+        }
+        double t1 = now_seconds();
+        for (int q = 0; q < queries; q++) {
+            PathResult result;
+            if (!route_cache_lookup(cache, graph, starts[q], ends[q], &result)) {
+                result = dijkstra_shortest_path_ws(graph, ws, starts[q], ends[q]);
+                route_cache_store(cache, graph, starts[q], ends[q], &result);
+            }
+            cached_total += result.total_distance;
+            path_result_destroy(&result);
+        }
+        double t2 = now_seconds();
+
+        printf("%10d %10d %12.3f %12.3f %9.1f%% %9.2fx%s\n", n, queries, t1 - t0, t2 - t1,
+               100.0 * cache->hits / queries, (t1 - t0) / (t2 - t1),
+               plain_total == cached_total ? "" : "  MISMATCH");
+
+        route_cache_destroy(cache);
+        dijkstra_workspace_destroy(ws);
+        free(starts);
+        free(ends);
+        graph_destroy(graph);
+    }
+}
+
+/**
+ * One origin, many destinations
+ */
+static void bench_tree(const int* sizes, int num_sizes) {
+    const int destinations = 200;
+    printf("%10s %12s %12s %12s %10s\n", "vertices", "destinations", "fresh s", "tree s", "speedup");
+
+    for (int s = 0; s < num_sizes; s++) {
+        Graph* graph = generate_sparse_graph(sizes[s]);
+        int n = graph->num_vertices;
+        graph_freeze(graph);
+        int origin = random_below(n);
+
+        DijkstraWorkspace* ws = dijkstra_workspace_create(n);
+        ShortestPathTree* tree = path_tree_create(graph, origin);
+        long fresh_total = 0, tree_total = 0;
+        double fresh_time = 0, tree_time = 0;
+
+        for (int d = 0; d < destinations; d++) {
+            int end = random_below(n);
+            double t0 = now_seconds();
+            PathResult fresh = dijkstra_shortest_path_ws(graph, ws, origin, end);
+            double t1 = now_seconds();
+            PathResult kept = path_tree_path(tree, end);
+            double t2 = now_seconds();
+            fresh_time += t1 - t0;
+            tree_time += t2 - t1;
+            fresh_total += fresh.total_distance;
+            tree_total += kept.total_distance;
+            path_result_destroy(&fresh);
+            path_result_destroy(&kept);
+        }
+
+        printf("%10d %12d %12.3f %12.3f %9.1fx%s\n", n, destinations, fresh_time, tree_time,
+               fresh_time / tree_time, fresh_total == tree_total ? "" : "  MISMATCH");
+
+        path_tree_destroy(tree);
+        dijkstra_workspace_destroy(ws);
+        graph_destroy(graph);
+    }
+}
+
+/**
+ * Road changes with ALT landmarks kept up to date: repair vs rebuild
+ * Changes halve or add 50% to the first road of a random city.
+ */
+static void bench_update(const int* sizes, int num_sizes) {
+    const int changes = 200;
+    const int num_landmarks = 8;
+    printf("%10s %10s %14s %14s %10s\n", "vertices", "changes", "repair ms/chg", "rebuild ms/chg", "speedup");
+
+    for (int s = 0; s < num_sizes; s++) {
+        Graph* graph = generate_sparse_graph(sizes[s]);
+        int n = graph->num_vertices;
+        graph_freeze(graph);
+        Heuristic* landmarks = heuristic_landmarks(graph, num_landmarks);
+
+        double repair_time = 0;
+        for (int c = 0; c < changes; c++) {
+            RoadChange change;
+            change.from = random_below(n);
+            change.to = graph->vertices[change.from].edges->dest;
+            change.existed = graph_find_edge(graph, change.from, change.to, &change.old_weight);
+            change.exists = true;
+            change.new_weight = c % 2 == 0 ? change.old_weight / 2 : change.old_weight * 3 / 2;
+            graph_update_edge_index(graph, change.from, change.to, change.new_weight);
+
+            double t0 = now_seconds();
+            heuristic_repair(landmarks, graph, &change);
+            repair_time += now_seconds() - t0;
+        }
+
+        // One rebuild is what every change would cost without the repair
+        double t0 = now_seconds();
+        Heuristic* rebuilt = heuristic_landmarks(graph, num_landmarks);
+        double rebuild_time = now_seconds() - t0;
+
+        // The repaired landmarks must still give exact A* answers
+        bool exact = true;
+        for (int q = 0; q < 20; q++) {
+            int start = random_below(n);
+            int end = random_below(n);
+            PathResult reference = dijkstra_shortest_path(graph, start, end);
+            PathResult repaired = astar_shortest_path(graph, landmarks, start, end);
+            if (reference.total_distance != repaired.total_distance) exact = false;
+            path_result_destroy(&reference);
+            path_result_destroy(&repaired);
+        }
+
+        printf("%10d %10d %14.3f %14.3f %9.0fx%s\n", n, changes, repair_time * 1000 / changes,
+               rebuild_time * 1000, rebuild_time * changes / repair_time, exact ? "" : "  MISMATCH");
+
+        heuristic_destroy(rebuilt);
+        heuristic_destroy(landmarks);
+        graph_destroy(graph);
+    }
+}
+
+/**
+ * Search time per order on road-like grids whose cities are listed in random order
+ * (as real files are); the edge span is how far apart neighbours sit in memory.
+ * Run under perf stat -e cache-misses to see the misses themselves.
+ */
+static void bench_reorder(const int* sizes, int num_sizes) {
+    const int queries = 50;
+    const char* names[3] = {"scrambled", "bfs", "hilbert"};
+    printf("%10s %10s %12s %12s %14s %10s\n", "vertices", "order", "reorder ms", "edge span",
+           "dijkstra ms", "speedup");
+
+    for (int s = 0; s < num_sizes; s++) {
+        Graph* graph = generate_road_graph(sizes[s]);
+        int n = graph->num_vertices;
+
+        // Fisher-Yates shuffle stands in for file order
+        int* shuffle = (int*)malloc(sizeof(int) * n);
+        for (int i = 0; i < n; i++) shuffle[i] = i;
+        for (int i = n - 1; i > 0; i--) {
+            int j = random_below(i + 1);
+            int swap = shuffle[i];
+            shuffle[i] = shuffle[j];
+            shuffle[j] = swap;
+        }
+        graph_relabel(graph, shuffle);
+        free(shuffle);
+
+        // Queries are fixed by city name, so every order answers the same ones
+        char (*from)[32] = malloc(sizeof(*from) * queries);
+        char (*to)[32] = malloc(sizeof(*to) * queries);
+        for (int q = 0; q < queries; q++) {
+            snprintf(from[q], sizeof(from[q]), "r%d", random_below(n));
+            snprintf(to[q], sizeof(to[q]), "r%d", random_below(n));
+        }
+
+        DijkstraWorkspace* ws = dijkstra_workspace_create(n);
+        double baseline = 0;
+        long reference = 0;
+        for (int k = 0; k < 3; k++) {
+            double begin = now_seconds();
+            if (k > 0) reorder_graph(graph, k == 1 ? ORDER_BFS : ORDER_HILBERT);
+            graph_freeze(graph);
+            double reorder_time = now_seconds() - begin;
+            double span = reorder_edge_span(graph);
+
+            long checksum = 0;
+            begin = now_seconds();
+            for (int q = 0; q < queries; q++) {
+                PathResult result = dijkstra_shortest_path_ws(graph, ws, graph_find_vertex(graph, from[q]),
+                                                              graph_find_vertex(graph, to[q]));
+                if (result.found) checksum += result.total_distance;
+                path_result_destroy(&result);
+            }
+            double search_time = (now_seconds() - begin) / queries;
+            if (k == 0) {
+                baseline = search_time;
+                reference = checksum;
+            }
+
+            printf("%10d %10s %12.1f %12.1f %14.3f %9.2fx%s\n", n, names[k], k > 0 ? reorder_time * 1000 : 0.0,
+                   span, search_time * 1000, baseline / search_time, checksum == reference ? "" : "  MISMATCH");
+        }
+
+        dijkstra_workspace_destroy(ws);
+        free(from);
+        free(to);
+        graph_destroy(graph);
+    }
+}
+
+#define SUITE_CH_LIMIT 10000    // Largest graph the suite contracts (preprocessing grows faster than n)
+
+// A named graph generator for the suite
+typedef struct SuiteFamily {
+    const char* name;
+    Graph* (*generate)(int num_vertices);
+} SuiteFamily;
+
+static const SuiteFamily suite_families[] = {
+    {"grid", generate_grid_graph},
+    {"geometric", generate_geometric_graph},
+    {"scalefree", generate_scale_free_graph},
+    {"road", generate_road_graph},
+};
+#define SUITE_FAMILIES ((int)(sizeof(suite_families) / sizeof(suite_families[0])))
+
+// Query engines the suite times on every graph
+typedef enum SuiteEngine {
+    ENGINE_DIJKSTRA,
+    ENGINE_BIDIRECTIONAL,
+    ENGINE_COORDINATES,
+    ENGINE_LANDMARKS,
+    ENGINE_CH,
+    SUITE_ENGINES
+} SuiteEngine;
+
+static const char* suite_engine_names[SUITE_ENGINES] = {"dijkstra", "bidir", "astar-coords", "astar-alt", "ch"};
+
+// Latency distribution of one engine on one graph
+typedef struct SuiteResult {
+    double prep_seconds;   // Heuristic or hierarchy build time, 0 for plain searches
+    double mean_us;
+    double p50_us;
+    double p90_us;
+    double p99_us;
+    double max_us;
+    long mean_settled;
+    long checksum;         // Sum of found distances, equal across engines when all are exact
+} SuiteResult;
+
+/**
+ * Reseed so each (family, size) graph is the same however the suite is invoked
+ */
+static void seed_random(uint64_t seed, int family, int n) {
+    rng_state = seed * 0x9E3779B97F4A7C15ULL ^ ((uint64_t)(family + 1) << 32 | (uint32_t)n);
+    if (rng_state == 0) rng_state = BENCH_SEED;  // xorshift never leaves zero
+}
+
+/**
+ * Queries per engine: plenty on small graphs, at least 20 on the largest
+ */
+static int suite_queries(int n) {
+    long queries = 20000000L / n;
+    if (queries > 500) queries = 500;
+    if (queries < 20) queries = 20;
+    return (int)queries;
+}
+
+/**
+ * qsort comparator for latency samples
+ */
+static int compare_seconds(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Nearest-rank percentile of sorted samples, in microseconds
+ */
+static double sample_percentile_us(const double* sorted, int count, double fraction) {
+    int rank = (int)ceil(fraction * count);
+    if (rank < 1) rank = 1;
+    return sorted[rank - 1] * 1e6;
+}
+
+/**
+ * Prepare one engine and time it over the shared query list
+ * Returns false when the engine does not apply (no coordinates, graph too big to contract).
+ */
+static bool suite_run_engine(SuiteEngine engine, Graph* graph, const int* starts, const int* ends,
+                             int queries, SuiteResult* out) {
+    int n = graph->num_vertices;
+    Heuristic* heuristic = NULL;
+    ContractionHierarchy* ch = NULL;
+
+    double begin = now_seconds();
+    if (engine == ENGINE_COORDINATES) {
+        heuristic = heuristic_coordinates(graph);
+        if (!heuristic) return false;
+    } else if (engine == ENGINE_LANDMARKS) {
+        heuristic = heuristic_landmarks(graph, DEFAULT_LANDMARKS);
+    } else if (engine == ENGINE_CH) {
+        if (n > SUITE_CH_LIMIT) return false;
+        ch = ch_build(graph);
+    }
+    out->prep_seconds = now_seconds() - begin;
+
+    DijkstraWorkspace* forward = dijkstra_workspace_create(n);
+    DijkstraWorkspace* backward = dijkstra_workspace_create(n);
+    double* samples = (double*)malloc(sizeof(double) * queries);
+    double total = 0;
+    long settled = 0;
+    out->checksum = 0;
+
+    for (int q = 0; q < queries; q++) {
+        PathResult result;
+        double t0 = now_seconds();
+        switch (engine) {
+            case ENGINE_DIJKSTRA:
+                result = dijkstra_shortest_path_ws(graph, forward, starts[q], ends[q]);
+                break;
+            case ENGINE_BIDIRECTIONAL:
+                result = dijkstra_bidirectional_ws(graph, forward, backward, starts[q], ends[q]);
+                break;
+            case ENGINE_CH:
+                result = ch_shortest_path_ws(ch, forward, backward, starts[q], ends[q]);
+                break;
+            default:
+                result = astar_shortest_path_ws(graph, heuristic, forward, starts[q], ends[q]);
+                break;
+        }
+        samples[q] = now_seconds() - t0;
+
+        total += samples[q];
+        settled += result.settled;
+        if (result.found) out->checksum += result.total_distance;
+        path_result_destroy(&result);
+    }
+
+    qsort(samples, queries, sizeof(double), compare_seconds);
+    out->mean_us = total * 1e6 / queries;
+    out->p50_us = sample_percentile_us(samples, queries, 0.5);
+    out->p90_us = sample_percentile_us(samples, queries, 0.9);
+    out->p99_us = sample_percentile_us(samples, queries, 0.99);
+    out->max_us = samples[queries - 1] * 1e6;
+    out->mean_settled = settled / queries;
+
+    free(samples);
+    dijkstra_workspace_destroy(forward);
+    dijkstra_workspace_destroy(backward);
+    heuristic_destroy(heuristic);
+    if (ch) ch_destroy(ch);
+    return true;
+}
+
+/**
+ * Benchmark suite: for every generator family and size, time loading the
+ * graph back from text, report its memory, and give each engine's query
+ * latency distribution. Rows can also be appended to a CSV file, so runs on
+ * different commits can be compared.
+ */
+static void bench_suite(const int* sizes, int num_sizes, const char* family, uint64_t seed,
+                        const char* csv_file) {
+    char vertices_file[64], distances_file[64];
+    snprintf(vertices_file, sizeof(vertices_file), "/tmp/bench_vertices_%d.txt", (int)getpid());
+    snprintf(distances_file, sizeof(distances_file), "/tmp/bench_distances_%d.txt", (int)getpid());
+
+    FILE* csv = NULL;
+    if (csv_file) {
+        csv = fopen(csv_file, "a");
+        if (!csv) {
+            fprintf(stderr, "Error: Cannot open %s\n", csv_file);
+            return;
+        }
+        if (ftell(csv) == 0) {
+            fprintf(csv, "family,vertices,roads,seed,threads,load_ms,memory_mb,engine,prep_s,queries,"
+                         "mean_us,p50_us,p90_us,p99_us,max_us,mean_settled,match\n");
+        }
+    }
+
+    int threads = parallel_default_threads();
+    printf("Seed %llu, %d loader threads, %s heap\n", (unsigned long long)seed, threads, pq_name());
+    printf("%-10s %9s %9s %9s %8s %-13s %8s %7s %10s %10s %10s %10s %9s\n", "family", "vertices",
+           "roads", "load ms", "mem MB", "engine", "prep s", "queries", "mean us", "p50 us", "p90 us",
+           "p99 us", "settled");
+
+    bool matched = false;
+    for (int f = 0; f < SUITE_FAMILIES; f++) {
+        if (family && strcmp(family, suite_families[f].name) != 0) continue;
+        matched = true;
+
+        for (int s = 0; s < num_sizes; s++) {
+            if (sizes[s] < 2) continue;
+            seed_random(seed, f, sizes[s]);
+            Graph* generated = suite_families[f].generate(sizes[s]);
+            write_graph_files(generated, vertices_file, distances_file);
+
+            // Load time is what map.out pays: vertices, roads in parallel, then the CSR
+            Graph* graph = graph_create(50);
+            double begin = now_seconds();
+            load_vertices(graph, vertices_file);
+            load_distances_parallel(graph, distances_file, threads);
+            graph_freeze(graph);
+            double load_ms = (now_seconds() - begin) * 1000;
+
+            // Text files carry no positions, take them from the generator
+            if (graph_has_coordinates(generated)) {
+                for (int v = 0; v < graph->num_vertices; v++) {
+                    graph_set_coordinates(graph, v, generated->coords[v].latitude, generated->coords[v].longitude);
+                }
+            }
+            graph_destroy(generated);
+
+            GraphMemoryStats stats;
+            graph_memory_stats(graph, &stats);
+            int n = graph->num_vertices;
+            int roads = graph->csr->num_edges / 2;
+
+            int queries = suite_queries(n);
+            int* starts = (int*)malloc(sizeof(int) * queries);
+            int* ends = (int*)malloc(sizeof(int) * queries);
+            for (int q = 0; q < queries; q++) {
+                starts[q] = random_below(n);
+                ends[q] = random_below(n);
+            }
+
+            long reference = 0;
+            for (int e = 0; e < SUITE_ENGINES; e++) {
+                SuiteResult result;
+                if (!suite_run_engine((SuiteEngine)e, graph, starts, ends, queries, &result)) continue;
+                if (e == ENGINE_DIJKSTRA) reference = result.checksum;
+                bool match = result.checksum == reference;
+
+                printf("%-10s %9d %9d %9.1f %8.1f %-13s %8.2f %7d %10.1f %10.1f %10.1f %10.1f %9ld%s\n",
+                       suite_families[f].name, n, roads, load_ms, stats.total_bytes / 1e6,
+                       suite_engine_names[e], result.prep_seconds, queries, result.mean_us, result.p50_us,
+                       result.p90_us, result.p99_us, result.mean_settled, match ? "" : "  MISMATCH");
+                if (csv) {
+                    fprintf(csv, "%s,%d,%d,%llu,%d,%.1f,%.2f,%s,%.3f,%d,%.2f,%.2f,%.2f,%.2f,%.2f,%ld,%d\n",
+                            suite_families[f].name, n, roads, (unsigned long long)seed, threads, load_ms,
+                            stats.total_bytes / 1e6, suite_engine_names[e], result.prep_seconds, queries,
+                            result.mean_us, result.p50_us, result.p90_us, result.p99_us, result.max_us,
+                            result.mean_settled, match ? 1 : 0);
+                }
+            }
+            fflush(stdout);
+
+            free(starts);
+            free(ends);
+            graph_destroy(graph);
+        }
+    }
+
+    if (!matched) fprintf(stderr, "Error: Unknown family %s (grid, geometric, scalefree or road)\n", family);
+    if (csv) fclose(csv);
+    remove(vertices_file);
+    remove(distances_file);
+}
+
+/**
+ * Time the same queries with the heap and the bucket queue, one latency
+ * sample per query, on road-like grids (short roads) and random sparse graphs
+ * (weights up to MAX_WEIGHT, so more buckets to sweep)
+ */
+static void bench_dial(const int* sizes, int num_sizes) {
+    const int queries = 200;
+    const char* families[2] = {"road", "sparse"};
+    printf("%10s %8s %8s %10s %10s %10s %10s %10s\n", "vertices", "family", "queue", "max road",
+           "mean us", "p50 us", "p99 us", "speedup");
+
+    double* samples = (double*)malloc(sizeof(double) * queries);
+    int* starts = (int*)malloc(sizeof(int) * queries);
+    int* ends = (int*)malloc(sizeof(int) * queries);
+    for (int s = 0; s < num_sizes; s++) {
+        for (int f = 0; f < 2; f++) {
+            Graph* graph = f == 0 ? generate_road_graph(sizes[s]) : generate_sparse_graph(sizes[s]);
+            int n = graph->num_vertices;
+            const CsrGraph* csr = graph_freeze(graph);
+            for (int q = 0; q < queries; q++) {
+                starts[q] = random_below(n);
+                ends[q] = random_below(n);
+            }
+
+            DijkstraWorkspace* ws = dijkstra_workspace_create(n);
+            double baseline = 0;
+            long reference = 0;
+            for (int k = 0; k < 2; k++) {
+                long checksum = 0;
+                double total = 0;
+                for (int q = 0; q < queries; q++) {
+                    double begin = now_seconds();
+                    PathResult result = k == 0 ? dijkstra_shortest_path_ws(graph, ws, starts[q], ends[q])
+                                               : dijkstra_shortest_path_dial(graph, ws, starts[q], ends[q]);
+                    samples[q] = now_seconds() - begin;
+                    total += samples[q];
+                    if (result.found) checksum += result.total_distance;
+                    path_result_destroy(&result);
+                }
+                qsort(samples, queries, sizeof(double), compare_seconds);
+                double mean = total / queries;
+                if (k == 0) {
+                    baseline = mean;
+                    reference = checksum;
+                }
+
+                printf("%10d %8s %8s %10d %10.1f %10.1f %10.1f %9.2fx%s\n", n, families[f],
+                       k == 0 ? pq_name() : "buckets", csr->max_weight, mean * 1e6,
+                       sample_percentile_us(samples, queries, 0.5), sample_percentile_us(samples, queries, 0.99),
+                       baseline / mean, checksum == reference ? "" : "  MISMATCH");
+            }
+            fflush(stdout);
+
+            dijkstra_workspace_destroy(ws);
+            graph_destroy(graph);
+        }
+    }
+    free(samples);
+    free(starts);
+    free(ends);
+}
+
+/**
+ * Time one full single-source search per graph: sequential Dijkstra, then
+ * delta-stepping with the mean road as bucket width on growing thread counts
+ */
+static void bench_delta(const int* sizes, int num_sizes) {
+    const char* families[2] = {"road", "sparse"};
+    int thread_counts[] = {1, 2, 4, 8};
+    printf("(%d processors online)\n", parallel_default_threads());
+    printf("%10s %8s %10s %10s %10s %10s\n", "vertices", "family", "threads", "rounds", "ms", "speedup");
+
+    for (int s = 0; s < num_sizes; s++) {
+        for (int f = 0; f < 2; f++) {
+            Graph* graph = f == 0 ? generate_road_graph(sizes[s]) : generate_sparse_graph(sizes[s]);
+            int n = graph->num_vertices;
+            int source = random_below(n);
+            graph_freeze(graph);
+
+            DijkstraWorkspace* ws = dijkstra_workspace_create(n);
+            double begin = now_seconds();
+            dijkstra_search_all(graph, ws, source);
+            double baseline = now_seconds() - begin;
+            printf("%10d %8s %10s %10s %10.1f %9.2fx\n", n, families[f], "dijkstra", "-", baseline * 1000, 1.0);
+
+            int* dist = (int*)malloc(sizeof(int) * n);
+            int* parent = (int*)malloc(sizeof(int) * n);
+            for (int t = 0; t < 4; t++) {
+                DeltaOptions options = {thread_counts[t], 0};
+                begin = now_seconds();
+                int rounds = delta_stepping(graph, source, dist, parent, &options);
+                double seconds = now_seconds() - begin;
+
+                bool match = true;
+                for (int v = 0; v < n; v++) match = match && dist[v] == dijkstra_workspace_distance(ws, v);
+                printf("%10d %8s %10d %10d %10.1f %9.2fx%s\n", n, families[f], thread_counts[t], rounds,
+                       seconds * 1000, baseline / seconds, match ? "" : "  MISMATCH");
+                fflush(stdout);
+            }
+
+            free(dist);
+            free(parent);
+            dijkstra_workspace_destroy(ws);
+            graph_destroy(graph);
+        }
+    }
+}
+
+/**
+ * Build the all-pairs table both ways on sparse and dense graphs, note which
+ * one APSP_AUTO picks, then compare table lookups with Dijkstra searches
+ */
+static void bench_apsp(const int* sizes, int num_sizes) {
+    const int queries = 1000;
+    const char* families[2] = {"sparse", "dense"};
+    int num_threads = parallel_default_threads();
+    printf("(%d processors online)\n", num_threads);
+    printf("%10s %8s %8s %12s %12s %16s %10s %10s %10s\n", "vertices", "family", "degree", "floyd ms",
+           "dijkstra ms", "auto", "search us", "lookup us", "speedup");
+
+    int* starts = (int*)malloc(sizeof(int) * queries);
+    int* ends = (int*)malloc(sizeof(int) * queries);
+    for (int s = 0; s < num_sizes; s++) {
+        for (int f = 0; f < 2; f++) {
+            Graph* graph = f == 0 ? generate_sparse_graph(sizes[s]) : generate_dense_graph(sizes[s]);
+            int n = graph->num_vertices;
+            const CsrGraph* csr = graph_freeze(graph);
+
+            double begin = now_seconds();
+            AllPairsTable* floyd = apsp_build(graph, APSP_FLOYD, num_threads);
+            double floyd_time = now_seconds() - begin;
+            begin = now_seconds();
+            AllPairsTable* rows = apsp_build(graph, APSP_DIJKSTRA, num_threads);
+            double dijkstra_time = now_seconds() - begin;
+            bool match = memcmp(floyd->dist, rows->dist, sizeof(int) * (size_t)floyd->stride * floyd->stride) == 0;
+
+            for (int q = 0; q < queries; q++) {
+                starts[q] = random_below(n);
+                ends[q] = random_below(n);
+            }
+            DijkstraWorkspace* ws = dijkstra_workspace_create(n);
+            long search_sum = 0;
+            begin = now_seconds();
+            for (int q = 0; q < queries; q++) {
+                PathResult result = dijkstra_shortest_path_ws(graph, ws, starts[q], ends[q]);
+                if (result.found) search_sum += result.total_distance;
+                path_result_destroy(&result);
+            }
+            double search_time = (now_seconds() - begin) / queries;
+            long lookup_sum = 0;
+            begin = now_seconds();
+            for (int q = 0; q < queries; q++) {
+                PathResult result = apsp_path(floyd, starts[q], ends[q]);
+                if (result.found) lookup_sum += result.total_distance;
+                path_result_destroy(&result);
+            }
+            double lookup_time = (now_seconds() - begin) / queries;
+
+            printf("%10d %8s %8d %12.1f %12.1f %16s %10.1f %10.2f %9.0fx%s\n", n, families[f], csr->num_edges / n,
+                   floyd_time * 1000, dijkstra_time * 1000, apsp_method_name(apsp_choose(graph)), search_time * 1e6,
+                   lookup_time * 1e6, search_time / lookup_time,
+                   match && search_sum == lookup_sum ? "" : "  MISMATCH");
+            fflush(stdout);
+
+            dijkstra_workspace_destroy(ws);
+            apsp_destroy(floyd);
+            apsp_destroy(rows);
+            graph_destroy(graph);
+        }
+    }
+    free(starts);
+    free(ends);
+}
+
+/**
+ * Memory per directed edge and query latency of the packed adjacency against
+ * the lists and the CSR, on a grid-ordered road graph and a sparse graph
+ * before and after a BFS reordering (locality decides the gap widths).
+ * "before" and "after" are everything the graph holds per edge with lists and
+ * CSR, then with only the packed copy (names and vertex arrays included).
+ */
+static void bench_compact(const int* sizes, int num_sizes) {
+    const int queries = 200;
+    const char* layouts[3] = {"road", "sparse", "sparse+bfs"};
+    printf("%10s %11s %10s %10s %12s %11s %10s %10s %10s %11s %10s\n", "vertices", "layout", "list B/e",
+           "csr B/e", "compact B/e", "before B/e", "after B/e", "build ms", "csr us", "compact us", "slowdown");
+
+    int* starts = (int*)malloc(sizeof(int) * queries);
+    int* ends = (int*)malloc(sizeof(int) * queries);
+    for (int s = 0; s < num_sizes; s++) {
+        for (int l = 0; l < 3; l++) {
+            Graph* graph = l == 0 ? generate_road_graph(sizes[s]) : generate_sparse_graph(sizes[s]);
+            if (l == 2) reorder_graph(graph, ORDER_BFS);
+            int n = graph->num_vertices;
+            const CsrGraph* csr = graph_freeze(graph);
+            GraphMemoryStats before;
+            graph_memory_stats(graph, &before);
+            double edges = csr->num_edges;
+
+            for (int q = 0; q < queries; q++) {
+                starts[q] = random_below(n);
+                ends[q] = random_below(n);
+            }
+            DijkstraWorkspace* ws = dijkstra_workspace_create(n);
+            double times[2];
+            long checksum[2];
+
+            // The CSR runs first: packing frees it along with the lists
+            CompactGraph* compact = NULL;
+            double build_time = 0;
+            for (int k = 0; k < 2; k++) {
+                if (k == 1) {
+                    double begin = now_seconds();
+                    compact = compact_replace_edges(graph);
+                    build_time = now_seconds() - begin;
+                }
+                checksum[k] = 0;
+                double begin = now_seconds();
+                for (int q = 0; q < queries; q++) {
+                    PathResult result = k == 0 ? dijkstra_shortest_path_ws(graph, ws, starts[q], ends[q])
+                                               : compact_shortest_path(compact, ws, starts[q], ends[q]);
+                    if (result.found) checksum[k] += result.total_distance;
+                    path_result_destroy(&result);
+                }
+                times[k] = (now_seconds() - begin) / queries;
+            }
+            GraphMemoryStats after;
+            graph_memory_stats(graph, &after);
+
+            printf("%10d %11s %10.2f %10.2f %12.2f %11.2f %10.2f %10.1f %10.1f %11.1f %9.2fx%s\n", n, layouts[l],
+                   before.edge_bytes / edges, before.csr_bytes / edges, compact_bytes(compact) / edges,
+                   before.total_bytes / edges, (after.total_bytes + compact_bytes(compact)) / edges,
+                   build_time * 1000, times[0] * 1e6, times[1] * 1e6, times[1] / times[0],
+                   checksum[0] == checksum[1] ? "" : "  MISMATCH");
+            fflush(stdout);
+
+            dijkstra_workspace_destroy(ws);
+            compact_destroy(compact);
+            graph_destroy(graph);
+        }
+    }
+    free(starts);
+    free(ends);
+}
+
+/**
+ * Benchmark entry point
+ * Usage: ./bench.out [heap|load|csr|workspace|bidir|astar|ch|batch|table|snapshot|parse|pload|cache|tree|update|reorder|dial|delta|apsp|compact|all|suite]
+ *                    [--seed n] [--csv file] [--family name] [sizes ...]
+ */
+int main(int argc, char* argv[]) {
+    const char* mode = argc > 1 ? argv[1] : "all";
+    int heap_sizes[] = {1000, 2000, 5000, 10000};
+    int load_sizes[] = {10000, 50000, 100000, 200000};
+    int csr_sizes[] = {100000, 300000, 1000000};
+    int workspace_sizes[] = {10000, 100000, 1000000};
+    int bidir_sizes[] = {10000, 100000, 1000000};
+    int astar_sizes[] = {10000, 100000, 1000000};
+    int ch_sizes[] = {10000, 40000};
+    int batch_sizes[] = {10000, 50000};
+    int table_sizes[] = {10000, 30000};
+    int snapshot_sizes[] = {10000, 100000, 1000000};
+    int parse_sizes[] = {1000000, 10000000};
+    int pload_sizes[] = {100000, 1000000};
+    int cache_sizes[] = {5000, 20000};
+    int tree_sizes[] = {10000, 100000};
+    int update_sizes[] = {10000, 100000};
+    int reorder_sizes[] = {100000, 1000000};
+    int dial_sizes[] = {100000, 1000000};
+    int delta_sizes[] = {100000, 1000000};
+    int apsp_sizes[] = {1000, 2000, 4000};
+    int compact_sizes[] = {100000, 1000000};
+
+    int suite_sizes[] = {1000, 10000, 100000, 1000000};
+
+    // Options and optional sizes after the mode; sizes override the defaults
+    uint64_t seed = BENCH_SEED;
+    const char* csv_file = NULL;
+    const char* family = NULL;
+    int num_custom = 0;
+    int* custom = (int*)malloc(sizeof(int) * (argc > 2 ? argc - 2 : 1));
+    for (int i = 2; i < argc; i++) {
+        if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc) {
+            csv_file = argv[++i];
+        } else if (strcmp(argv[i], "--family") == 0 && i + 1 < argc) {
+            family = argv[++i];
+        } else {
+            custom[num_custom++] = atoi(argv[i]);
+        }
+    }
+    rng_state = seed != 0 ? seed : BENCH_SEED;
+
+    bool all = strcmp(mode, "all") == 0;
+    bool known = all;
+    if (all || strcmp(mode, "heap") == 0) {
+        printf("== heap: scan vs priority queue Dijkstra ==\n");
+        bench_heap(num_custom ? custom : heap_sizes, num_custom ? num_custom : 4);
+        known = true;
+    }
+    if (all || strcmp(mode, "load") == 0) {
+        printf("== load: text file loading ==\n");
+        bench_load(num_custom ? custom : load_sizes, num_custom ? num_custom : 4);
+        known = true;
+    }
+    if (all || strcmp(mode, "csr") == 0) {
+        printf("== csr: adjacency lists vs frozen CSR ==\n");
+        bench_csr(num_custom ? custom : csr_sizes, num_custom ? num_custom : 3);
+        known = true;
+    }
+    if (all || strcmp(mode, "workspace") == 0) {
+        printf("== workspace: per-query allocation vs reused workspace ==\n");
+        bench_workspace(num_custom ? custom : workspace_sizes, num_custom ? num_custom : 3);
+        known = true;
+    }
+    if (all || strcmp(mode, "bidir") == 0) {
+        printf("== bidir: unidirectional vs bidirectional Dijkstra ==\n");
+        bench_bidirectional(num_custom ? custom : bidir_sizes, num_custom ? num_custom : 3);
+        known = true;
+    }
+    if (all || strcmp(mode, "astar") == 0) {
+        printf("== astar: Dijkstra vs A* heuristics ==\n");
+        bench_astar(num_custom ? custom : astar_sizes, num_custom ? num_custom : 3);
+        known = true;
+    }
+    if (all || strcmp(mode, "ch") == 0) {
+        printf("== ch: contraction hierarchies ==\n");
+        bench_ch(num_custom ? custom : ch_sizes, num_custom ? num_custom : 2);
+        known = true;
+    }
+    if (all || strcmp(mode, "batch") == 0) {
+        printf("== batch: multi-threaded batch queries ==\n");
+        bench_batch(num_custom ? custom : batch_sizes, num_custom ? num_custom : 2);
+        known = true;
+    }
+    if (all || strcmp(mode, "table") == 0) {
+        printf("== table: pairwise queries vs distance tables ==\n");
+        bench_table(num_custom ? custom : table_sizes, num_custom ? num_custom : 2);
+        known = true;
+    }
+    if (all || strcmp(mode, "snapshot") == 0) {
+        printf("== snapshot: text loading vs mapped snapshot ==\n");
+        bench_snapshot(num_custom ? custom : snapshot_sizes, num_custom ? num_custom : 3);
+        known = true;
+    }
+    if (all || strcmp(mode, "parse") == 0) {
+        printf("== parse: distances file throughput ==\n");
+        bench_parse(num_custom ? custom : parse_sizes, num_custom ? num_custom : 2);
+        known = true;
+    }
+    if (all || strcmp(mode, "pload") == 0) {
+        printf("== pload: parallel distances loading ==\n");
+        bench_parallel_load(num_custom ? custom : pload_sizes, num_custom ? num_custom : 2);
+        known = true;
+    }
+    if (all || strcmp(mode, "cache") == 0) {
+        printf("== cache: skewed traffic with an LRU route cache ==\n");
+        bench_cache(num_custom ? custom : cache_sizes, num_custom ? num_custom : 2);
+        known = true;
+    }
+    if (all || strcmp(mode, "tree") == 0) {
+        printf("== tree: repeated origin with a shortest path tree ==\n");
+        bench_tree(num_custom ? custom : tree_sizes, num_custom ? num_custom : 2);
+        known = true;
+    }
+    if (all || strcmp(mode, "update") == 0) {
+        printf("== update: road changes, landmark repair vs rebuild ==\n");
+        bench_update(num_custom ? custom : update_sizes, num_custom ? num_custom : 2);
+        known = true;
+    }
+    if (all || strcmp(mode, "reorder") == 0) {
+        printf("== reorder: vertex order and search locality ==\n");
+        bench_reorder(num_custom ? custom : reorder_sizes, num_custom ? num_custom : 2);
+        known = true;
+    }
+    if (all || strcmp(mode, "dial") == 0) {
+        printf("== dial: heap vs bucket queue Dijkstra ==\n");
+        bench_dial(num_custom ? custom : dial_sizes, num_custom ? num_custom : 2);
+        known = true;
+    }
+    if (all || strcmp(mode, "delta") == 0) {
+        printf("== delta: sequential Dijkstra vs parallel delta-stepping ==\n");
+        bench_delta(num_custom ? custom : delta_sizes, num_custom ? num_custom : 2);
+        known = true;
+    }
+    if (all || strcmp(mode, "apsp") == 0) {
+        printf("== apsp: all-pairs table build and lookups ==\n");
+        bench_apsp(num_custom ? custom : apsp_sizes, num_custom ? num_custom : 3);
+        known = true;
+    }
+    if (all || strcmp(mode, "compact") == 0) {
+        printf("== compact: packed adjacency memory and query slowdown ==\n");
+        bench_compact(num_custom ? custom : compact_sizes, num_custom ? num_custom : 2);
+        known = true;
+    }
+    // The suite is long and writes its own report, so "all" leaves it out
+    if (strcmp(mode, "suite") == 0) {
+        printf("== suite: generator families, load, memory and per-engine latency ==\n");
+        bench_suite(num_custom ? custom : suite_sizes, num_custom ? num_custom : 4, family, seed, csv_file);
+        known = true;
+    }
+
+    free(custom);
+    if (!known) {
+        fprintf(stderr, "Usage: %s [heap|load|csr|workspace|bidir|astar|ch|batch|table|snapshot|parse|pload|cache|tree|update|reorder|dial|delta|apsp|compact|all|suite] [--seed n] [--csv file] [--family name] [vertices ...]\n", argv[0]);
+        return 1;
+    }
+    return 0;
+}
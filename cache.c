@@ -0,0 +1,264 @@
+/**
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * CS 5008
+ * Implementation of the LRU route cache
+ */
+
+#include "cache.h"
+#include <stdlib.h> // For malloc, calloc, free
+
+#define MIN_BUCKETS 16  // Smallest bucket array
+
+/**
+ * Bucket of the unordered pair (low, high)
+ */
+static int bucket_of(const RouteCache* cache, int low, int high) {
+    unsigned int hash = (unsigned int)low * 2654435761u ^ (unsigned int)high * 40503u;
+    hash ^= hash >> 16;
+    return (int)(hash & (unsigned int)(cache->num_buckets - 1));
+}
+
+/**
+ * Create a cache holding at most capacity answers
+ */
+RouteCache* route_cache_create(int capacity) {
+    if (capacity < 0) capacity = 0;
+    RouteCache* cache = (RouteCache*)calloc(1, sizeof(RouteCache));
+    cache->capacity = capacity;
+    cache->entries = (RouteCacheEntry*)malloc(sizeof(RouteCacheEntry) * (capacity > 0 ? capacity : 1));
+    cache->num_buckets = MIN_BUCKETS;
+    while (cache->num_buckets < capacity * 2) cache->num_buckets *= 2;
+    cache->buckets = (int*)malloc(sizeof(int) * cache->num_buckets);
+    for (int b = 0; b < cache->num_buckets; b++) {
+        cache->buckets[b] = -1;
+    }
+    cache->newest = -1;
+    cache->oldest = -1;
+    return cache;
+}
+
+/**
+ * Drop every entry (counters are kept)
+ */
+void route_cache_clear(RouteCache* cache) {
+    for (int i = 0; i < cache->size; i++) {
+        free(cache->entries[i].path);
+    }
+    for (int b = 0; b < cache->num_buckets; b++) {
+        cache->buckets[b] = -1;
+    }
+    cache->size = 0;
+    cache->newest = -1;
+    cache->oldest = -1;
+}
+
+/**
+ * Free the cache and every stored path
+ */
+void route_cache_destroy(RouteCache* cache) {
+    if (!cache) return;
+    route_cache_clear(cache);
+    free(cache->entries);
+    free(cache->buckets);
+    free(cache);
+}
+
+/**
+ * Take entry i out of the recency list
+ */
+static void unlink_recency(RouteCache* cache, int i) {
+    RouteCacheEntry* entry = &cache->entries[i];
+    if (entry->newer != -1) cache->entries[entry->newer].older = entry->older;
+    else cache->newest = entry->older;
+    if (entry->older != -1) cache->entries[entry->older].newer = entry->newer;
+    else cache->oldest = entry->newer;
+}
+
+/**
+ * Put entry i at the most recently used end
+ */
+static void push_newest(RouteCache* cache, int i) {
+    RouteCacheEntry* entry = &cache->entries[i];
+    entry->newer = -1;
+    entry->older = cache->newest;
+    if (cache->newest != -1) cache->entries[cache->newest].newer = i;
+    cache->newest = i;
+    if (cache->oldest == -1) cache->oldest = i;
+}
+
+/**
+ * Empty the cache if the graph changed since the entries were computed
+ */
+static void check_version(RouteCache* cache, const Graph* graph) {
+    if (cache->graph_version == graph->version) return;
+    if (cache->size > 0) cache->invalidations++;
+    route_cache_clear(cache);
+    cache->graph_version = graph->version;
+}
+
+/**
+ * Index of the entry for (low, high), or -1
+ */
+static int find_entry(const RouteCache* cache, int low, int high) {
+    for (int i = cache->buckets[bucket_of(cache, low, high)]; i != -1; i = cache->entries[i].chain) {
+        if (cache->entries[i].low == low && cache->entries[i].high == high) return i;
+    }
+    return -1;
+}
+
+/**
+ * Look up start -> end; on a hit *result gets its own copy of the path
+ */
+bool route_cache_lookup(RouteCache* cache, const Graph* graph, int start, int end, PathResult* result) {
+    if (cache->capacity == 0) return false;
+    check_version(cache, graph);
+
+    int low = start < end ? start : end;
+    int high = start < end ? end : start;
+    int i = find_entry(cache, low, high);
+    if (i == -1) {
+        cache->misses++;
+        return false;
+    }
+
+    cache->hits++;
+    unlink_recency(cache, i);
+    push_newest(cache, i);
+
+    const RouteCacheEntry* entry = &cache->entries[i];
+    result->found = entry->found;
+    result->total_distance = entry->total_distance;
+    result->path_length = entry->path_length;
+    result->settled = 0;  // Nothing was searched
+    result->path = NULL;
+    if (entry->path) {
+        result->path = (int*)malloc(sizeof(int) * entry->path_length);
+        // Stored low -> high; walk it backwards when asked from the high end
+        for (int k = 0; k < entry->path_length; k++) {
+            result->path[k] = start == low ? entry->path[k] : entry->path[entry->path_length - 1 - k];
+        }
+    }
+    return true;
+}
+
+/**
+ * Remove entry i from its hash bucket
+ */
+static void unlink_bucket(RouteCache* cache, int i) {
+    int* link = &cache->buckets[bucket_of(cache, cache->entries[i].low, cache->entries[i].high)];
+    while (*link != i) link = &cache->entries[*link].chain;
+    *link = cache->entries[i].chain;
+}
+
+/**
+ * Remember the answer for start -> end
+ */
+void route_cache_store(RouteCache* cache, const Graph* graph, int start, int end, const PathResult* result) {
+    if (cache->capacity == 0) return;
+    check_version(cache, graph);
+
+    int low = start < end ? start : end;
+    int high = start < end ? end : start;
+    if (find_entry(cache, low, high) != -1) return;  // Already known
+
+    // Use a fresh slot while there is room, otherwise recycle the oldest entry
+    int i;
+    if (cache->size < cache->capacity) {
+        i = cache->size++;
+    } else {
+        i = cache->oldest;
+        unlink_recency(cache, i);
+        unlink_bucket(cache, i);
+        free(cache->entries[i].path);
+        cache->evictions++;
+    }
+
+    RouteCacheEntry* entry = &cache->entries[i];
+    entry->low = low;
+    entry->high = high;
+    entry->found = result->found;
+    entry->total_distance = result->total_distance;
+    entry->path_length = result->path_length;
+    entry->path = NULL;
+    if (result->path) {
+        entry->path = (int*)malloc(sizeof(int) * result->path_length);
+        for (int k = 0; k < result->path_length; k++) {
+            entry->path[k] = start == low ? result->path[k] : result->path[result->path_length - 1 - k];
+        }
+    }
+
+    int bucket = bucket_of(cache, low, high);
+    entry->chain = cache->buckets[bucket];
+    cache->buckets[bucket] = i;
+    push_newest(cache, i);
+}
+
+/**
+ * Remove entry i, moving the last entry into its slot so entries stay dense
+ */
+static void remove_entry(RouteCache* cache, int i) {
+    unlink_recency(cache, i);
+    unlink_bucket(cache, i);
+    free(cache->entries[i].path);
+
+    int last = --cache->size;
+    if (i == last) return;
+    RouteCacheEntry* moved = &cache->entries[i];
+    *moved = cache->entries[last];
+
+    // Point the moved entry's neighbours and bucket at its new slot
+    if (moved->newer != -1) cache->entries[moved->newer].older = i;
+    else cache->newest = i;
+    if (moved->older != -1) cache->entries[moved->older].newer = i;
+    else cache->oldest = i;
+    int* link = &cache->buckets[bucket_of(cache, moved->low, moved->high)];
+    while (*link != last) link = &cache->entries[*link].chain;
+    *link = i;
+}
+
+/**
+ * Check whether a cached path drives along the road a - b (in either direction)
+ */
+static bool path_uses_road(const RouteCacheEntry* entry, int a, int b) {
+    for (int k = 0; k + 1 < entry->path_length; k++) {
+        int x = entry->path[k];
+        int y = entry->path[k + 1];
+        if ((x == a && y == b) || (x == b && y == a)) return true;
+    }
+    return false;
+}
+
+/**
+ * Bring the cache up to date after one road change
+ * A shorter or new road could beat any cached answer, so the cache is
+ * emptied; a longer or closed one only affects the answers through it.
+ */
+void route_cache_repair(RouteCache* cache, const Graph* graph, const RoadChange* change) {
+    // Entries older than the change before this one cannot be repaired
+    if (cache->graph_version + 1 != graph->version || !graph_change_lengthens(change)) {
+        check_version(cache, graph);
+        return;
+    }
+    cache->graph_version = graph->version;
+
+    // Backwards, so the entry moved into a freed slot has already been checked
+    for (int i = cache->size - 1; i >= 0; i--) {
+        if (path_uses_road(&cache->entries[i], change->from, change->to)) {
+            remove_entry(cache, i);
+            cache->repairs++;
+        }
+    }
+}
+
+/**
+ * Print the counters
+ */
+void route_cache_print_stats(const RouteCache* cache, FILE* out) {
+    long lookups = cache->hits + cache->misses;
+    fprintf(out, "Cache: %d/%d entries\n", cache->size, cache->capacity);
+    fprintf(out, "\tHits: %ld, Misses: %ld, Hit Rate: %.1f%%\n", cache->hits, cache->misses,
+            lookups > 0 ? 100.0 * cache->hits / lookups : 0.0);
+    fprintf(out, "\tEvictions: %ld, Invalidations: %ld, Repairs: %ld\n", cache->evictions,
+            cache->invalidations, cache->repairs);
+}
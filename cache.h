@@ -0,0 +1,72 @@
+/**
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * CS 5008
+ * Bounded LRU cache of route answers
+ *
+ * Roads are two-way, so (a, b) and (b, a) share one entry keyed on
+ * (min, max); a hit in the other direction returns the path reversed.
+ * Every entry belongs to one version of the graph, and any change to the
+ * graph (see Graph.version) empties the cache on the next lookup, unless
+ * the change is passed to route_cache_repair first. When a road is only
+ * lengthened or closed, answers that avoid it are still shortest, so just
+ * the answers through that road are dropped.
+ */
+
+#ifndef CACHE_H
+#define CACHE_H
+
+#include "graph.h"
+#include "dijkstra.h"
+#include <stdbool.h>
+#include <stdio.h>
+
+#define DEFAULT_CACHE_ENTRIES 1024  // Entries kept when the caller has no preference
+
+// One cached answer, stored from low to high
+typedef struct RouteCacheEntry {
+    int low;             // Smaller vertex index of the pair
+    int high;            // Larger vertex index of the pair
+    bool found;
+    int total_distance;
+    int* path;           // low -> high, NULL when not found
+    int path_length;
+    int chain;           // Next entry in the same hash bucket, -1 = end
+    int newer;           // Neighbours in recency order, -1 = none
+    int older;
+} RouteCacheEntry;
+
+typedef struct RouteCache {
+    int capacity;            // Maximum number of entries (0 disables the cache)
+    int size;                // Entries in use
+    RouteCacheEntry* entries;
+    int* buckets;            // Hash buckets holding the first entry index, -1 = empty
+    int num_buckets;         // Power of two, at least twice the capacity
+    int newest;              // Most recently used entry, -1 if empty
+    int oldest;              // Least recently used entry (next to evict)
+    unsigned int graph_version; // Graph version the entries were computed on
+    long hits;
+    long misses;
+    long evictions;
+    long invalidations;      // Times the cache was emptied because the graph changed
+    long repairs;            // Entries dropped one by one because a road on their path got longer
+} RouteCache;
+
+// Cache operations
+RouteCache* route_cache_create(int capacity);
+void route_cache_destroy(RouteCache* cache);
+void route_cache_clear(RouteCache* cache);
+
+// Copy a cached answer for start -> end into *result; false on a miss
+bool route_cache_lookup(RouteCache* cache, const Graph* graph, int start, int end, PathResult* result);
+
+// Remember the answer for start -> end, evicting the least recently used entry if full
+void route_cache_store(RouteCache* cache, const Graph* graph, int start, int end, const PathResult* result);
+
+// Bring the cache up to date after one road change (call right after the change)
+void route_cache_repair(RouteCache* cache, const Graph* graph, const RoadChange* change);
+
+// Print the counters
+void route_cache_print_stats(const RouteCache* cache, FILE* out);
+
+#endif
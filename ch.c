@@ -0,0 +1,438 @@
+/**
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * CS 5008
+ * Implementation of Contraction Hierarchies
+ */
+
+#define _POSIX_C_SOURCE 200809L // For clock_gettime
+
+#include "ch.h"
+#include "heap.h"
+#include <limits.h> // For INT_MAX
+#include <stdlib.h> // For malloc, realloc, free
+#include <time.h>   // For clock_gettime
+
+#define INFINITY_DIST INT_MAX
+#define SIMULATE_SETTLE_LIMIT 50  // Witness search budget when only estimating importance
+#define CONTRACT_SETTLE_LIMIT 500 // Witness search budget when adding real shortcuts
+
+// Edge of the overlay graph used while contracting
+typedef struct OverlayEdge {
+    int dest;    // Neighbour
+    int weight;  // Length (road or shortcut)
+    int middle;  // Bypassed vertex for shortcuts, -1 for roads
+} OverlayEdge;
+
+// Growable edge list of one overlay vertex
+typedef struct OverlayList {
+    OverlayEdge* edges;
+    int count;
+    int capacity;
+} OverlayList;
+
+// Scratch state for the bounded witness searches
+typedef struct Witness {
+    int* dist;             // Tentative distance from the search source
+    unsigned int* stamp;   // Generation in which dist was written
+    unsigned int generation;
+    PriorityQueue* pq;
+} Witness;
+
+/**
+ * Add or shorten the edge u -> v in the overlay
+ */
+static void overlay_link(OverlayList* lists, int u, int v, int weight, int middle) {
+    OverlayList* list = &lists[u];
+
+    // Keep a single edge per neighbour, the shortest one
+    for (int i = 0; i < list->count; i++) {
+        if (list->edges[i].dest == v) {
+            if (weight < list->edges[i].weight) {
+                list->edges[i].weight = weight;
+                list->edges[i].middle = middle;
+            }
+            return;
+        }
+    }
+
+    if (list->count == list->capacity) {
+        list->capacity = list->capacity ? list->capacity * 2 : 4;
+        list->edges = (OverlayEdge*)realloc(list->edges, sizeof(OverlayEdge) * list->capacity);
+    }
+    list->edges[list->count].dest = v;
+    list->edges[list->count].weight = weight;
+    list->edges[list->count].middle = middle;
+    list->count++;
+}
+
+/**
+ * Remove the edge u -> v from the overlay (order of u's list is not kept)
+ */
+static void overlay_unlink(OverlayList* lists, int u, int v) {
+    OverlayList* list = &lists[u];
+    for (int i = 0; i < list->count; i++) {
+        if (list->edges[i].dest == v) {
+            list->edges[i] = list->edges[--list->count];
+            return;
+        }
+    }
+}
+
+/**
+ * Bounded Dijkstra from source over the remaining overlay, never entering excluded
+ * Stops past max_dist or after settle_limit settled vertices
+ */
+static void witness_search(const OverlayList* lists, Witness* witness, int source, int excluded,
+                           int max_dist, int settle_limit) {
+    pq_clear(witness->pq);
+    witness->generation++;
+    unsigned int gen = witness->generation;
+
+    witness->stamp[source] = gen;
+    witness->dist[source] = 0;
+    pq_push(witness->pq, source, 0);
+
+    int settled = 0;
+    while (!pq_is_empty(witness->pq) && settled < settle_limit) {
+        int du;
+        int u = pq_pop(witness->pq, &du);
+        if (du > max_dist) break;
+        settled++;
+
+        for (int i = 0; i < lists[u].count; i++) {
+            const OverlayEdge* edge = &lists[u].edges[i];
+            int v = edge->dest;
+            if (v == excluded) continue;
+
+            int new_dist = du + edge->weight;
+            if (witness->stamp[v] != gen || new_dist < witness->dist[v]) {
+                witness->stamp[v] = gen;
+                witness->dist[v] = new_dist;
+                pq_push(witness->pq, v, new_dist);
+            }
+        }
+    }
+}
+
+/**
+ * Contract v (or only count the shortcuts it would need when simulate is true)
+ * The overlay only holds uncontracted vertices, so every neighbour of v is live
+ * Returns the number of shortcuts
+ */
+static int contract(OverlayList* lists, Witness* witness, int v, bool simulate) {
+    OverlayList* list = &lists[v];
+    int shortcuts = 0;
+    int settle_limit = simulate ? SIMULATE_SETTLE_LIMIT : CONTRACT_SETTLE_LIMIT;
+
+    for (int i = 0; i < list->count; i++) {
+        int u = list->edges[i].dest;
+        int wu = list->edges[i].weight;
+
+        if (i + 1 >= list->count) continue;  // No later neighbours to pair with
+
+        // Longest path through v that a witness would have to beat (0 over zero-length roads)
+        int max_dist = 0;
+        for (int j = i + 1; j < list->count; j++) {
+            if (wu + list->edges[j].weight > max_dist) max_dist = wu + list->edges[j].weight;
+        }
+
+        witness_search(lists, witness, u, v, max_dist, settle_limit);
+
+        // Pairs (u, w) with w after u in the list, so each pair is handled once
+        for (int j = i + 1; j < list->count; j++) {
+            int w = list->edges[j].dest;
+            int via = wu + list->edges[j].weight;
+            bool witnessed = witness->stamp[w] == witness->generation && witness->dist[w] <= via;
+            if (witnessed) continue;
+
+            shortcuts++;
+            if (!simulate) {
+                overlay_link(lists, u, w, via, v);
+                overlay_link(lists, w, u, via, v);
+            }
+        }
+    }
+
+    return shortcuts;
+}
+
+/**
+ * Importance of v: edge difference plus already contracted neighbours
+ * Low values are contracted first
+ */
+static int priority(OverlayList* lists, const int* deleted_neighbours, Witness* witness, int v) {
+    int shortcuts = contract(lists, witness, v, true);
+    return shortcuts - lists[v].count + deleted_neighbours[v];
+}
+
+/**
+ * Preprocess a graph into a contraction hierarchy (freezes the graph)
+ */
+ContractionHierarchy* ch_build(Graph* graph) {
+    struct timespec begin, finish;
+    clock_gettime(CLOCK_MONOTONIC, &begin);
+    int n = graph->num_vertices;
+    int slots = n > 0 ? n : 1;
+
+    // Overlay starts as a copy of the roads (no self loops, shortest parallel road)
+    // (read from the frozen layout, which is all a snapshot graph has)
+    const CsrGraph* csr = graph_freeze(graph);
+    OverlayList* lists = (OverlayList*)calloc(slots, sizeof(OverlayList));
+    for (int u = 0; u < n; u++) {
+        for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++) {
+            if (csr->dest[e] != u) overlay_link(lists, u, csr->dest[e], csr->weight[e], -1);
+        }
+    }
+
+    int* deleted_neighbours = (int*)calloc(slots, sizeof(int));
+    Witness witness;
+    witness.dist = (int*)malloc(sizeof(int) * slots);
+    witness.stamp = (unsigned int*)calloc(slots, sizeof(unsigned int));
+    witness.generation = 0;
+    witness.pq = pq_create(n);
+
+    // Initial importance of every vertex
+    PriorityQueue* order = pq_create(n);
+    for (int v = 0; v < n; v++) {
+        pq_push(order, v, priority(lists, deleted_neighbours, &witness, v));
+    }
+
+    ContractionHierarchy* ch = (ContractionHierarchy*)malloc(sizeof(ContractionHierarchy));
+    ch->num_vertices = n;
+    ch->rank = (int*)malloc(sizeof(int) * slots);
+
+    int next_rank = 0;
+    while (!pq_is_empty(order)) {
+        int v = pq_pop(order, NULL);
+
+        // Lazy update: importance may have grown since v was queued
+        int current = priority(lists, deleted_neighbours, &witness, v);
+        if (!pq_is_empty(order) && current > pq_min_key(order)) {
+            pq_push(order, v, current);
+            continue;
+        }
+
+        // Add shortcuts, then take v out of its neighbours' lists
+        // (v keeps its own list: exactly its edges to higher-ranked vertices)
+        contract(lists, &witness, v, false);
+        ch->rank[v] = next_rank++;
+        for (int i = 0; i < lists[v].count; i++) {
+            int u = lists[v].edges[i].dest;
+            overlay_unlink(lists, u, v);
+            deleted_neighbours[u]++;
+        }
+    }
+
+    // Keep only the edges that climb the hierarchy, in CSR form
+    ch->up.num_vertices = n;
+    ch->up.offsets = (int*)malloc(sizeof(int) * (n + 1));
+    int total = 0;
+    for (int v = 0; v < n; v++) {
+        ch->up.offsets[v] = total;
+        for (int i = 0; i < lists[v].count; i++) {
+            if (ch->rank[lists[v].edges[i].dest] > ch->rank[v]) total++;
+        }
+    }
+    ch->up.offsets[n] = total;
+    ch->up.num_edges = total;
+    ch->up.dest = (int*)malloc(sizeof(int) * (total > 0 ? total : 1));
+    ch->up.weight = (int*)malloc(sizeof(int) * (total > 0 ? total : 1));
+    ch->middle = (int*)malloc(sizeof(int) * (total > 0 ? total : 1));
+    ch->up.max_weight = 0;
+    ch->up.min_weight = 0;
+    ch->num_shortcuts = 0;
+
+    for (int v = 0; v < n; v++) {
+        int e = ch->up.offsets[v];
+        for (int i = 0; i < lists[v].count; i++) {
+            const OverlayEdge* edge = &lists[v].edges[i];
+            if (ch->rank[edge->dest] <= ch->rank[v]) continue;
+            ch->up.dest[e] = edge->dest;
+            ch->up.weight[e] = edge->weight;
+            if (edge->weight > ch->up.max_weight) ch->up.max_weight = edge->weight;
+            if (edge->weight < ch->up.min_weight) ch->up.min_weight = edge->weight;
+            ch->middle[e] = edge->middle;
+            if (edge->middle != -1) ch->num_shortcuts++;
+            e++;
+        }
+    }
+
+    // Clean up contraction state
+    for (int v = 0; v < n; v++) {
+        free(lists[v].edges);
+    }
+    free(lists);
+    free(deleted_neighbours);
+    free(witness.dist);
+    free(witness.stamp);
+    pq_destroy(witness.pq);
+    pq_destroy(order);
+
+    clock_gettime(CLOCK_MONOTONIC, &finish);
+    ch->preprocess_seconds = (finish.tv_sec - begin.tv_sec) + (finish.tv_nsec - begin.tv_nsec) / 1e9;
+    return ch;
+}
+
+/**
+ * Free a hierarchy
+ */
+void ch_destroy(ContractionHierarchy* ch) {
+    if (!ch) return;
+    free(ch->rank);
+    free(ch->up.offsets);
+    free(ch->up.dest);
+    free(ch->up.weight);
+    free(ch->middle);
+    free(ch);
+}
+
+/**
+ * Index of the up edge joining a and b (stored at the lower-ranked end), -1 if none
+ */
+static int find_up_edge(const ContractionHierarchy* ch, int a, int b) {
+    int low = ch->rank[a] < ch->rank[b] ? a : b;
+    int high = low == a ? b : a;
+    int best = -1;
+    for (int e = ch->up.offsets[low]; e < ch->up.offsets[low + 1]; e++) {
+        if (ch->up.dest[e] == high && (best == -1 || ch->up.weight[e] < ch->up.weight[best])) best = e;
+    }
+    return best;
+}
+
+/**
+ * Append the original vertices of edge a -> b (excluding a) to path
+ */
+static void unpack_edge(const ContractionHierarchy* ch, int a, int b, int* path, int* length) {
+    int e = find_up_edge(ch, a, b);
+    int m = ch->middle[e];
+    if (m == -1) {
+        path[(*length)++] = b;  // A real road
+        return;
+    }
+    unpack_edge(ch, a, m, path, length);
+    unpack_edge(ch, m, b, path, length);
+}
+
+/**
+ * Number of original roads an edge a -> b stands for
+ */
+static int count_roads(const ContractionHierarchy* ch, int a, int b) {
+    int m = ch->middle[find_up_edge(ch, a, b)];
+    return m == -1 ? 1 : count_roads(ch, a, m) + count_roads(ch, m, b);
+}
+
+/**
+ * Settle one vertex on one side of the upward search, tracking the best meeting
+ */
+static void settle_upward(const ContractionHierarchy* ch, DijkstraWorkspace* ws,
+                          const DijkstraWorkspace* other, int* best, int* meet) {
+    int du;
+    int u = pq_pop(ws->pq, &du);
+    unsigned int gen = ws->generation;
+    ws->settled[u] = gen;
+    ws->settled_count++;
+
+    // Both searches reach u: candidate path through the top vertex u
+    if (other->reached[u] == other->generation && du + other->dist[u] < *best) {
+        *best = du + other->dist[u];
+        *meet = u;
+    }
+
+    for (int e = ch->up.offsets[u]; e < ch->up.offsets[u + 1]; e++) {
+        int v = ch->up.dest[e];
+        int new_dist = du + ch->up.weight[e];
+        if (ws->settled[v] == gen) continue;
+        if (ws->reached[v] != gen || new_dist < ws->dist[v]) {
+            ws->reached[v] = gen;
+            ws->dist[v] = new_dist;
+            ws->parent[v] = u;
+            pq_push(ws->pq, v, new_dist);
+        }
+    }
+}
+
+/**
+ * Contraction hierarchy query reusing two workspaces
+ * Each side only follows up edges and stops once its frontier is no
+ * closer than the best meeting vertex found so far.
+ */
+PathResult ch_shortest_path_ws(const ContractionHierarchy* ch, DijkstraWorkspace* forward,
+                               DijkstraWorkspace* backward, int start, int end) {
+    int n = ch->num_vertices;
+    DijkstraWorkspace* sides[2] = {forward, backward};
+    int sources[2] = {start, end};
+    for (int k = 0; k < 2; k++) {
+        dijkstra_workspace_reset(sides[k], n);
+        sides[k]->reached[sources[k]] = sides[k]->generation;
+        sides[k]->dist[sources[k]] = 0;
+        sides[k]->parent[sources[k]] = -1;
+        pq_push(sides[k]->pq, sources[k], 0);
+    }
+
+    int best = INFINITY_DIST;  // Shortest start -> top -> end seen so far
+    int meet = -1;             // Top vertex of that path
+
+    while (true) {
+        bool forward_open = !pq_is_empty(forward->pq) && pq_min_key(forward->pq) < best;
+        bool backward_open = !pq_is_empty(backward->pq) && pq_min_key(backward->pq) < best;
+        if (!forward_open && !backward_open) break;
+
+        // Alternate by the smaller frontier key among the sides still worth expanding
+        if (forward_open && (!backward_open || pq_min_key(forward->pq) <= pq_min_key(backward->pq))) {
+            settle_upward(ch, forward, backward, &best, &meet);
+        } else {
+            settle_upward(ch, backward, forward, &best, &meet);
+        }
+    }
+
+    PathResult result;
+    result.path = NULL;
+    result.path_length = 0;
+    result.total_distance = 0;
+    result.found = false;
+    result.settled = forward->settled_count + backward->settled_count;
+    if (meet == -1) return result;
+
+    result.found = true;
+    result.total_distance = best;
+
+    // Hierarchy path: start .. meet .. end, still containing shortcuts
+    int up_hops = 0;
+    int hops = 0;
+    for (int v = meet; v != -1; v = forward->parent[v]) up_hops++;
+    for (int v = backward->parent[meet]; v != -1; v = backward->parent[v]) hops++;
+    hops += up_hops;
+    int* top_path = (int*)malloc(sizeof(int) * hops);
+    int i = up_hops;
+    for (int v = meet; v != -1; v = forward->parent[v]) top_path[--i] = v;  // start .. meet
+    i = up_hops;
+    for (int v = backward->parent[meet]; v != -1; v = backward->parent[v]) top_path[i++] = v;  // .. end
+
+    // Unpack every hierarchy edge into the roads it stands for
+    int length = 1;
+    for (int k = 0; k + 1 < hops; k++) {
+        length += count_roads(ch, top_path[k], top_path[k + 1]);
+    }
+    result.path = (int*)malloc(sizeof(int) * length);
+    result.path[0] = start;
+    result.path_length = 1;
+    for (int k = 0; k + 1 < hops; k++) {
+        unpack_edge(ch, top_path[k], top_path[k + 1], result.path, &result.path_length);
+    }
+    free(top_path);
+
+    return result;
+}
+
+/**
+ * Contraction hierarchy query with one-off workspaces
+ */
+PathResult ch_shortest_path(const ContractionHierarchy* ch, int start, int end) {
+    DijkstraWorkspace* forward = dijkstra_workspace_create(ch->num_vertices);
+    DijkstraWorkspace* backward = dijkstra_workspace_create(ch->num_vertices);
+    PathResult result = ch_shortest_path_ws(ch, forward, backward, start, end);
+    dijkstra_workspace_destroy(forward);
+    dijkstra_workspace_destroy(backward);
+    return result;
+}
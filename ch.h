@@ -0,0 +1,39 @@
+/**
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * CS 5008
+ * Contraction Hierarchies - preprocessing and point-to-point queries
+ *
+ * Vertices are contracted one at a time (least important first). When a
+ * vertex is removed, shortcuts are added between its neighbours wherever it
+ * was on the only shortest path. A query then runs a bidirectional search
+ * that only climbs to higher-ranked vertices, and shortcuts are unpacked
+ * back into the original cities afterwards.
+ */
+
+#ifndef CH_H
+#define CH_H
+
+#include "graph.h"
+#include "dijkstra.h"
+
+// Preprocessed hierarchy for one (read-only) graph
+typedef struct ContractionHierarchy {
+    int num_vertices;        // Vertices in the source graph
+    int* rank;               // Contraction order of each vertex (0 = contracted first)
+    CsrGraph up;             // Edges from each vertex to higher-ranked neighbours
+    int* middle;             // Per up edge: contracted vertex a shortcut bypasses, -1 for a road
+    int num_shortcuts;       // Up edges that are shortcuts
+    double preprocess_seconds; // Wall time spent in ch_build
+} ContractionHierarchy;
+
+// Hierarchy operations
+ContractionHierarchy* ch_build(Graph* graph);
+void ch_destroy(ContractionHierarchy* ch);
+
+// Queries; the path in the result is fully unpacked into original vertices
+PathResult ch_shortest_path(const ContractionHierarchy* ch, int start, int end);
+PathResult ch_shortest_path_ws(const ContractionHierarchy* ch, DijkstraWorkspace* forward,
+                               DijkstraWorkspace* backward, int start, int end);
+
+#endif
@@ -0,0 +1,234 @@
+/**
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * CS 5008
+ * Implementation of the compressed adjacency
+ */
+
+#include "compact.h"
+#include <stdio.h>  // For fprintf
+#include <stdlib.h> // For malloc, realloc, qsort, free
+
+// One neighbour while a vertex's list is being sorted
+typedef struct CompactEdge {
+    int dest;
+    int weight;
+} CompactEdge;
+
+/**
+ * Order neighbours by destination index
+ */
+static int compare_edges(const void* a, const void* b) {
+    int x = ((const CompactEdge*)a)->dest;
+    int y = ((const CompactEdge*)b)->dest;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Map signed values to unsigned so small magnitudes stay small: 0, -1, 1, -2 -> 0, 1, 2, 3
+ */
+static inline uint32_t zigzag_encode(int value) {
+    return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+static inline int zigzag_decode(uint32_t value) {
+    return (int)(value >> 1) ^ -(int)(value & 1);
+}
+
+/**
+ * Append a varint to the stream at *size, growing it as needed
+ */
+static void put_varint(uint8_t** data, size_t* size, size_t* capacity, uint32_t value) {
+    if (*size + 5 > *capacity) {  // A 32-bit varint takes at most 5 bytes
+        *capacity = *capacity * 2 + 5;
+        *data = (uint8_t*)realloc(*data, *capacity);
+    }
+    while (value >= 0x80) {
+        (*data)[(*size)++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    (*data)[(*size)++] = (uint8_t)value;
+}
+
+/**
+ * Read a varint and advance the cursor past it
+ */
+static inline uint32_t get_varint(const uint8_t** cursor) {
+    const uint8_t* p = *cursor;
+    uint32_t value = *p & 0x7f;
+    for (int shift = 7; *p++ & 0x80; shift += 7) {
+        value |= (uint32_t)(*p & 0x7f) << shift;
+    }
+    *cursor = p;
+    return value;
+}
+
+/**
+ * Pack every vertex's edges, sorted by destination, into one byte stream
+ * Read from the CSR: a snapshot graph has no adjacency lists.
+ */
+CompactGraph* compact_build(Graph* graph) {
+    const CsrGraph* csr = graph_freeze(graph);
+    int n = graph->num_vertices;
+    CompactGraph* compact = (CompactGraph*)malloc(sizeof(CompactGraph));
+    compact->num_vertices = n;
+    compact->num_edges = csr->num_edges;
+    compact->offsets = (uint32_t*)malloc(sizeof(uint32_t) * (n + 1));
+
+    size_t size = 0;
+    size_t capacity = 1024;
+    uint8_t* data = (uint8_t*)malloc(capacity);
+    CompactEdge* edges = NULL;
+    int edges_capacity = 0;
+    for (int u = 0; u < n; u++) {
+        compact->offsets[u] = (uint32_t)size;  // Checked once at the end: sizes only grow
+
+        int degree = csr->offsets[u + 1] - csr->offsets[u];
+        if (degree > edges_capacity) {
+            edges_capacity = degree > 2 * edges_capacity ? degree : 2 * edges_capacity;
+            edges = (CompactEdge*)realloc(edges, sizeof(CompactEdge) * edges_capacity);
+        }
+        for (int i = 0; i < degree; i++) {
+            edges[i].dest = csr->dest[csr->offsets[u] + i];
+            edges[i].weight = csr->weight[csr->offsets[u] + i];
+        }
+        qsort(edges, degree, sizeof(CompactEdge), compare_edges);
+
+        int previous = u;
+        for (int i = 0; i < degree; i++) {
+            uint32_t gap = i == 0 ? zigzag_encode(edges[i].dest - u) : (uint32_t)(edges[i].dest - previous);
+            put_varint(&data, &size, &capacity, gap);
+            put_varint(&data, &size, &capacity, zigzag_encode(edges[i].weight));
+            previous = edges[i].dest;
+        }
+    }
+    free(edges);
+    if (size > UINT32_MAX) {
+        fprintf(stderr, "Error: Compressed adjacency does not fit 32-bit offsets\n");
+        free(data);
+        free(compact->offsets);
+        free(compact);
+        return NULL;
+    }
+    compact->offsets[n] = (uint32_t)size;
+
+    compact->data = (uint8_t*)realloc(data, size > 0 ? size : 1);  // Give back the growth slack
+    compact->data_bytes = size;
+    return compact;
+}
+
+/**
+ * Free the packed adjacency
+ */
+void compact_destroy(CompactGraph* compact) {
+    if (!compact) return;
+    free(compact->offsets);
+    free(compact->data);
+    free(compact);
+}
+
+/**
+ * Pack the graph, then drop the lists and CSR it replaces
+ * Nothing rebuilds the CSR while searches go through the packed copy; a
+ * road change restores the lists first, and the caller drops the copy then.
+ */
+CompactGraph* compact_replace_edges(Graph* graph) {
+    CompactGraph* compact = compact_build(graph);
+    if (compact) graph_release_edges(graph);
+    return compact;
+}
+
+/**
+ * Relink every packed road into the graph's adjacency lists
+ * Each road is stored in both directions, so it is added once, from its
+ * lower-indexed end. The roads are the ones the graph had, so its version
+ * (and every cached answer) stays valid.
+ */
+void compact_restore_edges(const CompactGraph* compact, Graph* graph) {
+    if (graph_is_read_only(graph)) return;  // A snapshot kept its CSR
+    unsigned int version = graph->version;
+    for (int u = 0; u < compact->num_vertices; u++) {
+        const uint8_t* cursor = compact->data + compact->offsets[u];
+        const uint8_t* stop = compact->data + compact->offsets[u + 1];
+        int v = u;
+        bool first = true;
+        while (cursor < stop) {
+            uint32_t gap = get_varint(&cursor);
+            v = first ? u + zigzag_decode(gap) : v + (int)gap;
+            first = false;
+            int weight = zigzag_decode(get_varint(&cursor));
+            if (v >= u) graph_append_edge_index(graph, u, v, weight);
+        }
+    }
+    graph->version = version;
+}
+
+/**
+ * Bytes held by the packed adjacency
+ */
+size_t compact_bytes(const CompactGraph* compact) {
+    return sizeof(CompactGraph) + sizeof(uint32_t) * ((size_t)compact->num_vertices + 1) + compact->data_bytes;
+}
+
+/**
+ * Decode the neighbours of u in index order
+ */
+int compact_neighbours(const CompactGraph* compact, int u, int* dest, int* weight) {
+    const uint8_t* cursor = compact->data + compact->offsets[u];
+    const uint8_t* stop = compact->data + compact->offsets[u + 1];
+    int degree = 0;
+    int v = u;
+    while (cursor < stop) {
+        uint32_t gap = get_varint(&cursor);
+        v = degree == 0 ? u + zigzag_decode(gap) : v + (int)gap;
+        dest[degree] = v;
+        weight[degree] = zigzag_decode(get_varint(&cursor));
+        degree++;
+    }
+    return degree;
+}
+
+/**
+ * Dijkstra's shortest path algorithm over the packed adjacency
+ * Same search as dijkstra_shortest_path_ws; each settled vertex's edges are
+ * decoded straight from the stream into relaxations.
+ */
+PathResult compact_shortest_path(const CompactGraph* compact, DijkstraWorkspace* ws, int start, int end) {
+    dijkstra_workspace_reset(ws, compact->num_vertices);
+    unsigned int gen = ws->generation;
+    PROFILE_COUNT(ws->counters.searches, 1);
+    ws->reached[start] = gen;
+    ws->dist[start] = 0;
+    ws->parent[start] = -1;
+    pq_push(ws->pq, start, 0);
+
+    while (ws->settled[end] != gen && !pq_is_empty(ws->pq)) {
+        int du;
+        int u = pq_pop(ws->pq, &du);
+        ws->settled[u] = gen;
+        ws->settled_count++;
+        PROFILE_COUNT(ws->counters.settled, 1);
+
+        const uint8_t* cursor = compact->data + compact->offsets[u];
+        const uint8_t* stop = compact->data + compact->offsets[u + 1];
+        int v = u;
+        bool first = true;
+        while (cursor < stop) {
+            uint32_t gap = get_varint(&cursor);
+            v = first ? u + zigzag_decode(gap) : v + (int)gap;
+            first = false;
+            int new_dist = du + zigzag_decode(get_varint(&cursor));
+            PROFILE_COUNT(ws->counters.relaxed, 1);
+            if (ws->settled[v] == gen) continue;  // Already final
+            if (ws->reached[v] != gen || new_dist < ws->dist[v]) {
+                PROFILE_COUNT(ws->counters.heap_pushes, 1);
+                ws->reached[v] = gen;
+                ws->dist[v] = new_dist;
+                ws->parent[v] = u;
+                pq_push(ws->pq, v, new_dist);
+            }
+        }
+    }
+
+    return dijkstra_workspace_result(ws, end);
+}
@@ -0,0 +1,59 @@
+/**
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * CS 5008
+ * Compressed read-only adjacency for memory-constrained deployments
+ *
+ * Each vertex's neighbours are sorted by index and written to one byte
+ * stream as varints (7 bits per byte, high bit set while more follow):
+ * the first destination as a zigzag offset from the vertex itself, every
+ * later one as the gap from the previous, each followed by its road length.
+ * After a locality reordering (see reorder.h) most gaps and lengths fit in
+ * one or two bytes, against 8 bytes per edge in the CSR and 16 plus list
+ * overhead in an EdgeNode. Searches decode the stream as they go.
+ *
+ * compact_replace_edges frees the lists and the CSR, so the packed copy is
+ * then the only one; a road change puts the lists back first.
+ */
+
+#ifndef COMPACT_H
+#define COMPACT_H
+
+#include "graph.h"
+#include "dijkstra.h"
+#include <stddef.h>
+#include <stdint.h>
+
+// Packed adjacency of a whole graph
+typedef struct CompactGraph {
+    int num_vertices;
+    int num_edges;       // Directed edges (each road is stored twice)
+    uint32_t* offsets;   // Edges of vertex u are data[offsets[u], offsets[u + 1])
+    uint8_t* data;       // Varint destinations and lengths, neighbours in index order
+    size_t data_bytes;
+} CompactGraph;
+
+// Pack the graph's roads, read from its CSR (freezes the graph, so snapshots
+// work too); NULL if the stream would pass 4 GB (offsets are 32-bit)
+CompactGraph* compact_build(Graph* graph);
+void compact_destroy(CompactGraph* compact);
+
+// Pack the graph, then free its adjacency lists and CSR (a snapshot keeps its
+// mapped CSR); NULL and nothing freed on failure
+CompactGraph* compact_replace_edges(Graph* graph);
+
+// Add the packed roads back to a graph whose edges were released, before a
+// road change; the packed copy is stale once the roads change
+void compact_restore_edges(const CompactGraph* compact, Graph* graph);
+
+// Bytes held by the packed adjacency (offsets, stream and header); after
+// compact_replace_edges the graph's own stats no longer count any edges
+size_t compact_bytes(const CompactGraph* compact);
+
+// Decode the neighbours of u into dest/weight (each sized for its degree); returns the degree
+int compact_neighbours(const CompactGraph* compact, int u, int* dest, int* weight);
+
+// Dijkstra over the packed adjacency, decoding edges as vertices are settled
+PathResult compact_shortest_path(const CompactGraph* compact, DijkstraWorkspace* ws, int start, int end);
+
+#endif
@@ -0,0 +1,294 @@
+/**
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * CS 5008
+ * Implementation of parallel delta-stepping on POSIX threads
+ */
+
+#define _POSIX_C_SOURCE 200809L  // For pthread_barrier_t
+
+#include "delta.h"
+#include "dijkstra.h"   // Sequential fallback
+#include <limits.h>     // For INT_MAX
+#include <pthread.h>    // For pthread_create, pthread_barrier_wait
+#include <stdatomic.h>  // For atomic_compare_exchange_weak, atomic_fetch_add
+#include <stdint.h>     // For uint64_t, uint32_t
+#include <stdlib.h>     // For malloc, realloc, free
+#include <string.h>     // For memset
+
+#define DELTA_CHUNK 64            // Frontier vertices claimed per grab
+#define NO_BUCKET INT_MAX         // No bucket left to settle
+#define UNREACHED UINT64_MAX      // Label of a vertex no road has reached yet
+#define NO_PARENT UINT32_MAX      // Parent half of the source's label
+
+// A label packs the tentative distance into the high 32 bits and the parent
+// into the low 32, so one atomic minimum keeps the shorter distance and,
+// between equal distances, the lower-numbered parent.
+typedef _Atomic uint64_t DeltaLabel;
+
+// Vertices one worker has improved into one bucket
+typedef struct DeltaBucket {
+    int* items;
+    int count;
+    int capacity;
+} DeltaBucket;
+
+typedef struct DeltaJob DeltaJob;
+
+// One worker thread and the buckets it fills
+typedef struct DeltaWorker {
+    DeltaJob* job;
+    DeltaBucket* buckets; // Indexed by bucket number (distance / delta)
+    int num_buckets;
+    pthread_t thread;
+} DeltaWorker;
+
+// State shared by every worker of one run
+struct DeltaJob {
+    const CsrGraph* csr;
+    int delta;                 // Bucket width
+    DeltaLabel* labels;        // Distance and parent of each vertex
+    atomic_uint* stamp;        // Round in which each vertex last joined the frontier
+    int* frontier;             // Vertices of the bucket being settled, each at most once
+    int frontier_size;
+    atomic_int frontier_fill;  // Next free frontier slot while merging
+    atomic_int next_claim;     // First frontier index not yet claimed
+    atomic_int next_bucket;    // Lowest non-empty bucket over all workers
+    int current;               // Bucket being settled
+    int rounds;                // Bucket passes finished
+    pthread_barrier_t barrier; // Separates settling, merging and the next round
+    pthread_mutex_t lock;      // Start gate: workers wait until the barrier is sized
+    pthread_cond_t start;
+    bool started;
+};
+
+/**
+ * Append v to one of the worker's buckets, growing them as needed
+ */
+static void bucket_push(DeltaWorker* worker, int bucket, int v) {
+    if (bucket >= worker->num_buckets) {
+        int grown = worker->num_buckets * 2 > bucket + 1 ? worker->num_buckets * 2 : bucket + 1;
+        worker->buckets = (DeltaBucket*)realloc(worker->buckets, sizeof(DeltaBucket) * grown);
+        memset(worker->buckets + worker->num_buckets, 0, sizeof(DeltaBucket) * (grown - worker->num_buckets));
+        worker->num_buckets = grown;
+    }
+
+    DeltaBucket* b = &worker->buckets[bucket];
+    if (b->count == b->capacity) {
+        b->capacity = b->capacity > 0 ? b->capacity * 2 : 16;
+        b->items = (int*)realloc(b->items, sizeof(int) * b->capacity);
+    }
+    b->items[b->count++] = v;
+}
+
+/**
+ * Relax every road out of u; improved vertices go into this worker's buckets
+ */
+static void relax_vertex(DeltaWorker* worker, int u) {
+    DeltaJob* job = worker->job;
+    const CsrGraph* csr = job->csr;
+    int du = (int)(atomic_load_explicit(&job->labels[u], memory_order_relaxed) >> 32);
+    if (du / job->delta != job->current) return;  // Queued again in an earlier bucket and settled there
+
+    for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++) {
+        int v = csr->dest[e];
+        int new_dist = du + csr->weight[e];
+        uint64_t offer = (uint64_t)new_dist << 32 | (uint32_t)u;
+        uint64_t old = atomic_load_explicit(&job->labels[v], memory_order_relaxed);
+        while (offer < old) {
+            if (atomic_compare_exchange_weak_explicit(&job->labels[v], &old, offer,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                // Only a shorter distance needs v settled again; a lower parent alone does not
+                if (old >> 32 != offer >> 32) bucket_push(worker, new_dist / job->delta, v);
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * Lower an atomic int to value if it is smaller
+ */
+static void atomic_store_min(atomic_int* target, int value) {
+    int old = atomic_load(target);
+    while (value < old && !atomic_compare_exchange_weak(target, &old, value)) {
+        // old was refreshed by the failed exchange
+    }
+}
+
+/**
+ * Settle buckets together with the other workers until none is left
+ */
+static void run_rounds(DeltaWorker* worker) {
+    DeltaJob* job = worker->job;
+    while (true) {
+        // Relax the shared frontier, a chunk at a time
+        while (true) {
+            int begin = atomic_fetch_add(&job->next_claim, DELTA_CHUNK);
+            if (begin >= job->frontier_size) break;
+            int end = begin + DELTA_CHUNK < job->frontier_size ? begin + DELTA_CHUNK : job->frontier_size;
+            for (int i = begin; i < end; i++) {
+                relax_vertex(worker, job->frontier[i]);
+            }
+        }
+
+        // Offer this worker's lowest non-empty bucket (relaxations never land below the current one)
+        for (int b = job->current; b < worker->num_buckets; b++) {
+            if (worker->buckets[b].count > 0) {
+                atomic_store_min(&job->next_bucket, b);
+                break;
+            }
+        }
+        pthread_barrier_wait(&job->barrier);
+
+        int next = atomic_load(&job->next_bucket);
+        if (next == NO_BUCKET) return;  // Every worker reads the same value and stops
+
+        // Move this worker's share of the bucket into the frontier, skipping vertices already there
+        if (next < worker->num_buckets) {
+            DeltaBucket* bucket = &worker->buckets[next];
+            unsigned int round = (unsigned int)job->rounds + 1;
+            for (int i = 0; i < bucket->count; i++) {
+                int v = bucket->items[i];
+                if (atomic_exchange(&job->stamp[v], round) != round) {
+                    job->frontier[atomic_fetch_add(&job->frontier_fill, 1)] = v;
+                }
+            }
+            free(bucket->items);  // Settled buckets give their memory back
+            bucket->items = NULL;
+            bucket->count = 0;
+            bucket->capacity = 0;
+        }
+
+        // One worker sets up the next round while the rest wait
+        if (pthread_barrier_wait(&job->barrier) == PTHREAD_BARRIER_SERIAL_THREAD) {
+            job->frontier_size = atomic_load(&job->frontier_fill);
+            atomic_store(&job->frontier_fill, 0);
+            atomic_store(&job->next_claim, 0);
+            atomic_store(&job->next_bucket, NO_BUCKET);
+            job->current = next;
+            job->rounds++;
+        }
+        pthread_barrier_wait(&job->barrier);
+    }
+}
+
+/**
+ * pthread entry point: wait at the start gate, then run rounds
+ */
+static void* worker_main(void* arg) {
+    DeltaWorker* worker = (DeltaWorker*)arg;
+    DeltaJob* job = worker->job;
+    pthread_mutex_lock(&job->lock);
+    while (!job->started) pthread_cond_wait(&job->start, &job->lock);
+    pthread_mutex_unlock(&job->lock);
+
+    run_rounds(worker);
+    return NULL;
+}
+
+/**
+ * Sequential Dijkstra for graphs delta-stepping cannot take (roads of length 0 or less)
+ */
+static void sequential_search(Graph* graph, int source, int* dist, int* parent) {
+    DijkstraWorkspace* ws = dijkstra_workspace_create(graph->num_vertices);
+    dijkstra_search_all(graph, ws, source);
+    for (int v = 0; v < graph->num_vertices; v++) {
+        dist[v] = dijkstra_workspace_distance(ws, v);
+        parent[v] = dist[v] == INT_MAX ? -1 : ws->parent[v];
+    }
+    dijkstra_workspace_destroy(ws);
+}
+
+/**
+ * Delta-stepping from source on up to options->num_threads threads
+ * The calling thread is a worker too; threads that cannot be started are
+ * simply left out of the barrier.
+ */
+int delta_stepping(Graph* graph, int source, int* dist, int* parent, const DeltaOptions* options) {
+    const CsrGraph* csr = graph_freeze(graph);
+    int n = graph->num_vertices;
+
+    // The mean road length is the default width; any road of length 0 rules the method out
+    long long total_weight = 0;
+    int shortest = INT_MAX;
+    for (int e = 0; e < csr->num_edges; e++) {
+        total_weight += csr->weight[e];
+        if (csr->weight[e] < shortest) shortest = csr->weight[e];
+    }
+    if (shortest <= 0) {
+        sequential_search(graph, source, dist, parent);
+        return 1;
+    }
+
+    DeltaJob job;
+    job.csr = csr;
+    job.delta = options->delta > 0 ? options->delta
+              : csr->num_edges > 0 ? (int)(total_weight / csr->num_edges) : 1;
+    if (job.delta < 1) job.delta = 1;
+    job.labels = (DeltaLabel*)malloc(sizeof(DeltaLabel) * (n > 0 ? n : 1));
+    job.stamp = (atomic_uint*)malloc(sizeof(atomic_uint) * (n > 0 ? n : 1));
+    for (int v = 0; v < n; v++) {
+        atomic_init(&job.labels[v], UNREACHED);
+        atomic_init(&job.stamp[v], 0);
+    }
+    atomic_init(&job.labels[source], NO_PARENT);  // Distance 0, no parent
+
+    // The first round settles bucket 0, which holds just the source
+    job.frontier = (int*)malloc(sizeof(int) * (n > 0 ? n : 1));
+    job.frontier[0] = source;
+    job.frontier_size = 1;
+    atomic_init(&job.frontier_fill, 0);
+    atomic_init(&job.next_claim, 0);
+    atomic_init(&job.next_bucket, NO_BUCKET);
+    job.current = 0;
+    job.rounds = 0;
+    pthread_mutex_init(&job.lock, NULL);
+    pthread_cond_init(&job.start, NULL);
+    job.started = false;
+
+    int num_threads = options->num_threads > 1 ? options->num_threads : 1;
+    DeltaWorker* workers = (DeltaWorker*)calloc(num_threads, sizeof(DeltaWorker));
+    int started = 1;
+    pthread_mutex_lock(&job.lock);
+    for (int t = 1; t < num_threads; t++) {
+        workers[started].job = &job;
+        if (pthread_create(&workers[started].thread, NULL, worker_main, &workers[started]) == 0) {
+            started++;
+        }
+    }
+    pthread_barrier_init(&job.barrier, NULL, started);
+    job.started = true;
+    pthread_cond_broadcast(&job.start);
+    pthread_mutex_unlock(&job.lock);
+
+    workers[0].job = &job;
+    run_rounds(&workers[0]);
+
+    for (int t = 1; t < started; t++) {
+        pthread_join(workers[t].thread, NULL);
+    }
+
+    // Unpack the labels
+    for (int v = 0; v < n; v++) {
+        uint64_t label = atomic_load(&job.labels[v]);
+        uint32_t from = (uint32_t)label;
+        dist[v] = label == UNREACHED ? INT_MAX : (int)(label >> 32);
+        parent[v] = label == UNREACHED || from == NO_PARENT ? -1 : (int)from;
+    }
+
+    for (int t = 0; t < started; t++) {
+        for (int b = 0; b < workers[t].num_buckets; b++) {
+            free(workers[t].buckets[b].items);
+        }
+        free(workers[t].buckets);
+    }
+    free(workers);
+    pthread_barrier_destroy(&job.barrier);
+    pthread_mutex_destroy(&job.lock);
+    pthread_cond_destroy(&job.start);
+    free(job.labels);
+    free(job.stamp);
+    free(job.frontier);
+    return job.rounds + 1;
+}
@@ -0,0 +1,33 @@
+/**
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * CS 5008
+ * Parallel single-source shortest paths by delta-stepping
+ *
+ * Vertices are grouped into buckets of width delta by tentative distance.
+ * All threads settle the lowest non-empty bucket together, relaxing edges
+ * with atomic updates and collecting the vertices they improve in buckets
+ * of their own; between rounds those are merged into the next shared
+ * frontier. A bucket is repeated until no relaxation lands back in it.
+ */
+
+#ifndef DELTA_H
+#define DELTA_H
+
+#include "graph.h"
+
+// Options for one delta-stepping run
+typedef struct DeltaOptions {
+    int num_threads; // Worker threads including the caller (1 = run on the calling thread)
+    int delta;       // Bucket width, 0 = the mean road length
+} DeltaOptions;
+
+// Distances and shortest path tree from source to every vertex (freezes the graph).
+// dist[v] is INT_MAX and parent[v] -1 when v is unreachable; parent[source] is -1.
+// Distances match Dijkstra exactly; of several equally short paths the parent is
+// the lowest-numbered predecessor, whatever the thread count. Graphs with a road
+// of length 0 or less are searched by sequential Dijkstra instead.
+// Returns the number of rounds (bucket passes) the search took.
+int delta_stepping(Graph* graph, int source, int* dist, int* parent, const DeltaOptions* options);
+
+#endif
@@ -4,7 +4,10 @@
  */
 
 #include "dijkstra.h"
+#include "heap.h"
+#include "parallel.h"
 #include <stdlib.h>
+#include <string.h> // For memset
 #include <limits.h>
 #include <stdbool.h>
 
@@ -31,7 +34,7 @@ static int min_distance(int* dist, bool* visited, int n) {
 /**
  * Reconstruct path from start to end
  */
-static int* reconstruct_path(int* parent, int end, int* length) {
+static int* reconstruct_path(const int* parent, int end, int* length) {
     // Count path length by following parent pointers backwards
     int count = 0;
     int current = end;
@@ -54,17 +57,601 @@ static int* reconstruct_path(int* parent, int end, int* length) {
     return path;  // Path from start to end
 }
 
+/**
+ * Create a workspace able to search graphs of up to num_vertices vertices
+ */
+DijkstraWorkspace* dijkstra_workspace_create(int num_vertices) {
+    DijkstraWorkspace* ws = (DijkstraWorkspace*)malloc(sizeof(DijkstraWorkspace));
+    int slots = num_vertices > 0 ? num_vertices : 1;
+    
+    ws->capacity = num_vertices;
+    ws->dist = (int*)malloc(sizeof(int) * slots);
+    ws->parent = (int*)malloc(sizeof(int) * slots);
+    ws->reached = (unsigned int*)calloc(slots, sizeof(unsigned int));  // 0 = never touched
+    ws->settled = (unsigned int*)calloc(slots, sizeof(unsigned int));
+    ws->generation = 0;
+    ws->pq = pq_create(num_vertices);
+    ws->buckets = NULL;
+    ws->settled_count = 0;
+    memset(&ws->counters, 0, sizeof(SearchCounters));
+    
+    return ws;
+}
+
+/**
+ * Free a workspace
+ */
+void dijkstra_workspace_destroy(DijkstraWorkspace* ws) {
+    if (!ws) return;
+    free(ws->dist);
+    free(ws->parent);
+    free(ws->reached);
+    free(ws->settled);
+    pq_destroy(ws->pq);
+    bucket_queue_destroy(ws->buckets);
+    free(ws);
+}
+
+/**
+ * Start a new search in the workspace
+ * Bumping the generation invalidates every entry at once; only the
+ * queue is cleared explicitly, in time proportional to its size.
+ */
+void dijkstra_workspace_reset(DijkstraWorkspace* ws, int num_vertices) {
+    // Grow to fit a larger graph (fresh arrays start out untouched)
+    if (num_vertices > ws->capacity) {
+        free(ws->dist);
+        free(ws->parent);
+        free(ws->reached);
+        free(ws->settled);
+        pq_destroy(ws->pq);
+        ws->capacity = num_vertices;
+        ws->dist = (int*)malloc(sizeof(int) * num_vertices);
+        ws->parent = (int*)malloc(sizeof(int) * num_vertices);
+        ws->reached = (unsigned int*)calloc(num_vertices, sizeof(unsigned int));
+        ws->settled = (unsigned int*)calloc(num_vertices, sizeof(unsigned int));
+        ws->generation = 0;
+        ws->pq = pq_create(num_vertices);
+    }
+    
+    pq_clear(ws->pq);
+    ws->generation++;
+    ws->settled_count = 0;
+    
+    // After 2^32 searches the stamps wrap around; wipe them once
+    if (ws->generation == 0) {
+        memset(ws->reached, 0, sizeof(unsigned int) * ws->capacity);
+        memset(ws->settled, 0, sizeof(unsigned int) * ws->capacity);
+        ws->generation = 1;
+    }
+}
+
+/**
+ * Record a tentative distance (and queue entry) for v if it improves on the current one
+ */
+static inline void relax(DijkstraWorkspace* ws, int v, int new_dist, int u) {
+    unsigned int gen = ws->generation;
+    PROFILE_COUNT(ws->counters.relaxed, 1);
+    if (ws->settled[v] == gen) return;  // Already final
+    
+    if (ws->reached[v] != gen || new_dist < ws->dist[v]) {
+        PROFILE_COUNT(ws->counters.heap_pushes, 1);
+        ws->reached[v] = gen;
+        ws->dist[v] = new_dist;  // Update distance
+        ws->parent[v] = u;       // Record that we got to v from u
+        pq_push(ws->pq, v, new_dist);
+    }
+}
+
+/**
+ * Settle the closest queued vertex and relax its edges
+ * Edges come from csr when given, otherwise from the adjacency lists
+ * Returns the settled vertex, or -1 when the queue is empty
+ */
+static int settle_next(const Graph* graph, const CsrGraph* csr, DijkstraWorkspace* ws) {
+    if (pq_is_empty(ws->pq)) return -1;
+    
+    int du;
+    int u = pq_pop(ws->pq, &du);
+    ws->settled[u] = ws->generation;  // Mark this vertex as processed
+    ws->settled_count++;
+    PROFILE_COUNT(ws->counters.settled, 1);
+    
+    if (csr) {
+        // Neighbours of u are one contiguous slice of dest/weight
+        for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++) {
+            relax(ws, csr->dest[e], du + csr->weight[e], u);
+        }
+    } else {
+        for (EdgeNode* edge = graph->vertices[u].edges; edge; edge = edge->next) {
+            relax(ws, edge->dest, du + edge->weight, u);
+        }
+    }
+    
+    return u;
+}
+
+/**
+ * Reset the workspace and queue the start vertex at distance 0
+ */
+static void begin_search(DijkstraWorkspace* ws, int num_vertices, int start) {
+    dijkstra_workspace_reset(ws, num_vertices);
+    PROFILE_COUNT(ws->counters.searches, 1);
+    ws->reached[start] = ws->generation;
+    ws->dist[start] = 0;
+    ws->parent[start] = -1;
+    pq_push(ws->pq, start, 0);
+}
+
+/**
+ * Run the search from start until end is settled or nothing is left to explore
+ */
+static void run_search(const Graph* graph, const CsrGraph* csr, DijkstraWorkspace* ws,
+                       int num_vertices, int start, int end) {
+    begin_search(ws, num_vertices, start);
+    
+    // Early exit once the target is final
+    while (ws->settled[end] != ws->generation) {
+        if (settle_next(graph, csr, ws) == -1) break;
+    }
+}
+
+/**
+ * Settle every vertex reachable from source
+ * Afterwards ws->dist[v] is final for each v with reached[v] == generation
+ */
+void dijkstra_search_all(Graph* graph, DijkstraWorkspace* ws, int source) {
+    begin_search(ws, graph->num_vertices, source);
+    while (settle_next(graph, graph->csr, ws) != -1) {
+        // Keep settling until the queue runs dry
+    }
+}
+
+/**
+ * Build the result for end from the workspace's last search
+ */
+PathResult dijkstra_workspace_result(const DijkstraWorkspace* ws, int end) {
+    PathResult result;
+    result.path = NULL;
+    result.path_length = 0;
+    result.total_distance = 0;
+    result.found = false;
+    result.settled = ws->settled_count;
+    
+    // Check if path was found
+    if (ws->reached[end] == ws->generation) {
+        result.found = true;
+        result.total_distance = ws->dist[end];
+        // Every vertex on the path was touched this generation, so parents are valid
+        result.path = reconstruct_path(ws->parent, end, &result.path_length);
+    }
+    
+    return result;
+}
+
+/**
+ * Dijkstra's shortest path algorithm reusing a caller-owned workspace
+ * Cost is proportional to the region explored, not to the graph size
+ */
+PathResult dijkstra_shortest_path_ws(Graph* graph, DijkstraWorkspace* ws, int start, int end) {
+    if (!graph_same_component(graph, start, end)) return path_result_unreachable();  // Would drain start's component
+    run_search(graph, graph->csr, ws, graph->num_vertices, start, end);
+    return dijkstra_workspace_result(ws, end);
+}
+
+/**
+ * Dijkstra's shortest path algorithm over a bucket queue
+ * Weights are integers, so every queued distance lies within max_weight of the
+ * last settled one and max_weight + 1 buckets hold the whole frontier. Each
+ * push is O(1) and pops only sweep empty buckets, O(V + E + D) in total for a
+ * search ending at distance D, against O((V + E) log V) with the heap.
+ * A negative road would index a bucket below zero, so it also sends the
+ * search to the heap.
+ */
+PathResult dijkstra_shortest_path_dial(Graph* graph, DijkstraWorkspace* ws, int start, int end) {
+    if (!graph_same_component(graph, start, end)) return path_result_unreachable();
+    const CsrGraph* csr = graph->csr;
+    if (!csr || csr->max_weight > DIAL_MAX_WEIGHT || csr->min_weight < 0) {
+        return dijkstra_shortest_path_ws(graph, ws, start, end);  // Too many buckets, no bound or a negative road
+    }
+
+    dijkstra_workspace_reset(ws, graph->num_vertices);
+    BucketQueue* queue = ws->buckets;
+    if (!queue || queue->capacity < ws->capacity || queue->num_buckets <= csr->max_weight) {
+        bucket_queue_destroy(queue);
+        queue = ws->buckets = bucket_queue_create(ws->capacity, csr->max_weight);
+    }
+    bucket_queue_clear(queue);  // Whatever the last search left behind
+
+    unsigned int gen = ws->generation;
+    PROFILE_COUNT(ws->counters.searches, 1);
+    ws->reached[start] = gen;
+    ws->dist[start] = 0;
+    ws->parent[start] = -1;
+    bucket_queue_push(queue, start, 0);
+
+    while (ws->settled[end] != gen && !bucket_queue_is_empty(queue)) {
+        int du;
+        int u = bucket_queue_pop(queue, &du);
+        ws->settled[u] = gen;
+        ws->settled_count++;
+        PROFILE_COUNT(ws->counters.settled, 1);
+
+        for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++) {
+            int v = csr->dest[e];
+            int new_dist = du + csr->weight[e];
+            PROFILE_COUNT(ws->counters.relaxed, 1);
+            if (ws->settled[v] == gen) continue;  // Already final
+            if (ws->reached[v] != gen || new_dist < ws->dist[v]) {
+                PROFILE_COUNT(ws->counters.heap_pushes, 1);
+                ws->reached[v] = gen;
+                ws->dist[v] = new_dist;
+                ws->parent[v] = u;
+                bucket_queue_push(queue, v, new_dist);
+            }
+        }
+    }
+
+    return dijkstra_workspace_result(ws, end);
+}
+
 /**
  * Dijkstra's shortest path algorithm
  * Finds shortest path from start vertex to end vertex
+ * Uses the priority queue from heap.h, so the cost is O((V + E) log V)
  */
 PathResult dijkstra_shortest_path(Graph* graph, int start, int end) {
+    // One-off workspace; callers issuing many queries should keep their own
+    DijkstraWorkspace* ws = dijkstra_workspace_create(graph->num_vertices);
+    PathResult result = dijkstra_shortest_path_ws(graph, ws, start, end);
+    dijkstra_workspace_destroy(ws);
+    return result;
+}
+
+/**
+ * Start a shortest path tree at origin (nothing is searched until a query)
+ * An origin of -1 makes an empty tree to be pointed somewhere with path_tree_reset.
+ */
+ShortestPathTree* path_tree_create(Graph* graph, int origin) {
+    ShortestPathTree* tree = (ShortestPathTree*)malloc(sizeof(ShortestPathTree));
+    tree->graph = graph;
+    tree->ws = dijkstra_workspace_create(graph->num_vertices);
+    path_tree_reset(tree, origin);
+    return tree;
+}
+
+/**
+ * Free a shortest path tree
+ */
+void path_tree_destroy(ShortestPathTree* tree) {
+    if (!tree) return;
+    dijkstra_workspace_destroy(tree->ws);
+    free(tree);
+}
+
+/**
+ * Throw the tree away and start again from origin, reusing its memory
+ */
+void path_tree_reset(ShortestPathTree* tree, int origin) {
+    tree->origin = origin;
+    tree->graph_version = tree->graph->version;
+    if (origin == -1) dijkstra_workspace_reset(tree->ws, tree->graph->num_vertices);
+    else begin_search(tree->ws, tree->graph->num_vertices, origin);
+}
+
+/**
+ * Grow the tree until end is settled (or everything reachable is)
+ * Settled vertices keep their final dist/parent, so a vertex settled by an
+ * earlier query is answered without searching at all.
+ */
+static void path_tree_grow(ShortestPathTree* tree, int end) {
+    if (tree->graph_version != tree->graph->version) {
+        path_tree_reset(tree, tree->origin);  // Graph changed: the old tree may be wrong
+    }
+    
+    DijkstraWorkspace* ws = tree->ws;
+    while (ws->settled[end] != ws->generation) {
+        if (settle_next(tree->graph, tree->graph->csr, ws) == -1) break;
+    }
+}
+
+/**
+ * Shortest path from the tree's origin to end
+ * The result matches dijkstra_shortest_path; settled counts the whole tree so far.
+ */
+PathResult path_tree_path(ShortestPathTree* tree, int end) {
+    if (tree->origin != -1 && !graph_same_component(tree->graph, tree->origin, end)) {
+        PathResult result = path_result_unreachable();
+        result.settled = tree->ws->settled_count;  // The tree stays as it was
+        return result;
+    }
+    path_tree_grow(tree, end);
+    return dijkstra_workspace_result(tree->ws, end);
+}
+
+/**
+ * Distance from the tree's origin to end, INT_MAX if unreachable
+ */
+int path_tree_distance(ShortestPathTree* tree, int end) {
+    if (tree->origin != -1 && !graph_same_component(tree->graph, tree->origin, end)) return INT_MAX;
+    path_tree_grow(tree, end);
+    return dijkstra_workspace_distance(tree->ws, end);
+}
+
+/**
+ * Bring the tree up to date after one road change instead of starting over
+ * A longer or closed road only matters if the tree reaches a vertex through it.
+ * A shorter or new road cannot change a settled distance unless it improves one
+ * of its own ends; if only one end is settled, that end's relaxation of the
+ * road is simply done again with the new weight.
+ */
+void path_tree_repair(ShortestPathTree* tree, const RoadChange* change) {
+    // The tree must have seen every change before this one
+    if (tree->origin == -1 || tree->graph_version + 1 != tree->graph->version) {
+        path_tree_reset(tree, tree->origin);
+        return;
+    }
+    tree->graph_version = tree->graph->version;
+    
+    DijkstraWorkspace* ws = tree->ws;
+    unsigned int gen = ws->generation;
+    int a = change->from;
+    int b = change->to;
+    if (graph_change_lengthens(change)) {
+        bool used = (ws->reached[b] == gen && ws->parent[b] == a) ||
+                    (ws->reached[a] == gen && ws->parent[a] == b);
+        if (used) path_tree_reset(tree, tree->origin);
+        return;
+    }
+    
+    int weight = change->new_weight;
+    bool settled_a = ws->settled[a] == gen;
+    bool settled_b = ws->settled[b] == gen;
+    if (settled_a && settled_b) {
+        if (ws->dist[a] + weight < ws->dist[b] || ws->dist[b] + weight < ws->dist[a]) {
+            path_tree_reset(tree, tree->origin);
+        }
+        return;
+    }
+    if (settled_a) relax(ws, b, ws->dist[a] + weight, a);
+    if (settled_b) relax(ws, a, ws->dist[b] + weight, b);
+}
+
+/**
+ * One side of a bidirectional search relaxes edge u -> v
+ * If the other side has already reached v, start -> u -> v -> end is a
+ * candidate connection; the best one is kept in *best, *meet_u and *meet_v.
+ */
+static inline void relax_toward(DijkstraWorkspace* ws, const DijkstraWorkspace* other, int u, int du,
+                                int v, int w, int* best, int* meet_u, int* meet_v) {
+    relax(ws, v, du + w, u);
+    
+    if (other->reached[v] == other->generation && v != u) {
+        int through = du + w + other->dist[v];
+        if (through < *best) {
+            *best = through;
+            *meet_u = u;
+            *meet_v = v;
+        }
+    }
+}
+
+/**
+ * Settle the closest vertex on one side of a bidirectional search
+ */
+static void settle_toward(const Graph* graph, const CsrGraph* csr, DijkstraWorkspace* ws,
+                          const DijkstraWorkspace* other, int* best, int* meet_u, int* meet_v) {
+    int du;
+    int u = pq_pop(ws->pq, &du);
+    ws->settled[u] = ws->generation;
+    ws->settled_count++;
+    PROFILE_COUNT(ws->counters.settled, 1);
+    
+    if (csr) {
+        for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++) {
+            relax_toward(ws, other, u, du, csr->dest[e], csr->weight[e], best, meet_u, meet_v);
+        }
+    } else {
+        for (EdgeNode* edge = graph->vertices[u].edges; edge; edge = edge->next) {
+            relax_toward(ws, other, u, du, edge->dest, edge->weight, best, meet_u, meet_v);
+        }
+    }
+}
+
+/**
+ * Bidirectional Dijkstra reusing two caller-owned workspaces
+ * Searches forward from start and backward from end (edges are symmetric),
+ * stopping once the two frontiers cannot produce a shorter connection.
+ */
+PathResult dijkstra_bidirectional_ws(Graph* graph, DijkstraWorkspace* forward,
+                                     DijkstraWorkspace* backward, int start, int end) {
+    if (!graph_same_component(graph, start, end)) return path_result_unreachable();
+    const CsrGraph* csr = graph->csr;
+    int n = graph->num_vertices;
+    begin_search(forward, n, start);
+    begin_search(backward, n, end);
+    
+    int best = start == end ? 0 : INFINITY_DIST;  // Shortest connection seen so far
+    int meet_u = start;                           // Last forward vertex on that connection
+    int meet_v = end;                             // First backward vertex on that connection
+    
+    while (!pq_is_empty(forward->pq) && !pq_is_empty(backward->pq)) {
+        int top_forward = pq_min_key(forward->pq);
+        int top_backward = pq_min_key(backward->pq);
+        
+        // Nothing left in either frontier can beat the best connection
+        if (best != INFINITY_DIST && top_forward + top_backward >= best) break;
+        
+        // Expand the side with the smaller frontier distance
+        if (top_forward <= top_backward) {
+            settle_toward(graph, csr, forward, backward, &best, &meet_u, &meet_v);
+        } else {
+            // Backward side: its "u" is nearer end, so swap the roles of the meeting pair
+            settle_toward(graph, csr, backward, forward, &best, &meet_v, &meet_u);
+        }
+    }
+    
+    PathResult result;
+    result.path = NULL;
+    result.path_length = 0;
+    result.total_distance = 0;
+    result.found = false;
+    result.settled = forward->settled_count + backward->settled_count;
+    
+    if (best == INFINITY_DIST) return result;
+    
+    result.found = true;
+    result.total_distance = best;
+    
+    // Forward half: start .. meet_u
+    int forward_length;
+    int* forward_path = reconstruct_path(forward->parent, meet_u, &forward_length);
+    
+    // Backward half: meet_v .. end, read off the backward tree's parents
+    int backward_length = 0;
+    if (meet_u != meet_v) {
+        for (int v = meet_v; v != -1; v = backward->parent[v]) backward_length++;
+    }
+    
+    result.path_length = forward_length + backward_length;
+    result.path = (int*)malloc(sizeof(int) * result.path_length);
+    for (int i = 0; i < forward_length; i++) {
+        result.path[i] = forward_path[i];
+    }
+    int i = forward_length;
+    if (meet_u != meet_v) {
+        for (int v = meet_v; v != -1; v = backward->parent[v]) result.path[i++] = v;
+    }
+    free(forward_path);
+    
+    return result;
+}
+
+/**
+ * Bidirectional Dijkstra with one-off workspaces
+ */
+PathResult dijkstra_bidirectional(Graph* graph, int start, int end) {
+    DijkstraWorkspace* forward = dijkstra_workspace_create(graph->num_vertices);
+    DijkstraWorkspace* backward = dijkstra_workspace_create(graph->num_vertices);
+    PathResult result = dijkstra_bidirectional_ws(graph, forward, backward, start, end);
+    dijkstra_workspace_destroy(forward);
+    dijkstra_workspace_destroy(backward);
+    return result;
+}
+
+/**
+ * Search from source until every target is settled, then copy out their distances
+ * Targets are checked off in list order: k only moves past targets that are
+ * already final, so the search stops exactly when the last one settles.
+ */
+void dijkstra_one_to_many(Graph* graph, DijkstraWorkspace* ws, int source,
+                          const int* targets, int n_tgt, int* out) {
+    begin_search(ws, graph->num_vertices, source);
+    
+    // Targets in other components are never reached, so they are not waited for
+    int k = 0;
+    while (1) {
+        while (k < n_tgt && (ws->settled[targets[k]] == ws->generation ||
+                             !graph_same_component(graph, source, targets[k]))) k++;
+        if (k == n_tgt) break;  // All targets final
+        if (settle_next(graph, graph->csr, ws) == -1) break;  // The rest are unreachable
+    }
+    
+    for (int j = 0; j < n_tgt; j++) {
+        out[j] = dijkstra_workspace_distance(ws, targets[j]);
+    }
+}
+
+// Shared state for the workers of one distance table
+typedef struct TableJob {
+    Graph* graph;
+    const int* sources;
+    const int* targets;
+    int n_tgt;
+    int* out;
+    PathResult* paths;       // NULL to skip path reconstruction
+    DijkstraWorkspace** ws;  // One workspace per worker
+} TableJob;
+
+/**
+ * Worker task: fill row `index` of the table
+ */
+static void table_row(void* context, int worker, int index) {
+    TableJob* job = (TableJob*)context;
+    DijkstraWorkspace* ws = job->ws[worker];
+    int* row = &job->out[(size_t)index * job->n_tgt];
+    dijkstra_one_to_many(job->graph, ws, job->sources[index], job->targets, job->n_tgt, row);
+    
+    if (job->paths) {
+        PathResult* paths = &job->paths[(size_t)index * job->n_tgt];
+        for (int j = 0; j < job->n_tgt; j++) {
+            paths[j] = dijkstra_workspace_result(ws, job->targets[j]);
+        }
+    }
+}
+
+/**
+ * Distance matrix with one search per source, rows spread over worker threads
+ * The graph is only read, so workers share it; each has its own workspace.
+ */
+void dijkstra_distance_table_parallel(Graph* graph, const int* sources, int n_src,
+                                      const int* targets, int n_tgt, int* out,
+                                      const DistanceTableOptions* options) {
+    int num_threads = options && options->num_threads > 1 ? options->num_threads : 1;
+    if (num_threads > n_src) num_threads = n_src > 0 ? n_src : 1;
+    
+    TableJob job;
+    job.graph = graph;
+    job.sources = sources;
+    job.targets = targets;
+    job.n_tgt = n_tgt;
+    job.out = out;
+    job.paths = options ? options->paths : NULL;
+    job.ws = (DijkstraWorkspace**)malloc(sizeof(DijkstraWorkspace*) * num_threads);
+    for (int t = 0; t < num_threads; t++) {
+        job.ws[t] = dijkstra_workspace_create(graph->num_vertices);
+    }
+    
+    parallel_for(n_src, num_threads, table_row, &job);
+    
+    for (int t = 0; t < num_threads; t++) {
+        dijkstra_workspace_destroy(job.ws[t]);
+    }
+    free(job.ws);
+}
+
+/**
+ * Distance matrix on the calling thread, distances only
+ */
+void dijkstra_distance_table(Graph* graph, const int* sources, int n_src,
+                             const int* targets, int n_tgt, int* out) {
+    dijkstra_distance_table_parallel(graph, sources, n_src, targets, n_tgt, out, NULL);
+}
+
+/**
+ * Dijkstra's shortest path algorithm over the frozen CSR layout
+ * Same search as dijkstra_shortest_path, but edges are read from contiguous arrays
+ */
+PathResult dijkstra_shortest_path_csr(const CsrGraph* csr, int start, int end) {
+    DijkstraWorkspace* ws = dijkstra_workspace_create(csr->num_vertices);
+    run_search(NULL, csr, ws, csr->num_vertices, start, end);
+    PathResult result = dijkstra_workspace_result(ws, end);
+    dijkstra_workspace_destroy(ws);
+    return result;
+}
+
+/**
+ * Dijkstra's shortest path algorithm using a linear scan for the next vertex
+ * O(V^2) regardless of edge count; kept as a reference for tests and benchmarks
+ */
+PathResult dijkstra_shortest_path_scan(Graph* graph, int start, int end) {
     // Initialize result structure
     PathResult result;
     result.path = NULL;
     result.path_length = 0;
     result.total_distance = 0;
     result.found = false;
+    result.settled = 0;
     
     int n = graph->num_vertices;
     
@@ -92,6 +679,7 @@ PathResult dijkstra_shortest_path(Graph* graph, int start, int end) {
         
         // Mark this vertex as processed
         visited[u] = true;
+        result.settled++;
         
         // Early exit
         if (u == end) break;
@@ -131,6 +719,19 @@ PathResult dijkstra_shortest_path(Graph* graph, int start, int end) {
     return result;
 }
 
+/**
+ * Result for a pair in different components, answered without a search
+ */
+PathResult path_result_unreachable(void) {
+    PathResult result;
+    result.path = NULL;
+    result.path_length = 0;
+    result.total_distance = 0;
+    result.found = false;
+    result.settled = 0;
+    return result;
+}
+
 /**
  * Free path result memory
  */
@@ -9,20 +9,116 @@
 #define DIJKSTRA_H
 
 #include "graph.h" // Include the graph data structure
+#include "heap.h"  // Priority queue used by the workspace
+#include "profile.h" // Search counters
 #include <stdbool.h> // For bool type
 #include <limits.h> 
 
+// Longest road the bucket queue engine handles (one bucket per unit of weight);
+// graphs with a longer road fall back to the heap
+#define DIAL_MAX_WEIGHT 65535
+
 // Result structure for shortest path
 typedef struct PathResult {
     int* path;           // Array of vertex indices from start to end
     int path_length;     // Number of vertices in path
     int total_distance;  // Sum of all edge weights in path
     bool found;          // True if path exists, false otherwise
+    int settled;         // Vertices settled by the search (a measure of its effort)
 } PathResult;
 
+// Reusable search state, allocated once per thread and reused across queries.
+// dist/parent of v are only meaningful when reached[v] == generation, so a new
+// query just bumps the generation instead of reinitialising V entries.
+typedef struct DijkstraWorkspace {
+    int capacity;            // Number of vertices the arrays cover
+    int* dist;               // Tentative distance from the start
+    int* parent;             // Previous vertex on the best known path
+    unsigned int* reached;   // Generation in which dist/parent were last written
+    unsigned int* settled;   // Generation in which the vertex was finalised
+    unsigned int generation; // Stamp of the current search
+    PriorityQueue* pq;       // Frontier ordered by distance
+    BucketQueue* buckets;    // Frontier of the bucket queue engine, NULL until it first runs
+    int settled_count;       // Vertices settled by the current search
+    SearchCounters counters; // Work done by every search on this workspace (see profile.h)
+} DijkstraWorkspace;
+
+// Shortest path tree from one origin, kept between queries. The search only
+// runs as far as the destinations asked for so far and resumes from its
+// saved frontier when a farther one is requested.
+typedef struct ShortestPathTree {
+    Graph* graph;
+    int origin;
+    DijkstraWorkspace* ws;        // dist/parent of the tree plus the paused frontier
+    unsigned int graph_version;   // Graph version the tree was grown on
+} ShortestPathTree;
+
 // Find shortest path between two vertices
 PathResult dijkstra_shortest_path(Graph* graph, int start, int end);
 
+// Workspace operations
+DijkstraWorkspace* dijkstra_workspace_create(int num_vertices);
+void dijkstra_workspace_destroy(DijkstraWorkspace* ws);
+void dijkstra_workspace_reset(DijkstraWorkspace* ws, int num_vertices);
+PathResult dijkstra_workspace_result(const DijkstraWorkspace* ws, int end);
+
+// Settle everything reachable from source (full shortest path tree in ws)
+void dijkstra_search_all(Graph* graph, DijkstraWorkspace* ws, int source);
+
+/**
+ * Final distance of v after a search, or INT_MAX if v was not reached
+ */
+static inline int dijkstra_workspace_distance(const DijkstraWorkspace* ws, int v) {
+    return ws->reached[v] == ws->generation ? ws->dist[v] : INT_MAX;
+}
+
+// Find shortest path reusing a workspace (no per-query allocation besides the path)
+PathResult dijkstra_shortest_path_ws(Graph* graph, DijkstraWorkspace* ws, int start, int end);
+
+// Same search over Dial's bucket queue, exploiting integer weights; falls back
+// to dijkstra_shortest_path_ws when the graph is not frozen, a road is
+// longer than DIAL_MAX_WEIGHT or a road is negative
+PathResult dijkstra_shortest_path_dial(Graph* graph, DijkstraWorkspace* ws, int start, int end);
+
+// Bidirectional search meeting in the middle (edges are symmetric)
+PathResult dijkstra_bidirectional(Graph* graph, int start, int end);
+PathResult dijkstra_bidirectional_ws(Graph* graph, DijkstraWorkspace* forward,
+                                     DijkstraWorkspace* backward, int start, int end);
+
+// Shortest path tree operations
+ShortestPathTree* path_tree_create(Graph* graph, int origin);
+void path_tree_destroy(ShortestPathTree* tree);
+void path_tree_reset(ShortestPathTree* tree, int origin);
+PathResult path_tree_path(ShortestPathTree* tree, int end);
+int path_tree_distance(ShortestPathTree* tree, int end);
+void path_tree_repair(ShortestPathTree* tree, const RoadChange* change);
+
+// Options for the parallel distance table
+typedef struct DistanceTableOptions {
+    int num_threads;     // Worker threads (1 = run on the calling thread)
+    PathResult* paths;   // If not NULL, n_src * n_tgt paths are also stored here, row-major
+} DistanceTableOptions;
+
+// Distances from one source to several targets; stops once every target is settled
+void dijkstra_one_to_many(Graph* graph, DijkstraWorkspace* ws, int source,
+                          const int* targets, int n_tgt, int* out);
+
+// Distance matrix: out[i * n_tgt + j] = sources[i] -> targets[j], INT_MAX if unreachable
+void dijkstra_distance_table(Graph* graph, const int* sources, int n_src,
+                             const int* targets, int n_tgt, int* out);
+void dijkstra_distance_table_parallel(Graph* graph, const int* sources, int n_src,
+                                      const int* targets, int n_tgt, int* out,
+                                      const DistanceTableOptions* options);
+
+// Same search over the frozen CSR layout (see graph_freeze)
+PathResult dijkstra_shortest_path_csr(const CsrGraph* csr, int start, int end);
+
+// Reference O(V^2) version that scans for the closest vertex
+PathResult dijkstra_shortest_path_scan(Graph* graph, int start, int end);
+
+// Result for a pair the component index rules out (no search, nothing to free)
+PathResult path_result_unreachable(void);
+
 // Free path result
 void path_result_destroy(PathResult* result);
 
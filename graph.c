@@ -4,11 +4,70 @@
  * CS 5008
  * Implementation of graph data structure using adjacency list representation
  */
- 
+
+#define _POSIX_C_SOURCE 200809L // For munmap
+
 #include "graph.h" // Include the corresponding header file
+#include <math.h>  // For NAN, isnan
 #include <stdio.h> // For printf
 #include <stdlib.h> // For malloc, free
-#include <string.h> // For strcpy, strcmp
+#include <string.h> // For strcmp, strlen, memset
+#include <sys/mman.h> // For munmap
+
+#define MIN_INDEX_CAPACITY 16  // Smallest hash index size
+#define EMPTY_SLOT -1          // Marks an unused hash index slot
+#define ARENA_BLOCK_SIZE 65536 // First arena block; later blocks double in size
+
+/**
+ * FNV-1a hash of a city name
+ */
+static unsigned int hash_name(const char* name) {
+    unsigned int hash = 2166136261u;
+    for (const unsigned char* p = (const unsigned char*)name; *p; p++) {
+        hash ^= *p;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * Rebuild the name index with the given number of slots (power of two)
+ */
+static void rebuild_index(Graph* graph, int slots) {
+    free(graph->index);
+    graph->index = (int*)malloc(sizeof(int) * slots);
+    graph->index_capacity = slots;
+    for (int i = 0; i < slots; i++) {
+        graph->index[i] = EMPTY_SLOT;
+    }
+
+    // Reinsert every vertex using its cached hash
+    unsigned int mask = (unsigned int)slots - 1;
+    for (int v = 0; v < graph->num_vertices; v++) {
+        unsigned int slot = graph->vertices[v].hash & mask;
+        while (graph->index[slot] != EMPTY_SLOT) {
+            slot = (slot + 1) & mask;  // Linear probing
+        }
+        graph->index[slot] = v;
+    }
+}
+
+/**
+ * Find the index slot holding name, or the empty slot where it would go
+ */
+static unsigned int find_slot(Graph* graph, const char* name, unsigned int hash) {
+    unsigned int mask = (unsigned int)graph->index_capacity - 1;
+    unsigned int slot = hash & mask;
+
+    while (graph->index[slot] != EMPTY_SLOT) {
+        Vertex* vertex = &graph->vertices[graph->index[slot]];
+        // Compare cached hashes before touching the strings
+        if (vertex->hash == hash && strcmp(vertex->name, name) == 0) break;
+        slot = (slot + 1) & mask;
+    }
+
+    return slot;
+}
 
 /**
  * Create a new graph
@@ -28,31 +87,62 @@ Graph* graph_create(int initial_capacity) {
         graph->vertices[i].edges = NULL;
     }
     
+    // Name index sized for the initial capacity at a load factor of at most 1/2
+    int slots = MIN_INDEX_CAPACITY;
+    while (slots < initial_capacity * 2) slots *= 2;
+    graph->index = NULL;
+    rebuild_index(graph, slots);
+    graph->csr = NULL;  // Not frozen yet
+    graph->arena = arena_create(ARENA_BLOCK_SIZE);
+    graph->free_edges = NULL;  // Nothing removed yet
+    graph->coords = NULL;  // Allocated when the first coordinate is set
+    graph->original = NULL;  // File order until relabeled
+    graph->component = (int*)malloc(sizeof(int) * initial_capacity);
+    graph->component_next = (int*)malloc(sizeof(int) * initial_capacity);
+    graph->component_size = (int*)malloc(sizeof(int) * initial_capacity);
+    graph->components_stale = false;  // No vertices, nothing to label
+    graph->mapped = NULL;  // Built in memory, not from a snapshot
+    graph->mapped_bytes = 0;
+    graph->version = 0;
+    memset(&graph->counters, 0, sizeof(GraphCounters));
+    
     return graph;
 }
 
+/**
+ * Check whether the graph is served from a snapshot and cannot change
+ */
+bool graph_is_read_only(const Graph* graph) {
+    return graph->mapped != NULL;
+}
+
 /**
  * Free all memory allocated to graph
  */
 void graph_destroy(Graph* graph) {
     if (!graph) return;  // Check for NULL pointer
     
-    // Free each vertex and its edges
-    for (int i = 0; i < graph->num_vertices; i++) {
-        // Free the city name string
-        free(graph->vertices[i].name);
-        
-        // Free all edges in the linked list
-        EdgeNode* edge = graph->vertices[i].edges;
-        while (edge) {
-            EdgeNode* temp = edge;  // Save current edge
-            edge = edge->next;       // Move to next edge
-            free(temp);              // Free the saved edge
-        }
+    // Snapshot graph: the index, CSR arrays, names, coordinates and components all live in the mapping
+    if (graph->mapped) {
+        munmap(graph->mapped, graph->mapped_bytes);
+        free(graph->csr);
+        free(graph->vertices);
+        free(graph);
+        return;
     }
     
-    // Free the vertices array
+    // Names and edges live in the arena, so they go in a handful of block frees
+    arena_destroy(graph->arena);
+    
+    // Free the frozen layout, vertices array and name index
+    graph_thaw(graph);
     free(graph->vertices);
+    free(graph->index);
+    free(graph->coords);
+    free(graph->original);
+    free(graph->component);
+    free(graph->component_next);
+    free(graph->component_size);
     // Free the graph structure
     free(graph);
 }
@@ -63,28 +153,60 @@ void graph_destroy(Graph* graph) {
  */
 int graph_add_vertex(Graph* graph, const char* name) {
     // Check if vertex already exists
-    int idx = graph_find_vertex(graph, name);
-    if (idx != -1) return idx;  // Return existing index
+    unsigned int hash = hash_name(name);
+    unsigned int slot = find_slot(graph, name, hash);
+    if (graph->index[slot] != EMPTY_SLOT) return graph->index[slot];  // Return existing index
+    if (graph->mapped) {
+        fprintf(stderr, "Error: Cannot add %s, graph snapshot is read-only\n", name);
+        return -1;
+    }
+    
+    // The frozen layout no longer covers every vertex
+    graph_thaw(graph);
+    graph->version++;
     
     // Expand capacity if needed
     if (graph->num_vertices >= graph->capacity) {
         graph->capacity *= 2;  // Double the capacity
         graph->vertices = (Vertex*)realloc(graph->vertices, 
                                           sizeof(Vertex) * graph->capacity);
+        if (graph->coords) {
+            graph->coords = (Coordinate*)realloc(graph->coords, sizeof(Coordinate) * graph->capacity);
+        }
+        if (graph->original) {
+            graph->original = (int*)realloc(graph->original, sizeof(int) * graph->capacity);
+        }
+        graph->component = (int*)realloc(graph->component, sizeof(int) * graph->capacity);
+        graph->component_next = (int*)realloc(graph->component_next, sizeof(int) * graph->capacity);
+        graph->component_size = (int*)realloc(graph->component_size, sizeof(int) * graph->capacity);
     }
     
     // Add new vertex at the end
-    idx = graph->num_vertices;
+    int idx = graph->num_vertices;
     
-    // Allocate and copy the city name
-    graph->vertices[idx].name = (char*)malloc(strlen(name) + 1);  // +1 for null terminator
-    strcpy(graph->vertices[idx].name, name);
+    // Copy the city name into the arena
+    graph->vertices[idx].name = arena_strdup(graph->arena, name);
     
     // Initialize with no edges yet
     graph->vertices[idx].edges = NULL;
+    graph->vertices[idx].hash = hash;
+    if (graph->coords) {
+        graph->coords[idx].latitude = NAN;  // Position not known yet
+        graph->coords[idx].longitude = NAN;
+    }
+    if (graph->original) graph->original[idx] = idx;  // Vertices added later keep their own index
+    graph->component[idx] = idx;  // A component of its own until a road reaches it
+    graph->component_next[idx] = idx;
+    graph->component_size[idx] = 1;
     
-    // Increment count
+    // Increment count and record the name in the index
     graph->num_vertices++;
+    graph->index[slot] = idx;
+    
+    // Keep the load factor at most 1/2
+    if (graph->num_vertices * 2 > graph->index_capacity) {
+        rebuild_index(graph, graph->index_capacity * 2);
+    }
     
     return idx;
 }
@@ -94,13 +216,177 @@ int graph_add_vertex(Graph* graph, const char* name) {
  * Returns index or -1 if not found
  */
 int graph_find_vertex(Graph* graph, const char* name) {
-    // Linear search through all vertices
-    for (int i = 0; i < graph->num_vertices; i++) {
-        if (strcmp(graph->vertices[i].name, name) == 0) {
-            return i;  // Found - return index
+    // Hash lookup - an empty slot holds EMPTY_SLOT, which is also "not found"
+    return graph->index[find_slot(graph, name, hash_name(name))];
+}
+
+/**
+ * Check that a road between two indices may be changed
+ */
+static bool can_change_road(const Graph* graph, int from_idx, int to_idx) {
+    // Both indices must refer to existing vertices
+    if (from_idx < 0 || from_idx >= graph->num_vertices ||
+        to_idx < 0 || to_idx >= graph->num_vertices) return false;
+    if (graph->mapped) {
+        fprintf(stderr, "Error: Cannot change a road, graph snapshot is read-only\n");
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Get an edge node, reusing one from a removed road when there is one
+ */
+static EdgeNode* new_edge_node(Graph* graph) {
+    EdgeNode* edge = graph->free_edges;
+    if (!edge) return (EdgeNode*)arena_alloc(graph->arena, sizeof(EdgeNode));
+    graph->free_edges = edge->next;
+    return edge;
+}
+
+/**
+ * Insert the edge from -> to at the head of from's adjacency list
+ */
+static void push_edge(Graph* graph, int from_idx, int to_idx, int weight) {
+    EdgeNode* new_edge = new_edge_node(graph);
+    new_edge->dest = to_idx;      // Where this edge goes
+    new_edge->weight = weight;    // Distance/cost
+    new_edge->next = graph->vertices[from_idx].edges;  // Insert at head of list
+    graph->vertices[from_idx].edges = new_edge;        // Update head pointer
+}
+
+/**
+ * Edge from -> to in from's adjacency list, or NULL
+ */
+static EdgeNode* find_edge_node(const Graph* graph, int from_idx, int to_idx) {
+    for (EdgeNode* edge = graph->vertices[from_idx].edges; edge; edge = edge->next) {
+        if (edge->dest == to_idx) return edge;
+    }
+    return NULL;
+}
+
+/**
+ * Take the edge from -> to out of from's list, keeping the node for reuse
+ * Returns false if there is no such edge
+ */
+static bool unlink_edge(Graph* graph, int from_idx, int to_idx) {
+    for (EdgeNode** link = &graph->vertices[from_idx].edges; *link; link = &(*link)->next) {
+        EdgeNode* edge = *link;
+        if (edge->dest != to_idx) continue;
+        *link = edge->next;
+        edge->next = graph->free_edges;
+        graph->free_edges = edge;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Set the weight of from -> to in the frozen layout, if there is one
+ */
+static void patch_csr(Graph* graph, int from_idx, int to_idx, int weight) {
+    CsrGraph* csr = graph->csr;
+    if (!csr) return;
+    for (int e = csr->offsets[from_idx]; e < csr->offsets[from_idx + 1]; e++) {
+        if (csr->dest[e] == to_idx) {
+            csr->weight[e] = weight;
+            if (weight > csr->max_weight) csr->max_weight = weight;  // A lower weight keeps the bound valid
+            if (weight < csr->min_weight) csr->min_weight = weight;
+            return;
+        }
+    }
+}
+
+/**
+ * Join the components of a and b after a road between them was added
+ * The smaller component takes the larger one's label, so a vertex is
+ * relabeled at most log2(V) times over all merges and a lookup stays one read.
+ */
+static void merge_components(Graph* graph, int a, int b) {
+    if (graph->components_stale) return;  // Recomputed from scratch on the next freeze
+    int keep = graph->component[a];
+    int drop = graph->component[b];
+    if (keep == drop) return;
+    if (graph->component_size[keep] < graph->component_size[drop]) {
+        int swap = keep;
+        keep = drop;
+        drop = swap;
+    }
+    
+    int v = drop;
+    do {
+        graph->component[v] = keep;
+        v = graph->component_next[v];
+    } while (v != drop);
+    
+    // Splice the two circular member lists into one
+    int after = graph->component_next[keep];
+    graph->component_next[keep] = graph->component_next[drop];
+    graph->component_next[drop] = after;
+    graph->component_size[keep] += graph->component_size[drop];
+}
+
+/**
+ * Label every component from scratch by breadth-first search
+ * Edges come from the frozen layout when there is one (a snapshot has no lists).
+ */
+void graph_rebuild_components(Graph* graph) {
+    int n = graph->num_vertices;
+    const CsrGraph* csr = graph->csr;
+    int* queue = (int*)malloc(sizeof(int) * (n > 0 ? n : 1));
+    for (int v = 0; v < n; v++) {
+        graph->component[v] = -1;
+    }
+    
+    for (int root = 0; root < n; root++) {
+        if (graph->component[root] != -1) continue;
+        graph->component[root] = root;
+        int head = 0, tail = 0;
+        queue[tail++] = root;
+        while (head < tail) {
+            int u = queue[head++];
+            if (csr) {
+                for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++) {
+                    int v = csr->dest[e];
+                    if (graph->component[v] == -1) {
+                        graph->component[v] = root;
+                        queue[tail++] = v;
+                    }
+                }
+            } else {
+                for (EdgeNode* edge = graph->vertices[u].edges; edge; edge = edge->next) {
+                    if (graph->component[edge->dest] == -1) {
+                        graph->component[edge->dest] = root;
+                        queue[tail++] = edge->dest;
+                    }
+                }
+            }
+        }
+        
+        // Members are linked in the order they were found
+        for (int i = 0; i < tail; i++) {
+            graph->component_next[queue[i]] = queue[i + 1 < tail ? i + 1 : 0];
         }
+        graph->component_size[root] = tail;
     }
-    return -1;  // Not found
+    
+    free(queue);
+    graph->components_stale = false;
+}
+
+/**
+ * Check whether a and b may be connected
+ * False means there is certainly no route; true while the labels are stale.
+ */
+bool graph_same_component(const Graph* graph, int a, int b) {
+    return graph->components_stale || graph->component[a] == graph->component[b];
+}
+
+/**
+ * Number of vertices reachable from v, itself included (an upper bound while stale)
+ */
+int graph_component_size(const Graph* graph, int v) {
+    return graph->components_stale ? graph->num_vertices : graph->component_size[graph->component[v]];
 }
 
 /**
@@ -114,29 +400,415 @@ bool graph_add_edge(Graph* graph, const char* from, const char* to, int weight)
     // Both cities must exist in the graph
     if (from_idx == -1 || to_idx == -1) return false;
     
-    // Create new edge node
-    EdgeNode* new_edge = (EdgeNode*)malloc(sizeof(EdgeNode));
-    new_edge->dest = to_idx;      // Where this edge goes
-    new_edge->weight = weight;    // Distance/cost
-    new_edge->next = graph->vertices[from_idx].edges;  // Insert at head of list
-    graph->vertices[from_idx].edges = new_edge;        // Update head pointer
+    return graph_add_edge_index(graph, from_idx, to_idx, weight);
+}
+
+/**
+ * Add an edge between two vertices given by index
+ * A road that is already there gets the new distance instead of a parallel copy.
+ */
+bool graph_add_edge_index(Graph* graph, int from_idx, int to_idx, int weight) {
+    if (!can_change_road(graph, from_idx, to_idx)) return false;
+    if (find_edge_node(graph, from_idx, to_idx)) {
+        return graph_update_edge_index(graph, from_idx, to_idx, weight);
+    }
+    
+    // The frozen layout is out of date once an edge is added
+    graph_thaw(graph);
+    graph->version++;
+    
+    // Add both directions (undirected graph); a self loop is stored once
+    PROFILE_COUNT(graph->counters.roads_added, 1);
+    push_edge(graph, from_idx, to_idx, weight);
+    if (from_idx != to_idx) push_edge(graph, to_idx, from_idx, weight);
+    merge_components(graph, from_idx, to_idx);
+    
+    return true;
+}
+
+/**
+ * Add an edge without checking for an existing road (see graph_merge_parallel_edges)
+ */
+bool graph_append_edge_index(Graph* graph, int from_idx, int to_idx, int weight) {
+    if (!can_change_road(graph, from_idx, to_idx)) return false;
+    
+    graph_thaw(graph);
+    graph->version++;
+    push_edge(graph, from_idx, to_idx, weight);
+    if (from_idx != to_idx) push_edge(graph, to_idx, from_idx, weight);  // A self loop is stored once
+    merge_components(graph, from_idx, to_idx);
+    return true;
+}
+
+/**
+ * Drop every edge that repeats an earlier destination in the same list
+ * Lists are newest first, so the edge that stays carries the last distance given.
+ * Returns the number of directed edges dropped.
+ */
+int graph_merge_parallel_edges(Graph* graph) {
+    if (graph->mapped) return 0;  // Snapshots are written from merged graphs
+    
+    int n = graph->num_vertices;
+    int* seen = (int*)calloc(n > 0 ? n : 1, sizeof(int));  // seen[d] == u + 1: u already has an edge to d
+    int dropped = 0;
+    for (int u = 0; u < n; u++) {
+        EdgeNode** link = &graph->vertices[u].edges;
+        while (*link) {
+            EdgeNode* edge = *link;
+            if (seen[edge->dest] != u + 1) {
+                seen[edge->dest] = u + 1;
+                link = &edge->next;
+                continue;
+            }
+            *link = edge->next;
+            edge->next = graph->free_edges;
+            graph->free_edges = edge;
+            dropped++;
+        }
+    }
+    free(seen);
+    
+    if (dropped > 0) {
+        graph_thaw(graph);
+        graph->version++;
+    }
+    return dropped;
+}
+
+/**
+ * Look up the road between two vertices
+ * Returns false if there is none; otherwise *weight (if not NULL) gets its distance
+ */
+bool graph_find_edge(const Graph* graph, int from_idx, int to_idx, int* weight) {
+    if (from_idx < 0 || from_idx >= graph->num_vertices ||
+        to_idx < 0 || to_idx >= graph->num_vertices) return false;
+    
+    // A snapshot graph only has the frozen layout
+    if (graph->mapped) {
+        const CsrGraph* csr = graph->csr;
+        for (int e = csr->offsets[from_idx]; e < csr->offsets[from_idx + 1]; e++) {
+            if (csr->dest[e] != to_idx) continue;
+            if (weight) *weight = csr->weight[e];
+            return true;
+        }
+        return false;
+    }
     
-    // Add edge to -> from (undirected graph = bidirectional edges)
-    new_edge = (EdgeNode*)malloc(sizeof(EdgeNode));
-    new_edge->dest = from_idx;    // Reverse direction
-    new_edge->weight = weight;    // Same distance
-    new_edge->next = graph->vertices[to_idx].edges;    // Insert at head
-    graph->vertices[to_idx].edges = new_edge;          // Update head pointer
+    EdgeNode* edge = find_edge_node(graph, from_idx, to_idx);
+    if (edge && weight) *weight = edge->weight;
+    return edge != NULL;
+}
+
+/**
+ * Change the distance of an existing road between two cities
+ */
+bool graph_update_edge(Graph* graph, const char* from, const char* to, int weight) {
+    return graph_update_edge_index(graph, graph_find_vertex(graph, from), graph_find_vertex(graph, to), weight);
+}
+
+/**
+ * Change the distance of an existing road given by index
+ * Returns false if there is no such road
+ */
+bool graph_update_edge_index(Graph* graph, int from_idx, int to_idx, int weight) {
+    if (!can_change_road(graph, from_idx, to_idx)) return false;
+    EdgeNode* forward = find_edge_node(graph, from_idx, to_idx);
+    if (!forward) return false;
+    
+    graph->version++;
+    PROFILE_COUNT(graph->counters.roads_updated, 1);
+    forward->weight = weight;
+    find_edge_node(graph, to_idx, from_idx)->weight = weight;
     
+    // Vertices and edge order are unchanged, so the frozen layout is patched, not rebuilt
+    patch_csr(graph, from_idx, to_idx, weight);
+    patch_csr(graph, to_idx, from_idx, weight);
     return true;
 }
 
+/**
+ * Remove the road between two cities
+ */
+bool graph_remove_edge(Graph* graph, const char* from, const char* to) {
+    return graph_remove_edge_index(graph, graph_find_vertex(graph, from), graph_find_vertex(graph, to));
+}
+
+/**
+ * Remove the road between two vertices given by index
+ * Returns false if there is no such road
+ */
+bool graph_remove_edge_index(Graph* graph, int from_idx, int to_idx) {
+    if (!can_change_road(graph, from_idx, to_idx)) return false;
+    if (!unlink_edge(graph, from_idx, to_idx)) return false;
+    if (from_idx != to_idx) unlink_edge(graph, to_idx, from_idx);
+    
+    // Offsets of every later vertex move, so the frozen layout is rebuilt on the next freeze;
+    // the road may have been a component's only link, so its labels are recomputed then too
+    graph_thaw(graph);
+    graph->components_stale = true;
+    graph->version++;
+    PROFILE_COUNT(graph->counters.roads_removed, 1);
+    return true;
+}
+
+/**
+ * Check whether a change can only make routes longer (a road removed or lengthened)
+ * Shortest paths that avoid the road stay shortest after such a change.
+ */
+bool graph_change_lengthens(const RoadChange* change) {
+    if (!change->existed) return !change->exists;  // A new road may be a shortcut
+    return !change->exists || change->new_weight >= change->old_weight;
+}
+
 /**
  * Print all vertices in the graph
  */
 
  void graph_print_vertices(Graph* graph) {
+    if (!graph->original) {
+        for (int i = 0; i < graph->num_vertices; i++) {
+            printf("%s\n", graph->vertices[i].name);
+        }
+        return;
+    }
+    
+    // Relabeled: list the cities in file order all the same
+    int* by_position = (int*)malloc(sizeof(int) * (graph->num_vertices > 0 ? graph->num_vertices : 1));
+    for (int v = 0; v < graph->num_vertices; v++) {
+        by_position[graph->original[v]] = v;
+    }
     for (int i = 0; i < graph->num_vertices; i++) {
-        printf("%s\n", graph->vertices[i].name);
+        printf("%s\n", graph->vertices[by_position[i]].name);
+    }
+    free(by_position);
+}
+
+/**
+ * Renumber the vertices so that vertex i becomes the old vertex order[i]
+ * Names, edges, coordinates and the name index all move with their vertex;
+ * adjacency lists keep their order. The version is bumped because anything
+ * holding vertex indices (caches, trees, heuristics) is stale afterwards.
+ * Returns false if the graph is read-only or order is not a permutation.
+ */
+bool graph_relabel(Graph* graph, const int* order) {
+    if (graph->mapped) {
+        fprintf(stderr, "Error: Cannot relabel, graph snapshot is read-only\n");
+        return false;
+    }
+    int n = graph->num_vertices;
+    int* position = (int*)malloc(sizeof(int) * (n > 0 ? n : 1));  // Old index -> new index
+    for (int v = 0; v < n; v++) {
+        position[v] = -1;
+    }
+    for (int i = 0; i < n; i++) {
+        if (order[i] < 0 || order[i] >= n || position[order[i]] != -1) {
+            fprintf(stderr, "Error: Vertex order is not a permutation\n");
+            free(position);
+            return false;
+        }
+        position[order[i]] = i;
+    }
+    
+    graph_thaw(graph);
+    graph->version++;
+    
+    Vertex* vertices = (Vertex*)malloc(sizeof(Vertex) * graph->capacity);
+    int* original = (int*)malloc(sizeof(int) * graph->capacity);
+    for (int i = 0; i < n; i++) {
+        vertices[i] = graph->vertices[order[i]];
+        original[i] = graph->original ? graph->original[order[i]] : order[i];
+        for (EdgeNode* edge = vertices[i].edges; edge; edge = edge->next) {
+            edge->dest = position[edge->dest];
+        }
+    }
+    free(graph->vertices);
+    free(graph->original);
+    graph->vertices = vertices;
+    graph->original = original;
+    
+    if (graph->coords) {
+        Coordinate* coords = (Coordinate*)malloc(sizeof(Coordinate) * graph->capacity);
+        for (int i = 0; i < n; i++) {
+            coords[i] = graph->coords[order[i]];
+        }
+        free(graph->coords);
+        graph->coords = coords;
     }
+    
+    // Component labels are vertex indices, so they are renumbered along with the vertices
+    int* component = (int*)malloc(sizeof(int) * graph->capacity);
+    int* component_next = (int*)malloc(sizeof(int) * graph->capacity);
+    int* component_size = (int*)malloc(sizeof(int) * graph->capacity);
+    for (int i = 0; i < n; i++) {
+        component[i] = position[graph->component[order[i]]];
+        component_next[i] = position[graph->component_next[order[i]]];
+        component_size[i] = graph->component_size[order[i]];
+    }
+    free(graph->component);
+    free(graph->component_next);
+    free(graph->component_size);
+    graph->component = component;
+    graph->component_next = component_next;
+    graph->component_size = component_size;
+    
+    rebuild_index(graph, graph->index_capacity);  // Slots hold vertex indices
+    free(position);
+    return true;
+}
+
+/**
+ * Position of a vertex in the vertices file (its index if never relabeled)
+ */
+int graph_original_index(const Graph* graph, int idx) {
+    return graph->original ? graph->original[idx] : idx;
+}
+
+/**
+ * Build the compressed sparse row layout of the current edges
+ * Edges keep their adjacency list order, so searches visit neighbours identically
+ */
+const CsrGraph* graph_freeze(Graph* graph) {
+    if (graph->csr) return graph->csr;  // Already frozen
+    PROFILE_START(begin);
+    
+    int n = graph->num_vertices;
+    CsrGraph* csr = (CsrGraph*)malloc(sizeof(CsrGraph));
+    csr->num_vertices = n;
+    csr->offsets = (int*)malloc(sizeof(int) * (n + 1));
+    
+    // First pass: count edges per vertex to get the offsets
+    int total = 0;
+    for (int u = 0; u < n; u++) {
+        csr->offsets[u] = total;
+        for (EdgeNode* edge = graph->vertices[u].edges; edge; edge = edge->next) {
+            total++;
+        }
+    }
+    csr->offsets[n] = total;
+    csr->num_edges = total;
+    
+    // Second pass: copy destinations and weights into contiguous arrays
+    csr->dest = (int*)malloc(sizeof(int) * (total > 0 ? total : 1));
+    csr->weight = (int*)malloc(sizeof(int) * (total > 0 ? total : 1));
+    csr->max_weight = 0;
+    csr->min_weight = 0;
+    for (int u = 0; u < n; u++) {
+        int e = csr->offsets[u];
+        for (EdgeNode* edge = graph->vertices[u].edges; edge; edge = edge->next) {
+            csr->dest[e] = edge->dest;
+            csr->weight[e] = edge->weight;
+            if (edge->weight > csr->max_weight) csr->max_weight = edge->weight;
+            if (edge->weight < csr->min_weight) csr->min_weight = edge->weight;
+            e++;
+        }
+    }
+    
+    graph->csr = csr;
+    if (graph->components_stale) graph_rebuild_components(graph);
+    PROFILE_COUNT(graph->counters.freezes, 1);
+    PROFILE_STOP(graph->counters.freeze_seconds, begin);
+    return csr;
+}
+
+/**
+ * Drop the frozen layout (called automatically when the graph changes)
+ */
+void graph_thaw(Graph* graph) {
+    if (!graph->csr || graph->mapped) return;  // A snapshot's CSR is its only layout
+    free(graph->csr->offsets);
+    free(graph->csr->dest);
+    free(graph->csr->weight);
+    free(graph->csr);
+    graph->csr = NULL;
+}
+
+/**
+ * Free every edge node and the frozen layout, keeping the cities
+ * Names share the arena with the edges, so they are copied into a new arena
+ * sized for them alone and the old one goes in one destroy. A snapshot has
+ * neither lists nor an arena, and its CSR is the mapped file, so it keeps it.
+ */
+void graph_release_edges(Graph* graph) {
+    if (graph->mapped) return;
+    graph_thaw(graph);
+    
+    size_t name_bytes = 0;
+    for (int v = 0; v < graph->num_vertices; v++) {
+        name_bytes += strlen(graph->vertices[v].name) + 1;
+    }
+    Arena* names = arena_create(name_bytes);
+    for (int v = 0; v < graph->num_vertices; v++) {
+        graph->vertices[v].name = arena_strdup(names, graph->vertices[v].name);
+        graph->vertices[v].edges = NULL;
+    }
+    arena_destroy(graph->arena);
+    graph->arena = names;
+    graph->free_edges = NULL;  // Those nodes were in the old arena
+}
+
+/**
+ * Report how much memory the graph holds
+ */
+void graph_memory_stats(const Graph* graph, GraphMemoryStats* stats) {
+    stats->vertex_bytes = sizeof(Vertex) * (size_t)graph->capacity;
+    if (graph->original && !graph->mapped) stats->vertex_bytes += sizeof(int) * (size_t)graph->capacity;
+    if (!graph->mapped) stats->vertex_bytes += 3 * sizeof(int) * (size_t)graph->capacity;  // Component labels, lists and sizes
+    stats->index_bytes = sizeof(int) * (size_t)graph->index_capacity;
+    
+    // Names are stored once each; edges are counted from the adjacency lists
+    size_t name_bytes = 0;
+    size_t edge_count = 0;
+    for (int i = 0; i < graph->num_vertices; i++) {
+        name_bytes += strlen(graph->vertices[i].name) + 1;
+        for (EdgeNode* edge = graph->vertices[i].edges; edge; edge = edge->next) {
+            edge_count++;
+        }
+    }
+    stats->name_bytes = name_bytes;
+    stats->edge_bytes = sizeof(EdgeNode) * edge_count;
+    stats->arena_reserved = graph->arena ? graph->arena->bytes_reserved : 0;  // None for snapshots
+    stats->arena_blocks = graph->arena ? graph->arena->num_blocks : 0;
+    
+    stats->csr_bytes = 0;
+    if (graph->csr) {
+        stats->csr_bytes = sizeof(CsrGraph) + sizeof(int) * ((size_t)graph->csr->num_vertices + 1) +
+                           2 * sizeof(int) * (size_t)graph->csr->num_edges;
+    }
+    
+    stats->total_bytes = sizeof(Graph) + stats->vertex_bytes + stats->index_bytes +
+                         stats->arena_reserved + stats->csr_bytes;
+}
+
+/**
+ * Record the position of a vertex in degrees
+ */
+void graph_set_coordinates(Graph* graph, int idx, double latitude, double longitude) {
+    if (idx < 0 || idx >= graph->num_vertices) return;
+    if (graph->mapped) {
+        fprintf(stderr, "Error: Cannot set coordinates, graph snapshot is read-only\n");
+        return;
+    }
+    
+    // First coordinate: allocate the array with every position unknown
+    if (!graph->coords) {
+        graph->coords = (Coordinate*)malloc(sizeof(Coordinate) * graph->capacity);
+        for (int i = 0; i < graph->capacity; i++) {
+            graph->coords[i].latitude = NAN;
+            graph->coords[i].longitude = NAN;
+        }
+    }
+    
+    graph->coords[idx].latitude = latitude;
+    graph->coords[idx].longitude = longitude;
+}
+
+/**
+ * Check whether every vertex has a known position
+ */
+bool graph_has_coordinates(const Graph* graph) {
+    if (!graph->coords) return false;
+    for (int i = 0; i < graph->num_vertices; i++) {
+        if (isnan(graph->coords[i].latitude) || isnan(graph->coords[i].longitude)) return false;
+    }
+    return true;
 }
@@ -8,6 +8,8 @@
 #ifndef GRAPH_H
 #define GRAPH_H
 
+#include "arena.h"
+#include "profile.h"
 #include <stdbool.h>
 #include <stdlib.h>
 #include <string.h>
@@ -23,21 +25,116 @@ typedef struct EdgeNode {
 typedef struct Vertex {
     char* name;        // City name 
     EdgeNode* edges;   // Linked list of edges to other cities
+    unsigned int hash; // Hash of name, cached for the name index
 } Vertex;
 
+// Geographic position of a city in degrees (NaN when unknown)
+typedef struct Coordinate {
+    double latitude;
+    double longitude;
+} Coordinate;
+
+// Compressed sparse row copy of the edges, built once loading is done
+typedef struct CsrGraph {
+    int num_vertices;   // Number of vertices covered by offsets
+    int num_edges;      // Directed edges (each road is stored twice)
+    int* offsets;       // Edges of vertex u are [offsets[u], offsets[u + 1])
+    int* dest;          // Destination of each edge
+    int* weight;        // Weight of each edge
+    int max_weight;     // Upper bound on every weight (exact when frozen, 0 without edges)
+    int min_weight;     // Lower bound on every weight (exact when frozen, 0 without edges)
+} CsrGraph;
+
 // Graph structure - holds all cities and their connections
 typedef struct Graph {
     Vertex* vertices;   // Dynamic array of vertices
     int num_vertices;   // Current number of vertices in graph
     int capacity;       // Maximum capacity before reallocation
+    int* index;         // Open addressing hash table of vertex indices keyed by name, -1 = empty
+    int index_capacity; // Number of slots in index (power of two)
+    CsrGraph* csr;      // Frozen edge layout, NULL until graph_freeze (dropped on change)
+    Arena* arena;       // Owns every city name and edge node
+    EdgeNode* free_edges; // Nodes of removed roads, reused before asking the arena for more
+    Coordinate* coords; // Optional per-vertex coordinates (same capacity as vertices), NULL if none
+    int* original;      // File position of each vertex after graph_relabel (same capacity), NULL if never relabeled
+    int* component;     // Connected component of each vertex, labeled by one of its members
+    int* component_next; // Next vertex of the same component (circular list walked when merging), NULL for a snapshot
+    int* component_size; // Vertices in each component, indexed by label
+    bool components_stale; // A road was removed; labels are recomputed on the next freeze
+    void* mapped;       // Snapshot file backing a read-only graph (see snapshot.h), NULL otherwise
+    size_t mapped_bytes; // Length of the mapping
+    unsigned int version; // Bumped on every change, so cached answers can tell they are stale
+    GraphCounters counters; // Freezes and road changes (see profile.h)
 } Graph;
 
+// One road changed by graph_add_edge, graph_update_edge or graph_remove_edge.
+// Caches and precomputed structures use it to repair themselves instead of rebuilding.
+typedef struct RoadChange {
+    int from;
+    int to;
+    bool existed;       // Road was there before the change
+    bool exists;        // Road is there after the change
+    int old_weight;     // Weight before (when existed)
+    int new_weight;     // Weight after (when exists)
+} RoadChange;
+
+// Bytes held by a graph, broken down by structure
+typedef struct GraphMemoryStats {
+    size_t vertex_bytes;    // Vertices array and original positions (including unused capacity)
+    size_t index_bytes;     // Name hash index
+    size_t name_bytes;      // City names in the arena
+    size_t edge_bytes;      // Edge nodes in the arena
+    size_t arena_reserved;  // Arena bytes obtained from malloc (used + slack)
+    int arena_blocks;       // Arena blocks (one free each on destroy)
+    size_t csr_bytes;       // Frozen CSR arrays, 0 if not frozen
+    size_t total_bytes;     // Everything above, counting the arena as reserved
+} GraphMemoryStats;
+
 // Graph operations
 Graph* graph_create(int initial_capacity);
+bool graph_is_read_only(const Graph* graph);
 void graph_destroy(Graph* graph);
 int graph_add_vertex(Graph* graph, const char* name);
 int graph_find_vertex(Graph* graph, const char* name);
 bool graph_add_edge(Graph* graph, const char* from, const char* to, int weight);
+bool graph_add_edge_index(Graph* graph, int from_idx, int to_idx, int weight);
+bool graph_find_edge(const Graph* graph, int from_idx, int to_idx, int* weight);
+bool graph_update_edge(Graph* graph, const char* from, const char* to, int weight);
+bool graph_update_edge_index(Graph* graph, int from_idx, int to_idx, int weight);
+bool graph_remove_edge(Graph* graph, const char* from, const char* to);
+bool graph_remove_edge_index(Graph* graph, int from_idx, int to_idx);
+bool graph_change_lengthens(const RoadChange* change);
 void graph_print_vertices(Graph* graph);
+void graph_memory_stats(const Graph* graph, GraphMemoryStats* stats);
+
+// Bulk loading: append roads without looking for an existing one, then merge
+// repeated roads once at the end (the last distance given for a pair wins)
+bool graph_append_edge_index(Graph* graph, int from_idx, int to_idx, int weight);
+int graph_merge_parallel_edges(Graph* graph);
+
+// Relabeling: order[new] is the old index of each vertex. Names still find
+// their cities, and graph_original_index gives a vertex's position in the file.
+bool graph_relabel(Graph* graph, const int* order);
+int graph_original_index(const Graph* graph, int idx);
+
+// Connected components: labels merge as roads are added and are recomputed
+// on the next graph_freeze after a road is removed. Lookups only read, so
+// threads sharing a frozen graph may call them.
+bool graph_same_component(const Graph* graph, int a, int b);
+int graph_component_size(const Graph* graph, int v);
+void graph_rebuild_components(Graph* graph);
+
+// Coordinate operations
+void graph_set_coordinates(Graph* graph, int idx, double latitude, double longitude);
+bool graph_has_coordinates(const Graph* graph);
+
+// Frozen layout operations
+const CsrGraph* graph_freeze(Graph* graph);
+void graph_thaw(Graph* graph);
+
+// Drop the adjacency lists and the CSR once another copy holds the roads
+// (see compact.h). City names move to a fresh arena, so the edge blocks are
+// freed. The graph then has no roads until they are added back.
+void graph_release_edges(Graph* graph);
 
 #endif
@@ -0,0 +1,450 @@
+/**
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * CS 5008
+ * Implementation of the addressable priority queue (binary or pairing heap)
+ * and of the monotone bucket queue
+ */
+
+#include "heap.h"
+#include <limits.h> // For INT_MAX
+#include <stdlib.h> // For malloc, free
+
+#ifdef PQ_PAIRING_HEAP
+
+/**
+ * Create an empty pairing heap able to hold vertices 0..capacity-1
+ */
+PriorityQueue* pq_create(int capacity) {
+    PriorityQueue* pq = (PriorityQueue*)malloc(sizeof(PriorityQueue));
+    pq->nodes = (PairingNode*)malloc(sizeof(PairingNode) * (capacity > 0 ? capacity : 1));
+    pq->scratch = (int*)malloc(sizeof(int) * (capacity > 0 ? capacity : 1));
+    pq->root = -1;
+    pq->size = 0;
+    pq->capacity = capacity;
+
+    for (int i = 0; i < capacity; i++) {
+        pq->nodes[i].in_heap = false;
+    }
+
+    return pq;
+}
+
+/**
+ * Free the pairing heap
+ */
+void pq_destroy(PriorityQueue* pq) {
+    if (!pq) return;
+    free(pq->nodes);
+    free(pq->scratch);
+    free(pq);
+}
+
+/**
+ * Merge two heap roots, returning the new root
+ */
+static int meld(PairingNode* nodes, int a, int b) {
+    if (a == -1) return b;
+    if (b == -1) return a;
+
+    // Smaller key stays on top
+    if (nodes[b].key < nodes[a].key) {
+        int temp = a;
+        a = b;
+        b = temp;
+    }
+
+    // Make b the first child of a
+    nodes[b].sibling = nodes[a].child;
+    if (nodes[a].child != -1) nodes[nodes[a].child].prev = b;
+    nodes[b].prev = a;
+    nodes[a].child = b;
+    nodes[a].sibling = -1;
+    nodes[a].prev = -1;
+
+    return a;
+}
+
+/**
+ * Insert a vertex, or lower its key if it is already queued
+ * Returns true if the queue changed
+ */
+bool pq_push(PriorityQueue* pq, int vertex, int key) {
+    PairingNode* nodes = pq->nodes;
+    PairingNode* node = &nodes[vertex];
+
+    if (!node->in_heap) {
+        // Fresh single node tree
+        node->key = key;
+        node->child = -1;
+        node->sibling = -1;
+        node->prev = -1;
+        node->in_heap = true;
+        pq->root = meld(nodes, pq->root, vertex);
+        pq->size++;
+        return true;
+    }
+
+    if (key >= node->key) return false;  // Not an improvement
+    node->key = key;
+    if (vertex == pq->root) return true;
+
+    // Cut the subtree out of its parent and meld it back with the root
+    int prev = node->prev;
+    if (nodes[prev].child == vertex) {
+        nodes[prev].child = node->sibling;
+    } else {
+        nodes[prev].sibling = node->sibling;
+    }
+    if (node->sibling != -1) nodes[node->sibling].prev = prev;
+    node->sibling = -1;
+    node->prev = -1;
+    pq->root = meld(nodes, pq->root, vertex);
+
+    return true;
+}
+
+/**
+ * Remove the vertex with the smallest key
+ * Returns the vertex (or -1 if empty) and stores its key in *key
+ */
+int pq_pop(PriorityQueue* pq, int* key) {
+    int top = pq->root;
+    if (top == -1) return -1;
+
+    PairingNode* nodes = pq->nodes;
+    if (key) *key = nodes[top].key;
+    nodes[top].in_heap = false;
+    pq->size--;
+
+    // Gather the children of the old root
+    int count = 0;
+    for (int c = nodes[top].child; c != -1; ) {
+        int next = nodes[c].sibling;
+        nodes[c].sibling = -1;
+        nodes[c].prev = -1;
+        pq->scratch[count++] = c;
+        c = next;
+    }
+
+    // First pass: meld children in pairs from left to right
+    int paired = 0;
+    for (int i = 0; i + 1 < count; i += 2) {
+        pq->scratch[paired++] = meld(nodes, pq->scratch[i], pq->scratch[i + 1]);
+    }
+    if (count % 2 == 1) pq->scratch[paired++] = pq->scratch[count - 1];
+
+    // Second pass: meld the pairs from right to left
+    int root = -1;
+    for (int i = paired - 1; i >= 0; i--) {
+        root = meld(nodes, pq->scratch[i], root);
+    }
+    pq->root = root;
+
+    return top;
+}
+
+/**
+ * Smallest key in the queue, INT_MAX if empty
+ */
+int pq_min_key(const PriorityQueue* pq) {
+    return pq->root == -1 ? INT_MAX : pq->nodes[pq->root].key;
+}
+
+/**
+ * Check whether a vertex is currently queued
+ */
+bool pq_contains(const PriorityQueue* pq, int vertex) {
+    return pq->nodes[vertex].in_heap;
+}
+
+/**
+ * Empty the queue in time proportional to its size
+ */
+void pq_clear(PriorityQueue* pq) {
+    if (pq->root == -1) return;
+
+    // Depth first walk over the remaining trees using scratch as a stack
+    int top = 0;
+    pq->scratch[top++] = pq->root;
+    while (top > 0) {
+        int v = pq->scratch[--top];
+        pq->nodes[v].in_heap = false;
+        if (pq->nodes[v].child != -1) pq->scratch[top++] = pq->nodes[v].child;
+        if (pq->nodes[v].sibling != -1) pq->scratch[top++] = pq->nodes[v].sibling;
+    }
+
+    pq->root = -1;
+    pq->size = 0;
+}
+
+/**
+ * Name of the compiled-in heap implementation
+ */
+const char* pq_name(void) {
+    return "pairing";
+}
+
+#else
+
+/**
+ * Create an empty binary heap able to hold vertices 0..capacity-1
+ */
+PriorityQueue* pq_create(int capacity) {
+    PriorityQueue* pq = (PriorityQueue*)malloc(sizeof(PriorityQueue));
+    int slots = capacity > 0 ? capacity : 1;
+    pq->heap = (int*)malloc(sizeof(int) * slots);
+    pq->keys = (int*)malloc(sizeof(int) * slots);
+    pq->pos = (int*)malloc(sizeof(int) * slots);
+    pq->size = 0;
+    pq->capacity = capacity;
+
+    for (int i = 0; i < capacity; i++) {
+        pq->pos[i] = -1;  // Nothing queued yet
+    }
+
+    return pq;
+}
+
+/**
+ * Free the binary heap
+ */
+void pq_destroy(PriorityQueue* pq) {
+    if (!pq) return;
+    free(pq->heap);
+    free(pq->keys);
+    free(pq->pos);
+    free(pq);
+}
+
+/**
+ * Move the entry at index i up until the heap property holds
+ */
+static void sift_up(PriorityQueue* pq, int i) {
+    int vertex = pq->heap[i];
+    int key = pq->keys[vertex];
+
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        int pv = pq->heap[parent];
+        if (pq->keys[pv] <= key) break;
+        pq->heap[i] = pv;  // Pull parent down
+        pq->pos[pv] = i;
+        i = parent;
+    }
+
+    pq->heap[i] = vertex;
+    pq->pos[vertex] = i;
+}
+
+/**
+ * Move the entry at index i down until the heap property holds
+ */
+static void sift_down(PriorityQueue* pq, int i) {
+    int vertex = pq->heap[i];
+    int key = pq->keys[vertex];
+
+    while (true) {
+        int child = 2 * i + 1;
+        if (child >= pq->size) break;
+
+        // Pick the smaller child
+        if (child + 1 < pq->size && pq->keys[pq->heap[child + 1]] < pq->keys[pq->heap[child]]) {
+            child++;
+        }
+        int cv = pq->heap[child];
+        if (pq->keys[cv] >= key) break;
+        pq->heap[i] = cv;  // Pull child up
+        pq->pos[cv] = i;
+        i = child;
+    }
+
+    pq->heap[i] = vertex;
+    pq->pos[vertex] = i;
+}
+
+/**
+ * Insert a vertex, or lower its key if it is already queued
+ * Returns true if the queue changed
+ */
+bool pq_push(PriorityQueue* pq, int vertex, int key) {
+    int i = pq->pos[vertex];
+
+    if (i == -1) {
+        // New entry goes at the bottom
+        pq->keys[vertex] = key;
+        pq->heap[pq->size] = vertex;
+        sift_up(pq, pq->size++);
+        return true;
+    }
+
+    if (key >= pq->keys[vertex]) return false;  // Not an improvement
+    pq->keys[vertex] = key;  // Decrease key
+    sift_up(pq, i);
+    return true;
+}
+
+/**
+ * Remove the vertex with the smallest key
+ * Returns the vertex (or -1 if empty) and stores its key in *key
+ */
+int pq_pop(PriorityQueue* pq, int* key) {
+    if (pq->size == 0) return -1;
+
+    int top = pq->heap[0];
+    if (key) *key = pq->keys[top];
+    pq->pos[top] = -1;
+
+    // Move last entry to the root and restore order
+    pq->size--;
+    if (pq->size > 0) {
+        pq->heap[0] = pq->heap[pq->size];
+        sift_down(pq, 0);
+    }
+
+    return top;
+}
+
+/**
+ * Smallest key in the queue, INT_MAX if empty
+ */
+int pq_min_key(const PriorityQueue* pq) {
+    return pq->size == 0 ? INT_MAX : pq->keys[pq->heap[0]];
+}
+
+/**
+ * Check whether a vertex is currently queued
+ */
+bool pq_contains(const PriorityQueue* pq, int vertex) {
+    return pq->pos[vertex] != -1;
+}
+
+/**
+ * Empty the queue in time proportional to its size
+ */
+void pq_clear(PriorityQueue* pq) {
+    for (int i = 0; i < pq->size; i++) {
+        pq->pos[pq->heap[i]] = -1;
+    }
+    pq->size = 0;
+}
+
+/**
+ * Name of the compiled-in heap implementation
+ */
+const char* pq_name(void) {
+    return "binary";
+}
+
+#endif
+
+/**
+ * Create an empty bucket queue for vertices 0..capacity-1 whose queued keys
+ * never span more than max_span
+ */
+BucketQueue* bucket_queue_create(int capacity, int max_span) {
+    BucketQueue* queue = (BucketQueue*)malloc(sizeof(BucketQueue));
+    int slots = capacity > 0 ? capacity : 1;
+    queue->num_buckets = (max_span > 0 ? max_span : 0) + 1;
+    queue->head = (int*)malloc(sizeof(int) * queue->num_buckets);
+    queue->next = (int*)malloc(sizeof(int) * slots);
+    queue->prev = (int*)malloc(sizeof(int) * slots);
+    queue->keys = (int*)malloc(sizeof(int) * slots);
+    queue->queued = (bool*)calloc(slots, sizeof(bool));
+    queue->cursor = 0;
+    queue->size = 0;
+    queue->capacity = capacity;
+
+    for (int b = 0; b < queue->num_buckets; b++) {
+        queue->head[b] = -1;
+    }
+
+    return queue;
+}
+
+/**
+ * Free the bucket queue
+ */
+void bucket_queue_destroy(BucketQueue* queue) {
+    if (!queue) return;
+    free(queue->head);
+    free(queue->next);
+    free(queue->prev);
+    free(queue->keys);
+    free(queue->queued);
+    free(queue);
+}
+
+/**
+ * Take a queued vertex out of its bucket
+ */
+static void bucket_unlink(BucketQueue* queue, int vertex) {
+    int prev = queue->prev[vertex];
+    int next = queue->next[vertex];
+    if (prev != -1) {
+        queue->next[prev] = next;
+    } else {
+        queue->head[queue->keys[vertex] % queue->num_buckets] = next;
+    }
+    if (next != -1) queue->prev[next] = prev;
+    queue->queued[vertex] = false;
+}
+
+/**
+ * Insert a vertex, or lower its key if it is already queued
+ * The key must lie between the last popped key and that plus max_span.
+ * Returns true if the queue changed
+ */
+bool bucket_queue_push(BucketQueue* queue, int vertex, int key) {
+    if (queue->queued[vertex]) {
+        if (key >= queue->keys[vertex]) return false;  // Not an improvement
+        bucket_unlink(queue, vertex);                   // Decrease key: move buckets
+    } else {
+        queue->size++;
+    }
+
+    int b = key % queue->num_buckets;
+    queue->keys[vertex] = key;
+    queue->prev[vertex] = -1;
+    queue->next[vertex] = queue->head[b];
+    if (queue->head[b] != -1) queue->prev[queue->head[b]] = vertex;
+    queue->head[b] = vertex;
+    queue->queued[vertex] = true;
+    return true;
+}
+
+/**
+ * Remove a vertex with the smallest key
+ * Returns the vertex (or -1 if empty) and stores its key in *key
+ */
+int bucket_queue_pop(BucketQueue* queue, int* key) {
+    if (queue->size == 0) return -1;
+
+    // Every queued key is within num_buckets of the cursor, so this finds one
+    int b = queue->cursor % queue->num_buckets;
+    while (queue->head[b] == -1) {
+        queue->cursor++;
+        if (++b == queue->num_buckets) b = 0;
+    }
+
+    int top = queue->head[b];
+    if (key) *key = queue->keys[top];
+    bucket_unlink(queue, top);
+    queue->size--;
+    return top;
+}
+
+/**
+ * Empty the queue and restart its keys at 0
+ * Only buckets from the cursor up to the last queued vertex are visited.
+ */
+void bucket_queue_clear(BucketQueue* queue) {
+    for (int b = queue->cursor % queue->num_buckets; queue->size > 0; b = (b + 1) % queue->num_buckets) {
+        for (int v = queue->head[b]; v != -1; v = queue->next[v]) {
+            queue->queued[v] = false;
+            queue->size--;
+        }
+        queue->head[b] = -1;
+    }
+    queue->cursor = 0;
+}
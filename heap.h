@@ -0,0 +1,99 @@
+/**
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * CS 5008
+ * Addressable min priority queue keyed by vertex index
+ *
+ * The default build uses an indexed binary heap. Compiling with
+ * -DPQ_PAIRING_HEAP (make PQ=pairing) switches to a pairing heap.
+ * Both support decrease-key, so Dijkstra never stores stale entries.
+ *
+ * BucketQueue is a separate, monotone queue for integer keys (Dial's
+ * algorithm) used by the bucket-queue Dijkstra engine.
+ */
+
+#ifndef HEAP_H
+#define HEAP_H
+
+#include <stdbool.h>
+
+#ifdef PQ_PAIRING_HEAP
+
+// Node of the pairing heap, one per vertex (children/siblings are vertex indices)
+typedef struct PairingNode {
+    int key;      // Priority of the vertex
+    int child;    // First child, -1 if none
+    int sibling;  // Next sibling, -1 if none
+    int prev;     // Parent if first child, otherwise previous sibling
+    bool in_heap; // True while the vertex is queued
+} PairingNode;
+
+typedef struct PriorityQueue {
+    PairingNode* nodes; // One node per vertex
+    int* scratch;       // Work array for two-pass merging and clearing
+    int root;           // Vertex at the root, -1 when empty
+    int size;           // Number of queued vertices
+    int capacity;       // Number of vertices the queue can address
+} PriorityQueue;
+
+#else
+
+typedef struct PriorityQueue {
+    int* heap;     // Vertex indices arranged as a binary min-heap
+    int* keys;     // Priority of each vertex (indexed by vertex)
+    int* pos;      // Position of each vertex in heap, -1 if not queued
+    int size;      // Number of queued vertices
+    int capacity;  // Number of vertices the queue can address
+} PriorityQueue;
+
+#endif
+
+// Priority queue operations
+PriorityQueue* pq_create(int capacity);
+void pq_destroy(PriorityQueue* pq);
+bool pq_push(PriorityQueue* pq, int vertex, int key);
+int pq_pop(PriorityQueue* pq, int* key);
+int pq_min_key(const PriorityQueue* pq);
+bool pq_contains(const PriorityQueue* pq, int vertex);
+void pq_clear(PriorityQueue* pq);
+const char* pq_name(void);
+
+/**
+ * Check whether the queue is empty
+ */
+static inline bool pq_is_empty(const PriorityQueue* pq) {
+    return pq->size == 0;
+}
+
+// Circular array of buckets, one per key modulo num_buckets, each a doubly
+// linked list of vertices. Keys must never go below the last popped key nor
+// more than num_buckets - 1 above it, which Dijkstra guarantees when
+// num_buckets exceeds the largest edge weight. Push and decrease-key are
+// O(1); pops sweep the cursor over empty buckets in increasing key order.
+typedef struct BucketQueue {
+    int* head;       // First vertex of each bucket, -1 if empty
+    int* next;       // Next vertex in the same bucket (indexed by vertex)
+    int* prev;       // Previous vertex in the same bucket, -1 if first
+    int* keys;       // Key of each queued vertex
+    bool* queued;    // True while the vertex is in some bucket
+    int num_buckets; // Largest key span the queue can hold, plus one
+    int cursor;      // Smallest key that can still be queued
+    int size;        // Number of queued vertices
+    int capacity;    // Number of vertices the queue can address
+} BucketQueue;
+
+// Bucket queue operations
+BucketQueue* bucket_queue_create(int capacity, int max_span);
+void bucket_queue_destroy(BucketQueue* queue);
+bool bucket_queue_push(BucketQueue* queue, int vertex, int key);
+int bucket_queue_pop(BucketQueue* queue, int* key);
+void bucket_queue_clear(BucketQueue* queue);
+
+/**
+ * Check whether the bucket queue is empty
+ */
+static inline bool bucket_queue_is_empty(const BucketQueue* queue) {
+    return queue->size == 0;
+}
+
+#endif
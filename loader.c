@@ -0,0 +1,541 @@
+/**
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * CS 5008
+ * Loading cities and distances from text files into a graph
+ *
+ * Files are read in large blocks and split into lines in place, so lines
+ * may be any length and there is no per-line sscanf. Malformed lines are
+ * skipped and reported on stderr with their line number.
+ *
+ * load_distances_parallel parses byte ranges of the file on several threads
+ * and merges the roads with a counting sort by vertex. The lists it builds
+ * are identical to those of load_distances, whatever the thread count.
+ */
+
+#include "loader.h"
+#include "parallel.h"
+#include <limits.h> // For INT_MAX
+#include <stdio.h>  // For FILE, fread, fprintf
+#include <stdlib.h> // For malloc, realloc, free, strtod
+#include <string.h> // For memchr, memmove
+
+#define READ_BLOCK (1 << 20)  // Bytes requested from the file per read
+#define MAX_REPORTED 10       // Malformed lines reported individually per file
+
+// Block-buffered line reader; a line longer than the buffer grows it
+typedef struct LineReader {
+    FILE* file;
+    const char* filename;
+    char* buffer;
+    size_t capacity;  // Buffer size (one byte is kept for a final terminator)
+    size_t start;     // First unread byte
+    size_t end;       // One past the last byte read
+    bool at_eof;      // No more bytes in the file
+    long line_number; // Number of the line last returned
+    long malformed;   // Lines reported as malformed
+} LineReader;
+
+/**
+ * Open filename for line reading
+ */
+static bool reader_open(LineReader* reader, const char* filename) {
+    reader->file = fopen(filename, "rb");
+    if (!reader->file) {
+        fprintf(stderr, "Error: Could not open file %s\n", filename);
+        return false;
+    }
+    reader->filename = filename;
+    reader->capacity = READ_BLOCK;
+    reader->buffer = (char*)malloc(reader->capacity);
+    reader->start = 0;
+    reader->end = 0;
+    reader->at_eof = false;
+    reader->line_number = 0;
+    reader->malformed = 0;
+    return true;
+}
+
+/**
+ * Summarise malformed lines past the reporting limit
+ */
+static void report_total(const char* filename, long malformed) {
+    if (malformed > MAX_REPORTED) {
+        fprintf(stderr, "Warning: %s: %ld malformed lines skipped in total\n", filename, malformed);
+    }
+}
+
+/**
+ * Close the file and summarise any malformed lines
+ */
+static void reader_close(LineReader* reader) {
+    report_total(reader->filename, reader->malformed);
+    fclose(reader->file);
+    free(reader->buffer);
+}
+
+/**
+ * Report a skipped line (only the first MAX_REPORTED of a file are printed)
+ */
+static void report_line(const char* filename, long line_number, long* malformed,
+                        const char* problem, const char* detail) {
+    (*malformed)++;
+    if (*malformed <= MAX_REPORTED) {
+        fprintf(stderr, "Warning: %s:%ld: %s%s, line skipped\n", filename, line_number, problem, detail);
+    }
+}
+
+/**
+ * Report a skipped line at the reader's current position
+ */
+static void reader_report(LineReader* reader, const char* problem, const char* detail) {
+    report_line(reader->filename, reader->line_number, &reader->malformed, problem, detail);
+}
+
+/**
+ * Return the next line without its newline, NUL-terminated and writable
+ * The pointer is valid until the next call. Returns NULL at end of file.
+ */
+static char* reader_next(LineReader* reader) {
+    while (1) {
+        char* line = reader->buffer + reader->start;
+        char* newline = (char*)memchr(line, '\n', reader->end - reader->start);
+        if (newline) {
+            *newline = '\0';
+            reader->start = newline - reader->buffer + 1;
+            reader->line_number++;
+            return line;
+        }
+
+        if (reader->at_eof) {
+            if (reader->start == reader->end) return NULL;
+            // Last line has no newline; the spare byte holds its terminator
+            reader->buffer[reader->end] = '\0';
+            reader->start = reader->end;
+            reader->line_number++;
+            return line;
+        }
+
+        // Move the partial line to the front, growing if it fills the whole buffer
+        size_t pending = reader->end - reader->start;
+        memmove(reader->buffer, line, pending);
+        reader->start = 0;
+        reader->end = pending;
+        if (pending + 1 >= reader->capacity) {
+            reader->capacity *= 2;
+            reader->buffer = (char*)realloc(reader->buffer, reader->capacity);
+        }
+
+        size_t got = fread(reader->buffer + reader->end, 1, reader->capacity - reader->end - 1, reader->file);
+        reader->end += got;
+        if (got == 0) reader->at_eof = true;
+    }
+}
+
+/**
+ * Split off the next whitespace-separated token in place, NULL if none is left
+ */
+static char* next_token(char** cursor) {
+    char* p = *cursor;
+    while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\v' || *p == '\f') p++;
+    if (*p == '\0') {
+        *cursor = p;
+        return NULL;
+    }
+
+    char* token = p;
+    while (*p && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\v' && *p != '\f') p++;
+    if (*p) *p++ = '\0';
+    *cursor = p;
+    return token;
+}
+
+/**
+ * Parse a whole token as a distance: a decimal int, not negative, rejecting overflow
+ * Like the road command, a minus sign makes the line malformed.
+ */
+static bool parse_distance(const char* token, int* value) {
+    if (*token == '+') token++;
+    if (*token == '\0') return false;
+
+    long long result = 0;
+    for (; *token; token++) {
+        if (*token < '0' || *token > '9') return false;
+        result = result * 10 + (*token - '0');
+        if (result > INT_MAX) return false;
+    }
+    *value = (int)result;
+    return true;
+}
+
+/**
+ * Parse a whole token as a double
+ */
+static bool parse_double(const char* token, double* value) {
+    char* end;
+    *value = strtod(token, &end);
+    return end != token && *end == '\0';
+}
+
+// One parsed line of a distances file
+typedef struct Road {
+    int from;
+    int to;
+    int weight;
+} Road;
+
+// A skipped line, reported once its line number is known
+typedef struct BadLine {
+    long line;           // Line number within its chunk (1-based)
+    const char* problem;
+    const char* detail;  // Points into the file buffer
+} BadLine;
+
+// Parallel loading: one byte range of the file and what was parsed from it
+typedef struct LoadChunk {
+    size_t begin;        // First byte (start of a line)
+    size_t end;          // One past the last byte
+    long num_lines;      // Lines in the range
+    Road* roads;         // Roads in file order
+    int num_roads;
+    int roads_capacity;
+    BadLine* bad;        // Malformed lines in file order
+    int num_bad;
+    int bad_capacity;
+    int* cursor;         // Per vertex: roads counted, then the next free EdgeNode slot
+} LoadChunk;
+
+// Shared state of one parallel load
+typedef struct LoadJob {
+    Graph* graph;
+    char* text;          // Whole file, NUL-terminated
+    LoadChunk* chunks;
+    int num_chunks;
+    int num_vertices;
+    int* first;          // Per vertex: first new EdgeNode slot
+    EdgeNode* nodes;     // Every new directed edge, grouped by source vertex
+} LoadJob;
+
+/**
+ * Parse one distances line
+ * Returns 1 for a road, 0 for a blank line and -1 if malformed (problem and detail say why)
+ */
+static int parse_road(Graph* graph, char* line, Road* road, const char** problem, const char** detail) {
+    char* cursor = line;
+    char* city1 = next_token(&cursor);
+    if (!city1) return 0;  // Empty line
+    char* city2 = next_token(&cursor);
+    char* distance_text = next_token(&cursor);
+    
+    *detail = "";
+    if (!distance_text) {
+        *problem = "expected \"city1 city2 distance\"";
+        return -1;
+    }
+    if (!parse_distance(distance_text, &road->weight)) {
+        *problem = "bad distance ";
+        *detail = distance_text;
+        return -1;
+    }
+    
+    // Both cities must exist
+    road->from = graph_find_vertex(graph, city1);
+    road->to = graph_find_vertex(graph, city2);
+    if (road->from == -1 || road->to == -1) {
+        *problem = "unknown city ";
+        *detail = road->from == -1 ? city1 : city2;
+        return -1;
+    }
+    return 1;
+}
+
+/**
+ * Load vertices from file
+ * Each non-empty line is one city name (a trailing carriage return is dropped)
+ */
+bool load_vertices(Graph* graph, const char* filename) {
+    LineReader reader;
+    if (!reader_open(&reader, filename)) return false;
+    
+    char* line;
+    while ((line = reader_next(&reader))) {
+        size_t length = strlen(line);
+        if (length > 0 && line[length - 1] == '\r') line[--length] = '\0';
+        
+        // Skip empty lines
+        if (length == 0) continue;
+        
+        // Add city to graph
+        graph_add_vertex(graph, line);
+    }
+    
+    reader_close(&reader);
+    return true;
+}
+
+/**
+ * Load distances from file
+ * Each line is "city1 city2 distance"; anything after the distance is ignored.
+ * A road listed more than once keeps the last distance given.
+ */
+bool load_distances(Graph* graph, const char* filename) {
+    LineReader reader;
+    if (!reader_open(&reader, filename)) return false;
+    
+    char* line;
+    while ((line = reader_next(&reader))) {
+        Road road;
+        const char* problem;
+        const char* detail;
+        int status = parse_road(graph, line, &road, &problem, &detail);
+        if (status == -1) reader_report(&reader, problem, detail);
+        if (status != 1) continue;  // Skip empty and malformed lines
+        
+        // Add two way edge between cities (repeats are merged once the file is read)
+        graph_append_edge_index(graph, road.from, road.to, road.weight);
+    }
+    
+    graph_merge_parallel_edges(graph);
+    reader_close(&reader);
+    return true;
+}
+
+/**
+ * Worker task: parse the lines of one chunk and count roads per vertex
+ * Only name lookups touch the graph, so chunks can run concurrently.
+ */
+static void parse_chunk(void* context, int worker, int index) {
+    (void)worker;
+    LoadJob* job = (LoadJob*)context;
+    LoadChunk* chunk = &job->chunks[index];
+    chunk->cursor = (int*)calloc(job->num_vertices > 0 ? job->num_vertices : 1, sizeof(int));
+    
+    size_t at = chunk->begin;
+    while (at < chunk->end) {
+        char* line = job->text + at;
+        char* newline = (char*)memchr(line, '\n', chunk->end - at);
+        size_t next = newline ? (size_t)(newline - job->text) + 1 : chunk->end;
+        if (newline) *newline = '\0';
+        chunk->num_lines++;
+        
+        Road road;
+        const char* problem;
+        const char* detail;
+        int status = parse_road(job->graph, line, &road, &problem, &detail);
+        if (status == 1) {
+            if (chunk->num_roads == chunk->roads_capacity) {
+                chunk->roads_capacity = chunk->roads_capacity ? chunk->roads_capacity * 2 : 1024;
+                chunk->roads = (Road*)realloc(chunk->roads, sizeof(Road) * chunk->roads_capacity);
+            }
+            chunk->roads[chunk->num_roads++] = road;
+            chunk->cursor[road.from]++;
+            if (road.to != road.from) chunk->cursor[road.to]++;  // A self loop is one edge
+        } else if (status == -1) {
+            if (chunk->num_bad == chunk->bad_capacity) {
+                chunk->bad_capacity = chunk->bad_capacity ? chunk->bad_capacity * 2 : 16;
+                chunk->bad = (BadLine*)realloc(chunk->bad, sizeof(BadLine) * chunk->bad_capacity);
+            }
+            BadLine bad = {chunk->num_lines, problem, detail};
+            chunk->bad[chunk->num_bad++] = bad;
+        }
+        at = next;
+    }
+}
+
+/**
+ * Worker task: turn road counts into slot cursors for one block of vertices
+ * Chunk c's edges of vertex u go after those of chunks 0..c-1, which keeps file order.
+ */
+static void assign_slots(void* context, int worker, int index) {
+    (void)worker;
+    LoadJob* job = (LoadJob*)context;
+    int block = (job->num_vertices + job->num_chunks - 1) / job->num_chunks;
+    int last = (index + 1) * block < job->num_vertices ? (index + 1) * block : job->num_vertices;
+    
+    for (int u = index * block; u < last; u++) {
+        int slot = job->first[u];
+        for (int c = 0; c < job->num_chunks; c++) {
+            int count = job->chunks[c].cursor[u];
+            job->chunks[c].cursor[u] = slot;
+            slot += count;
+        }
+    }
+}
+
+/**
+ * Worker task: write the directed edges of one chunk into their slots
+ * Same order as graph_append_edge_index: from -> to, then to -> from
+ * unless the road is a self loop.
+ */
+static void scatter_chunk(void* context, int worker, int index) {
+    (void)worker;
+    LoadJob* job = (LoadJob*)context;
+    LoadChunk* chunk = &job->chunks[index];
+    
+    for (int r = 0; r < chunk->num_roads; r++) {
+        const Road* road = &chunk->roads[r];
+        EdgeNode* forward = &job->nodes[chunk->cursor[road->from]++];
+        forward->dest = road->to;
+        forward->weight = road->weight;
+        if (road->to == road->from) continue;
+        EdgeNode* backward = &job->nodes[chunk->cursor[road->to]++];
+        backward->dest = road->from;
+        backward->weight = road->weight;
+    }
+}
+
+/**
+ * Worker task: chain one block of vertices' new edges in front of their old lists
+ * graph_append_edge_index pushes at the head, so the last edge in file order comes first.
+ */
+static void link_lists(void* context, int worker, int index) {
+    (void)worker;
+    LoadJob* job = (LoadJob*)context;
+    int block = (job->num_vertices + job->num_chunks - 1) / job->num_chunks;
+    int last = (index + 1) * block < job->num_vertices ? (index + 1) * block : job->num_vertices;
+    
+    for (int u = index * block; u < last; u++) {
+        EdgeNode* head = job->graph->vertices[u].edges;
+        for (int slot = job->first[u]; slot < job->first[u + 1]; slot++) {
+            job->nodes[slot].next = head;
+            head = &job->nodes[slot];
+        }
+        job->graph->vertices[u].edges = head;
+    }
+}
+
+/**
+ * Load distances on num_threads threads
+ * The file is read whole, split into byte ranges at line starts, parsed in
+ * parallel, then merged with a counting sort by vertex into one block of
+ * edge nodes. The result (list order included) matches load_distances.
+ */
+bool load_distances_parallel(Graph* graph, const char* filename, int num_threads) {
+    FILE* file = fopen(filename, "rb");
+    if (!file) {
+        fprintf(stderr, "Error: Could not open file %s\n", filename);
+        return false;
+    }
+    if (graph_is_read_only(graph)) {
+        fprintf(stderr, "Error: Cannot load %s, graph snapshot is read-only\n", filename);
+        fclose(file);
+        return false;
+    }
+    
+    // Read the whole file (one terminator byte after it)
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    rewind(file);
+    size_t size = length > 0 ? (size_t)length : 0;
+    char* text = (char*)malloc(size + 1);
+    if (!text || fread(text, 1, size, file) != size) {
+        fprintf(stderr, "Error: Could not read file %s\n", filename);
+        free(text);
+        fclose(file);
+        return false;
+    }
+    fclose(file);
+    text[size] = '\0';
+    
+    if (num_threads < 1) num_threads = 1;
+    int n = graph->num_vertices;
+    LoadJob job;
+    job.graph = graph;
+    job.text = text;
+    job.num_chunks = num_threads;
+    job.num_vertices = n;
+    job.chunks = (LoadChunk*)calloc(num_threads, sizeof(LoadChunk));
+    
+    // Byte ranges; each boundary moves forward to the start of a line
+    size_t at = 0;
+    for (int c = 0; c < num_threads; c++) {
+        size_t end = size * (c + 1) / num_threads;
+        if (end < at) end = at;
+        if (end > 0 && end < size && text[end - 1] != '\n') {
+            char* newline = (char*)memchr(text + end, '\n', size - end);
+            end = newline ? (size_t)(newline - text) + 1 : size;
+        }
+        job.chunks[c].begin = at;
+        job.chunks[c].end = end;
+        at = end;
+    }
+    
+    parallel_for(num_threads, num_threads, parse_chunk, &job);
+    
+    // Report malformed lines in file order, numbering lines across chunks
+    long malformed = 0;
+    long lines_before = 0;
+    for (int c = 0; c < num_threads; c++) {
+        for (int b = 0; b < job.chunks[c].num_bad; b++) {
+            const BadLine* bad = &job.chunks[c].bad[b];
+            report_line(filename, lines_before + bad->line, &malformed, bad->problem, bad->detail);
+        }
+        lines_before += job.chunks[c].num_lines;
+    }
+    report_total(filename, malformed);
+    
+    // Prefix sum of per-vertex totals gives each vertex its run of slots
+    job.first = (int*)malloc(sizeof(int) * (n + 1));
+    long total = 0;
+    for (int u = 0; u < n; u++) {
+        job.first[u] = (int)total;
+        for (int c = 0; c < num_threads; c++) total += job.chunks[c].cursor[u];
+    }
+    job.first[n] = (int)total;
+    
+    if (total > 0) {
+        graph_thaw(graph);  // The frozen layout is out of date once edges are added
+        graph->version++;
+        job.nodes = (EdgeNode*)arena_alloc(graph->arena, sizeof(EdgeNode) * total);
+        parallel_for(num_threads, num_threads, assign_slots, &job);
+        parallel_for(num_threads, num_threads, scatter_chunk, &job);
+        parallel_for(num_threads, num_threads, link_lists, &job);
+        graph_merge_parallel_edges(graph);  // Same merge as load_distances
+        graph_rebuild_components(graph);    // Roads were linked in directly, not added one by one
+    }
+    
+    for (int c = 0; c < num_threads; c++) {
+        free(job.chunks[c].roads);
+        free(job.chunks[c].bad);
+        free(job.chunks[c].cursor);
+    }
+    free(job.chunks);
+    free(job.first);
+    free(text);
+    return true;
+}
+
+/**
+ * Load city coordinates from file
+ * Each line is "city latitude longitude" in degrees
+ */
+bool load_coordinates(Graph* graph, const char* filename) {
+    LineReader reader;
+    if (!reader_open(&reader, filename)) return false;
+    
+    char* line;
+    while ((line = reader_next(&reader))) {
+        char* cursor = line;
+        char* city = next_token(&cursor);
+        if (!city) continue;  // Skip empty lines
+        char* latitude_text = next_token(&cursor);
+        char* longitude_text = next_token(&cursor);
+        
+        double latitude, longitude;
+        if (!latitude_text || !longitude_text || !parse_double(latitude_text, &latitude) ||
+            !parse_double(longitude_text, &longitude)) {
+            reader_report(&reader, "expected \"city latitude longitude\"", "");
+            continue;
+        }
+        
+        int idx = graph_find_vertex(graph, city);
+        if (idx == -1) {
+            reader_report(&reader, "unknown city ", city);
+            continue;
+        }
+        graph_set_coordinates(graph, idx, latitude, longitude);
+    }
+    
+    reader_close(&reader);
+    return true;
+}
@@ -0,0 +1,20 @@
+/**
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * CS 5008
+ * Loading cities and distances from text files into a graph
+ */
+
+#ifndef LOADER_H
+#define LOADER_H
+
+#include "graph.h"
+#include <stdbool.h>
+
+// File loading operations
+bool load_vertices(Graph* graph, const char* filename);
+bool load_distances(Graph* graph, const char* filename);
+bool load_distances_parallel(Graph* graph, const char* filename, int num_threads);
+bool load_coordinates(Graph* graph, const char* filename);
+
+#endif
@@ -0,0 +1,250 @@
+/**
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * CS 5008
+ * Load generator for the route server (map.out --serve)
+ *
+ * Each client thread opens one connection and sends random city pairs,
+ * keeping up to `pipeline` requests in flight, and times every request from
+ * the moment it is written to the moment its answer line arrives. At the end
+ * the throughput and the latency distribution over all clients are printed.
+ *
+ * Usage: ./loadgen.out <socket> <vertices> [--clients n] [--queries n per client]
+ *                      [--pipeline depth] [--seed n]
+ */
+
+#define _POSIX_C_SOURCE 200809L // For clock_gettime, getline, fdopen
+
+// Project Headers
+#include "graph.h"
+#include "loader.h"
+#include "profile.h"
+
+// Standard Libraries
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#define DEFAULT_CLIENTS 4       // Concurrent connections
+#define DEFAULT_QUERIES 10000   // Requests per client
+#define DEFAULT_PIPELINE 1      // Requests in flight per client (1 = wait for each answer)
+#define LOADGEN_SEED 5008       // Fixed seed so runs are reproducible
+
+// One client connection and what it measured
+typedef struct Client {
+    int id;
+    const char* socket_path;
+    const Graph* graph;       // City names to pick from
+    int queries;
+    int pipeline;
+    uint64_t random;          // xorshift64 state
+    LatencyHistogram latency; // Write-to-answer time of each request
+    long ok;                  // Routes found
+    long none;                // No route between the pair
+    long errors;              // ERROR answers
+    bool failed;              // Connection could not be made or broke off
+    bool started;             // Thread was created
+    pthread_t thread;
+} Client;
+
+/**
+ * xorshift64 pseudo random number generator
+ */
+static uint64_t next_random(uint64_t* state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+/**
+ * Write a whole buffer to a blocking socket
+ */
+static bool write_all(int fd, const char* data, size_t length) {
+    while (length > 0) {
+        ssize_t sent = send(fd, data, length, MSG_NOSIGNAL);
+        if (sent <= 0) return false;
+        data += sent;
+        length -= (size_t)sent;
+    }
+    return true;
+}
+
+/**
+ * Connect to the server's socket, -1 on failure
+ */
+static int connect_server(const char* socket_path) {
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, socket_path, sizeof(address.sun_path) - 1);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd >= 0 && connect(fd, (struct sockaddr*)&address, sizeof(address)) != 0) {
+        close(fd);
+        fd = -1;
+    }
+    return fd;
+}
+
+/**
+ * Client thread: keep the pipeline full until every request is answered
+ */
+static void* run_client(void* arg) {
+    Client* client = (Client*)arg;
+    int fd = connect_server(client->socket_path);
+    FILE* in = fd >= 0 ? fdopen(fd, "r") : NULL;
+    if (!in) {
+        if (fd >= 0) close(fd);
+        client->failed = true;
+        return NULL;
+    }
+
+    int n = client->graph->num_vertices;
+    double* sent_at = (double*)malloc(sizeof(double) * client->pipeline);  // Ring indexed by request number
+    size_t request_capacity = 1024;
+    char* requests = (char*)malloc(request_capacity);
+    char* line = NULL;
+    size_t line_capacity = 0;
+    int sent = 0, received = 0;
+
+    while (received < client->queries) {
+        // Top the pipeline up with one write
+        size_t length = 0;
+        double now = profile_now();
+        while (sent < client->queries && sent - received < client->pipeline) {
+            const char* a = client->graph->vertices[next_random(&client->random) % (uint64_t)n].name;
+            const char* b = client->graph->vertices[next_random(&client->random) % (uint64_t)n].name;
+            size_t needed = strlen(a) + strlen(b) + 2;
+            if (length + needed > request_capacity) {
+                while (length + needed > request_capacity) request_capacity *= 2;
+                requests = (char*)realloc(requests, request_capacity);
+            }
+            length += (size_t)sprintf(requests + length, "%s %s\n", a, b);
+            sent_at[sent % client->pipeline] = now;
+            sent++;
+        }
+        if (length > 0 && !write_all(fd, requests, length)) {
+            client->failed = true;
+            break;
+        }
+
+        // Answers come back in request order
+        if (getline(&line, &line_capacity, in) < 0) {
+            client->failed = true;
+            break;
+        }
+        latency_record(&client->latency, profile_now() - sent_at[received % client->pipeline], 0);
+        if (strncmp(line, "OK", 2) == 0) client->ok++;
+        else if (strncmp(line, "NONE", 4) == 0) client->none++;
+        else client->errors++;
+        received++;
+    }
+
+    if (!client->failed) write_all(fd, "quit\n", 5);
+    fclose(in);  // Closes fd
+    free(line);
+    free(requests);
+    free(sent_at);
+    return NULL;
+}
+
+/**
+ * Print command line usage
+ */
+static void print_usage(const char* program) {
+    fprintf(stderr, "Usage: %s <socket> <vertices> [--clients n] [--queries n] [--pipeline depth] [--seed n]\n",
+            program);
+}
+
+/**
+ * Load generator entry point
+ */
+int main(int argc, char* argv[]) {
+    const char* positional[2];
+    int num_positional = 0;
+    int num_clients = DEFAULT_CLIENTS;
+    int queries = DEFAULT_QUERIES;
+    int pipeline = DEFAULT_PIPELINE;
+    uint64_t seed = LOADGEN_SEED;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--clients") == 0 && i + 1 < argc) {
+            num_clients = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--queries") == 0 && i + 1 < argc) {
+            queries = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--pipeline") == 0 && i + 1 < argc) {
+            pipeline = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = strtoull(argv[++i], NULL, 10);
+        } else if (argv[i][0] != '-' && num_positional < 2) {
+            positional[num_positional++] = argv[i];
+        } else {
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+    if (num_positional != 2 || num_clients < 1 || queries < 1 || pipeline < 1) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    // Only the names are needed, so the distances file is not read
+    Graph* graph = graph_create(50);
+    if (!load_vertices(graph, positional[1]) || graph->num_vertices == 0) {
+        fprintf(stderr, "Error: No cities in %s\n", positional[1]);
+        graph_destroy(graph);
+        return 1;
+    }
+
+    Client* clients = (Client*)calloc(num_clients, sizeof(Client));
+    double begin = profile_now();
+    for (int c = 0; c < num_clients; c++) {
+        Client* client = &clients[c];
+        client->id = c;
+        client->socket_path = positional[0];
+        client->graph = graph;
+        client->queries = queries;
+        client->pipeline = pipeline;
+        client->random = (seed + 1) * 0x9E3779B97F4A7C15ULL ^ (uint64_t)(c + 1);
+        latency_clear(&client->latency);
+        client->started = pthread_create(&client->thread, NULL, run_client, client) == 0;
+        if (!client->started) client->failed = true;
+    }
+
+    LatencyHistogram latency;
+    latency_clear(&latency);
+    long ok = 0, none = 0, errors = 0;
+    int failed = 0;
+    for (int c = 0; c < num_clients; c++) {
+        Client* client = &clients[c];
+        if (client->started) pthread_join(client->thread, NULL);
+        latency_merge(&latency, &client->latency);
+        ok += client->ok;
+        none += client->none;
+        errors += client->errors;
+        if (client->failed) failed++;
+    }
+    double seconds = profile_now() - begin;
+
+    printf("%ld requests from %d client%s (pipeline %d) in %.3f s: %.0f requests/s\n", latency.total,
+           num_clients, num_clients == 1 ? "" : "s", pipeline, seconds, seconds > 0 ? latency.total / seconds : 0.0);
+    if (latency.total > 0) {
+        printf("Latency (us): mean %.1f, p50 %.1f, p90 %.1f, p99 %.1f, p99.9 %.1f, max %.1f\n",
+               latency.sum_seconds / latency.total * 1e6, latency_percentile(&latency, 0.5) * 1e6,
+               latency_percentile(&latency, 0.9) * 1e6, latency_percentile(&latency, 0.99) * 1e6,
+               latency_percentile(&latency, 0.999) * 1e6, latency.max_seconds * 1e6);
+    }
+    printf("Answers: %ld routes, %ld without a route, %ld errors\n", ok, none, errors);
+    if (failed > 0) fprintf(stderr, "Error: %d client%s could not finish (is the server running?)\n", failed,
+                            failed == 1 ? "" : "s");
+
+    free(clients);
+    graph_destroy(graph);
+    return failed > 0 ? 1 : 0;
+}
@@ -1,16 +1,49 @@
+#define _POSIX_C_SOURCE 200809L // For sigaction
+
 #include "graph.h"
 #include "dijkstra.h"
+#include "loader.h"
+#include "astar.h"
+#include "ch.h"
+#include "batch.h"
+#include "parallel.h"
+#include "snapshot.h"
+#include "cache.h"
+#include "profile.h"
+#include "reorder.h"
+#include "server.h"
+#include "apsp.h"
+#include "compact.h"
+#include <limits.h>
+#include <signal.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 // Constants for program configuration
-#define MAX_LINE 256               // Maximum line length for file reading
-#define MAX_CITY_NAME 100          // Maximum length for city name
+#define MAX_LINE 256               // Maximum length of a command line
 #define INITIAL_GRAPH_CAPACITY 50  // Starting capacity for graph
 #define SUCCESS 0                  // Return code for success
 #define ERROR 1                    // Return code for error
-#define EXPECTED_ARGS 3            // Expected command line arguments
+#define EXPECTED_FILES 2           // Expected positional arguments (vertices, distances)
+#define BATCH_OUTPUT_BUFFER (1 << 16) // stdout buffer size in batch mode
+
+// State shared by every query in a run
+typedef struct Session {
+    Graph* graph;            // Cities and roads
+    DijkstraWorkspace* ws;   // Search state reused across queries
+    DijkstraWorkspace* backward_ws; // Second workspace for hierarchy queries
+    Heuristic* heuristic;    // A* lower bounds, NULL for plain Dijkstra
+    ContractionHierarchy* ch; // Preprocessed hierarchy, NULL unless --ch
+    AllPairsTable* apsp;     // Every distance precomputed, NULL unless --apsp
+    CompactGraph* compact;   // Packed adjacency searched instead of the CSR, NULL unless --compact
+    RouteEngine engine;      // Read-only view of the above, shared with batch workers
+    RouteCache* cache;       // Recent answers for the interactive prompt
+    ShortestPathTree* tree;  // Tree from the last origin (plain Dijkstra only)
+    bool interactive;        // Prompt mode: show help after a bad command
+    LatencyHistogram latency; // Time to answer each query (cache hits included)
+    SearchCounters retired;  // Counters of workspaces already freed (batch workers)
+} Session;
 
 /**
  * Print welcome message
@@ -19,71 +52,185 @@ void print_help() {
     printf("Commands:\n");
     printf("  list - list all cities\n");
     printf("  <city1> <city2> - find the shortest path between two cities\n");
+    printf("  road <city1> <city2> <distance> - add a road or change its distance\n");
+    printf("  close <city1> <city2> - remove the road between two cities\n");
+    printf("  stats [json] - show cache, latency and search statistics\n");
     printf("  help - print this help message\n");
     printf("  exit - exit the program\n");
 }
 
 /**
- * Load vertices from file
+ * Print command line usage
  */
-bool load_vertices(Graph* graph, const char* filename) {
-    FILE* file = fopen(filename, "r");
+void print_usage(const char* program) {
+    fprintf(stderr, "Usage: %s <vertices> <distances> [--coords <file>] [--landmarks <count>] [--ch]\n"
+                    "       [--batch <queries> | --stream <commands>] [--threads <count>] [--cache <entries>]\n"
+                    "       [--profile <json file>] [--reorder <bfs|hilbert>] [--serve <socket>] [--buckets]\n"
+                    "       [--apsp] [--compact]\n"
+                    "       %s --compile <vertices> <distances> <snapshot> [--coords <file>] [--reorder <bfs|hilbert>]\n"
+                    "       %s --snapshot <snapshot> [options]\n",
+            program, program, program);
+}
+
+/**
+ * Answer one prompt query
+ * Plain Dijkstra keeps the tree from the last origin, so asking for several
+ * destinations from the same city continues one search instead of restarting
+ * (unless --buckets asked for the bucket queue, which searches each query afresh).
+ * With --apsp every answer is read from the all-pairs table instead, and with
+ * --compact searches decode the packed adjacency, so the CSR is never rebuilt.
+ */
+PathResult find_route(Session* session, int start, int end) {
+    if (!session->compact) graph_freeze(session->graph);  // Rebuilt here, once, after roads were added or closed
+    if (session->apsp || session->ch || session->heuristic || session->compact || session->engine.buckets) {
+        return route_find(&session->engine, session->ws, session->backward_ws, start, end);
+    }
+    if (session->tree->origin != start) path_tree_reset(session->tree, start);
+    return path_tree_path(session->tree, end);
+}
+
+/**
+ * Search counters of every workspace the session has used
+ */
+SearchCounters session_counters(const Session* session) {
+    SearchCounters total = session->retired;
+    search_counters_add(&total, &session->ws->counters);
+    search_counters_add(&total, &session->backward_ws->counters);
+    search_counters_add(&total, &session->tree->ws->counters);
+    return total;
+}
+
+/**
+ * Print the statistics, as text or (with "json") as one JSON object
+ */
+void print_stats(const Session* session, bool json) {
+    SearchCounters search = session_counters(session);
+    if (json) {
+        profile_print_json(stdout, &session->latency, &search, &session->graph->counters);
+        return;
+    }
+    route_cache_print_stats(session->cache, stdout);
+    profile_print(stdout, &session->latency, &search, &session->graph->counters);
+}
+
+/**
+ * Write the statistics as JSON to a file when the run ends
+ */
+bool write_profile(const Session* session, const char* filename) {
+    FILE* file = fopen(filename, "w");
     if (!file) {
-        fprintf(stderr, "Error: Could not open file %s\n", filename);
+        fprintf(stderr, "Error: Cannot open file %s\n", filename);
         return false;
     }
+    SearchCounters search = session_counters(session);
+    profile_print_json(file, &session->latency, &search, &session->graph->counters);
+    fclose(file);
+    return true;
+}
+
+/**
+ * Report a command that could not be understood
+ */
+void invalid_command(const Session* session) {
+    printf("Invalid Command\n");
+    if (session->interactive) print_help();
+}
+
+/**
+ * Add, change (weight >= 0) or close (remove) a road and repair what depends on it
+ * Returns false if the graph refused the change
+ */
+bool change_road(Session* session, int from, int to, bool remove, int weight) {
+    Graph* graph = session->graph;
+    RoadChange change;
+    change.from = from;
+    change.to = to;
+    change.old_weight = 0;
+    change.existed = graph_find_edge(graph, from, to, &change.old_weight);
+    change.exists = !remove;
+    change.new_weight = weight;
     
-    char line[MAX_LINE];
-    // Read file line by line
-    while (fgets(line, sizeof(line), file)) {
-        // Remove newline character at end
-        line[strcspn(line, "\n")] = 0;
-        
-        // Skip empty lines
-        if (strlen(line) == 0) continue;
-        
-        // Add city to graph
-        graph_add_vertex(graph, line);
-    }
+    bool changed = remove ? graph_remove_edge_index(graph, from, to) : graph_add_edge_index(graph, from, to, weight);
+    if (!changed) return false;
     
-    fclose(file);
+    route_cache_repair(session->cache, graph, &change);
+    path_tree_repair(session->tree, &change);
+    if (session->heuristic) heuristic_repair(session->heuristic, graph, &change);
+    
+    // Shortcuts were only checked against the old weights; fall back to A* or Dijkstra
+    if (session->ch) {
+        fprintf(stderr, "Note: road network changed, contraction hierarchy dropped\n");
+        ch_destroy(session->ch);
+        session->ch = NULL;
+        session->engine.ch = NULL;
+    }
+    if (session->apsp) {
+        fprintf(stderr, "Note: road network changed, all-pairs table dropped\n");
+        apsp_destroy(session->apsp);
+        session->apsp = NULL;
+        session->engine.apsp = NULL;
+    }
     return true;
 }
 
 /**
- * Load distances from file
+ * Put back the adjacency lists --compact released, and drop the packed copy
+ * Road commands look up and edit the lists; plain searches go back to the
+ * CSR, rebuilt on the next query.
  */
-bool load_distances(Graph* graph, const char* filename) {
-    FILE* file = fopen(filename, "r");
-    if (!file) {
-        fprintf(stderr, "Error: Could not open file %s\n", filename);
-        return false;
+void drop_compact(Session* session) {
+    fprintf(stderr, "Note: road network changing, compact adjacency dropped\n");
+    compact_restore_edges(session->compact, session->graph);
+    compact_destroy(session->compact);
+    session->compact = NULL;
+    session->engine.compact = NULL;
+    session->engine.heuristic = session->heuristic;  // A* has its lists again
+}
+
+/**
+ * Handle "road <city1> <city2> <distance>" and "close <city1> <city2>"
+ */
+void process_road_command(Session* session, bool remove) {
+    Graph* graph = session->graph;
+    char* city1 = strtok(NULL, " \t\n\r");
+    char* city2 = strtok(NULL, " \t\n\r");
+    char* distance = remove ? NULL : strtok(NULL, " \t\n\r");
+    int from = city1 ? graph_find_vertex(graph, city1) : -1;
+    int to = city2 ? graph_find_vertex(graph, city2) : -1;
+    
+    // Distances must be whole, non-negative numbers
+    long weight = 0;
+    if (distance) {
+        char* end;
+        weight = strtol(distance, &end, 10);
+        if (*end != '\0' || weight < 0 || weight > INT_MAX) distance = NULL;
+    }
+    if (from == -1 || to == -1 || (!remove && !distance)) {
+        invalid_command(session);
+        return;
     }
     
-    char line[MAX_LINE];
-    // Read file line by line
-    while (fgets(line, sizeof(line), file)) {
-        char city1[MAX_CITY_NAME], city2[MAX_CITY_NAME];
-        int distance;
-        
-
-        int parsed = sscanf(line, "%s %s %d", city1, city2, &distance); // Parse line
-        
-        // Skip invalid lines
-        if (parsed != 3) continue;
-        
-        // Add two way edge between cities
-        graph_add_edge(graph, city1, city2, distance);
+    if (session->compact && !graph_is_read_only(graph)) drop_compact(session);  // Roads only live in the packed copy
+    
+    int old_weight;
+    bool existed = graph_find_edge(graph, from, to, &old_weight);
+    if (remove && !existed) {
+        printf("No road between %s and %s\n", city1, city2);
+        return;
     }
+    if (!change_road(session, from, to, remove, (int)weight) || !session->interactive) return;
     
-    fclose(file);
-    return true;
+    if (remove) printf("Closed road %s - %s\n", city1, city2);
+    else if (existed) printf("Road %s - %s: %d (was %d)\n", city1, city2, (int)weight, old_weight);
+    else printf("Added road %s - %s: %d\n", city1, city2, (int)weight);
 }
 
 /**
  * Process user command
  */
-bool process_command(Graph* graph, char* input) {
+bool process_command(Session* session, char* input) {
+    Graph* graph = session->graph;
+    
     // Tokenize input
     char* token1 = strtok(input, " \t\n\r"); 
     if (!token1) return true;  // Continue if empty input
@@ -98,14 +245,20 @@ bool process_command(Graph* graph, char* input) {
     else if (strcmp(token1, "list") == 0) {
         graph_print_vertices(graph);  // Display all cities
     }
+    else if (strcmp(token1, "stats") == 0) {
+        char* format = strtok(NULL, " \t\n\r");
+        print_stats(session, format && strcmp(format, "json") == 0);
+    }
+    else if (strcmp(token1, "road") == 0 || strcmp(token1, "close") == 0) {
+        process_road_command(session, strcmp(token1, "close") == 0);
+    }
     else {
         // Parse two city names
         char* token2 = strtok(NULL, " \t\n\r");  
         
         // If no second token, invalid command
         if (!token2) {
-            printf("Invalid Command\n");
-            print_help();
+            invalid_command(session);
             return true;
         }
         
@@ -115,32 +268,22 @@ bool process_command(Graph* graph, char* input) {
         
         // Both cities must exist
         if (start == -1 || end == -1) {
-            printf("Invalid Command\n");
-            print_help();
+            invalid_command(session);
             return true;
         }
         
-        // Find shortest path using Dijkstra's algorithm
-        PathResult result = dijkstra_shortest_path(graph, start, end);
-        
-        if (result.found) {
-            // Path exists - print it
-            printf("Path Found...\n");
-            printf("\t");  
-            
-            // Print each city in path
-            for (int i = 0; i < result.path_length; i++) {
-                printf("%s", graph->vertices[result.path[i]].name);
-                if (i < result.path_length - 1) printf(" ");  // Space between cities
-            }
-            printf("\n");
-            
-            // Print total distance
-            printf("\tTotal Distance: %d\n", result.total_distance);
-        } else {
-            // No path exists between cities
-            printf("Path Not Found...\n");
+        // Find shortest path (Dijkstra's algorithm, or A* when a heuristic is loaded),
+        // unless the pair was asked recently or the cities are in different components
+        PROFILE_START(begin);
+        PathResult result;
+        if (!graph_same_component(graph, start, end)) {
+            result = path_result_unreachable();  // Nothing to search, so nothing worth caching
+        } else if (!route_cache_lookup(session->cache, graph, start, end, &result)) {
+            result = find_route(session, start, end);
+            route_cache_store(session->cache, graph, start, end, &result);
         }
+        PROFILE_RECORD(&session->latency, begin, result.settled);
+        route_print(stdout, graph, &result);
         
         // Free path memory
         path_result_destroy(&result);
@@ -150,30 +293,297 @@ bool process_command(Graph* graph, char* input) {
 }
 
 /**
- * Main function
+ * Answer every query in a batch file on stdout, then report throughput on stderr
  */
-int main(int argc, char* argv[]) {
-    // CLI argument check
-    if (argc != EXPECTED_ARGS) {
-        fprintf(stderr, "Usage: %s <vertices> <distances>\n", argv[0]);
+int run_batch(Session* session, const char* filename, int num_threads) {
+    FILE* file = fopen(filename, "r");
+    if (!file) {
+        fprintf(stderr, "Error: Cannot open file %s\n", filename);
+        return ERROR;
+    }
+    // Nothing has been written to stdout yet, so its buffer can still be resized
+    setvbuf(stdout, NULL, _IOFBF, BATCH_OUTPUT_BUFFER);
+    
+    BatchStats stats;
+    bool ok = batch_run(&session->engine, file, stdout, num_threads, &stats);
+    fclose(file);
+    if (!ok) return ERROR;
+    latency_merge(&session->latency, &stats.latency);
+    search_counters_add(&session->retired, &stats.search);
+    
+    fprintf(stderr, "%d queries (%d invalid) in %.3f s on %d thread%s: %.0f queries/s\n",
+            stats.queries, stats.invalid, stats.seconds, num_threads, num_threads == 1 ? "" : "s",
+            stats.seconds > 0 ? stats.queries / stats.seconds : 0.0);
+    if (PROFILE_ENABLED && stats.latency.total > 0) {
+        fprintf(stderr, "Search latency: p50 %.1f us, p99 %.1f us, max %.1f us\n",
+                latency_percentile(&stats.latency, 0.5) * 1e6, latency_percentile(&stats.latency, 0.99) * 1e6,
+                stats.latency.max_seconds * 1e6);
+    }
+    return SUCCESS;
+}
+
+/**
+ * Run prompt commands from a file ("-" for stdin) without prompts, in order
+ * Road changes take effect for every query after them, so live closures and
+ * congestion updates can be fed in alongside the queries.
+ */
+int run_stream(Session* session, const char* filename) {
+    FILE* file = strcmp(filename, "-") == 0 ? stdin : fopen(filename, "r");
+    if (!file) {
+        fprintf(stderr, "Error: Cannot open file %s\n", filename);
         return ERROR;
     }
     
+    session->interactive = false;
+    char input[MAX_LINE];
+    while (fgets(input, sizeof(input), file) && process_command(session, input)) {
+        // Each line is handled by process_command
+    }
+    
+    if (file != stdin) fclose(file);
+    return SUCCESS;
+}
+
+// Server being run by run_server, for the signal handler
+static Server* active_server = NULL;
+
+/**
+ * SIGINT/SIGTERM handler: let the server finish and clean up
+ */
+void stop_server(int signal_number) {
+    (void)signal_number;
+    if (active_server) server_stop(active_server);
+}
+
+/**
+ * Serve route queries on a Unix socket until interrupted, then report totals on stderr
+ */
+int run_server(Session* session, const char* socket_path, int num_threads) {
+    Server* server = server_create(&session->engine, socket_path, num_threads);
+    if (!server) return ERROR;
+    
+    active_server = server;
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = stop_server;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+    
+    fprintf(stderr, "Serving %d cities on %s with %d worker%s (Ctrl-C to stop)\n", session->graph->num_vertices,
+            socket_path, num_threads, num_threads == 1 ? "" : "s");
+    bool ok = server_run(server);
+    
+    ServerStats stats;
+    server_destroy(server, &stats);
+    active_server = NULL;
+    latency_merge(&session->latency, &stats.latency);
+    search_counters_add(&session->retired, &stats.search);
+    
+    fprintf(stderr, "%ld queries (%ld invalid) from %ld connection%s in %.3f s\n", stats.queries, stats.invalid,
+            stats.connections, stats.connections == 1 ? "" : "s", stats.seconds);
+    if (PROFILE_ENABLED && stats.latency.total > 0) {
+        fprintf(stderr, "Search latency: p50 %.1f us, p99 %.1f us, max %.1f us\n",
+                latency_percentile(&stats.latency, 0.5) * 1e6, latency_percentile(&stats.latency, 0.99) * 1e6,
+                stats.latency.max_seconds * 1e6);
+    }
+    return ok ? SUCCESS : ERROR;
+}
+
+/**
+ * Free everything a session owns, including the graph
+ */
+void free_session(Session* session) {
+    route_cache_destroy(session->cache);
+    path_tree_destroy(session->tree);
+    ch_destroy(session->ch);
+    apsp_destroy(session->apsp);
+    compact_destroy(session->compact);
+    heuristic_destroy(session->heuristic);
+    dijkstra_workspace_destroy(session->ws);
+    dijkstra_workspace_destroy(session->backward_ws);
+    graph_destroy(session->graph);
+}
+
+/**
+ * Build a graph from the text files (and optional coordinates), renumbered in the given order
+ * Returns NULL if any file fails to load
+ */
+Graph* load_text_graph(const char* vertices_file, const char* distances_file, const char* coords_file,
+                       int num_threads, VertexOrder order) {
     // Create graph
     Graph* graph = graph_create(INITIAL_GRAPH_CAPACITY);
     
-    // Load vertices
-    if (!load_vertices(graph, argv[1])) {
+    // Load vertices, distances and coordinates
+    if (!load_vertices(graph, vertices_file) || !load_distances_parallel(graph, distances_file, num_threads) ||
+        (coords_file && !load_coordinates(graph, coords_file))) {
         graph_destroy(graph);  // Clean up on error
-        return ERROR;
+        return NULL;
     }
     
-    // Load distances
-    if (!load_distances(graph, argv[2])) {
-        graph_destroy(graph);  // Clean up on error
+    // Renumber neighbours close together before the CSR is laid out
+    if (order == ORDER_HILBERT && !graph_has_coordinates(graph)) {
+        fprintf(stderr, "Warning: not every city has coordinates, using BFS order\n");
+        order = ORDER_BFS;
+    }
+    if (!reorder_graph(graph, order)) {
+        graph_destroy(graph);
+        return NULL;
+    }
+    
+    // The graph is read-only from here on, so switch to the contiguous layout
+    graph_freeze(graph);
+    return graph;
+}
+
+/**
+ * Main function
+ */
+int main(int argc, char* argv[]) {
+    const char* files[EXPECTED_FILES + 1];  // Vertices, distances and (with --compile) the output
+    int num_files = 0;
+    const char* coords_file = NULL;     // Optional city coordinates
+    int num_landmarks = 0;              // ALT landmarks, 0 = not requested
+    bool use_ch = false;                // Preprocess a contraction hierarchy
+    const char* batch_file = NULL;      // Answer queries from a file instead of the prompt
+    const char* stream_file = NULL;     // Run queries and road changes from a file, in order
+    const char* socket_path = NULL;     // Serve queries on this Unix socket
+    const char* profile_file = NULL;    // Write the statistics here as JSON on exit
+    int num_threads = 0;                // Loading and batch worker threads, 0 = one per processor
+    bool compile = false;               // Write a snapshot and exit
+    const char* snapshot_file = NULL;   // Serve a compiled snapshot instead of the text files
+    int cache_entries = DEFAULT_CACHE_ENTRIES; // Answers kept for repeated queries, 0 = no cache
+    VertexOrder order = ORDER_FILE;     // Renumber cities for locality after loading
+    bool bad_order = false;             // --reorder given an unknown order
+    bool use_buckets = false;           // Plain Dijkstra on the bucket queue instead of the heap
+    bool use_apsp = false;              // Precompute every distance (small graphs only)
+    bool use_compact = false;           // Search a packed adjacency and free the lists and CSR
+    
+    // CLI argument check
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--coords") == 0 && i + 1 < argc) {
+            coords_file = argv[++i];
+        } else if (strcmp(argv[i], "--landmarks") == 0 && i + 1 < argc) {
+            num_landmarks = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--ch") == 0) {
+            use_ch = true;
+        } else if (strcmp(argv[i], "--buckets") == 0) {
+            use_buckets = true;
+        } else if (strcmp(argv[i], "--apsp") == 0) {
+            use_apsp = true;
+        } else if (strcmp(argv[i], "--compact") == 0) {
+            use_compact = true;
+        } else if (strcmp(argv[i], "--batch") == 0 && i + 1 < argc) {
+            batch_file = argv[++i];
+        } else if (strcmp(argv[i], "--profile") == 0 && i + 1 < argc) {
+            profile_file = argv[++i];
+        } else if (strcmp(argv[i], "--stream") == 0 && i + 1 < argc) {
+            stream_file = argv[++i];
+        } else if (strcmp(argv[i], "--serve") == 0 && i + 1 < argc) {
+            socket_path = argv[++i];
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            num_threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--compile") == 0) {
+            compile = true;
+        } else if (strcmp(argv[i], "--snapshot") == 0 && i + 1 < argc) {
+            snapshot_file = argv[++i];
+        } else if (strcmp(argv[i], "--cache") == 0 && i + 1 < argc) {
+            cache_entries = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--reorder") == 0 && i + 1 < argc) {
+            i++;
+            if (strcmp(argv[i], "bfs") == 0) order = ORDER_BFS;
+            else if (strcmp(argv[i], "hilbert") == 0) order = ORDER_HILBERT;
+            else bad_order = true;
+        } else if (argv[i][0] != '-' && num_files < EXPECTED_FILES + 1) {
+            files[num_files++] = argv[i];
+        } else {
+            print_usage(argv[0]);
+            return ERROR;
+        }
+    }
+    int expected_files = snapshot_file ? 0 : compile ? EXPECTED_FILES + 1 : EXPECTED_FILES;
+    if (num_files != expected_files || (snapshot_file && (compile || coords_file || order != ORDER_FILE)) ||
+        (batch_file && stream_file) || (socket_path && (batch_file || stream_file)) || bad_order) {
+        print_usage(argv[0]);
         return ERROR;
     }
     
+    if (num_threads < 1) num_threads = parallel_default_threads();
+    
+    // A snapshot is mapped as is (in the order it was compiled with); text files are parsed and frozen
+    Graph* graph = snapshot_file ? snapshot_load(snapshot_file)
+                                 : load_text_graph(files[0], files[1], coords_file, num_threads, order);
+    if (!graph) return ERROR;
+    
+    if (compile) {
+        bool written = snapshot_write(graph, files[2]);
+        graph_destroy(graph);
+        return written ? SUCCESS : ERROR;
+    }
+    
+    Session session;
+    session.graph = graph;
+    session.ws = dijkstra_workspace_create(graph->num_vertices);
+    session.backward_ws = dijkstra_workspace_create(graph->num_vertices);
+    session.heuristic = NULL;
+    session.ch = use_ch ? ch_build(graph) : NULL;
+    session.apsp = use_apsp ? apsp_build(graph, APSP_AUTO, num_threads) : NULL;
+    if (use_apsp && !session.apsp) {
+        fprintf(stderr, "Warning: more than %d cities, not precomputing all pairs\n", APSP_MAX_VERTICES);
+    }
+    session.cache = route_cache_create(cache_entries);
+    session.tree = path_tree_create(graph, -1);  // No origin until the first query
+    session.interactive = true;
+    latency_clear(&session.latency);
+    memset(&session.retired, 0, sizeof(SearchCounters));
+    
+    // Pick the A* heuristic: coordinates when every city has one, otherwise landmarks if asked
+    // (a snapshot compiled with --coords carries its coordinates along)
+    if (coords_file || graph->coords) {
+        session.heuristic = heuristic_coordinates(graph);
+        if (!session.heuristic) {
+            fprintf(stderr, "Warning: not every city has coordinates, %s\n",
+                    num_landmarks > 0 ? "using landmarks" : "using plain Dijkstra");
+        }
+    }
+    if (!session.heuristic && num_landmarks > 0) {
+        session.heuristic = heuristic_landmarks(graph, num_landmarks);
+    }
+    session.engine.graph = graph;
+    session.engine.heuristic = session.heuristic;
+    session.engine.ch = session.ch;
+    session.engine.buckets = use_buckets;
+    session.engine.apsp = session.apsp;
+    if (use_buckets && !use_compact) {
+        const CsrGraph* csr = graph_freeze(graph);
+        if (csr->max_weight > DIAL_MAX_WEIGHT) {
+            fprintf(stderr, "Warning: a road is longer than %d, using the heap\n", DIAL_MAX_WEIGHT);
+        } else if (csr->min_weight < 0) {
+            fprintf(stderr, "Warning: a road has a negative length, using the heap\n");
+        }
+    }
+    
+    // Everything above has used the CSR; from here plain searches decode the packed copy instead
+    session.compact = use_compact ? compact_replace_edges(graph) : NULL;
+    session.engine.compact = session.compact;
+    if (session.compact && use_buckets) {
+        fprintf(stderr, "Note: the bucket queue needs the CSR, --compact searches use the heap\n");
+        session.engine.buckets = false;
+    }
+    if (session.compact && session.heuristic) {
+        fprintf(stderr, "Note: A* needs the adjacency lists, --compact searches use Dijkstra\n");
+        session.engine.heuristic = NULL;
+    }
+    
+    if (batch_file || stream_file || socket_path) {
+        int status = batch_file ? run_batch(&session, batch_file, num_threads)
+                   : stream_file ? run_stream(&session, stream_file)
+                   : run_server(&session, socket_path, num_threads);
+        if (profile_file && !write_profile(&session, profile_file)) status = ERROR;
+        free_session(&session);
+        return status;
+    }
+    
     // Print welcome message 
     printf("*****Welcome to the shortest path finder!******\n");
     print_help();
@@ -191,14 +601,15 @@ int main(int argc, char* argv[]) {
         if (!fgets(input, sizeof(input), stdin)) break;  // EOF or error
         
         // Continue loop
-        continue_loop = process_command(graph, input);
+        continue_loop = process_command(&session, input);
     }
     
     // Farewell message
     printf("Goodbye!\n");
+    if (profile_file) write_profile(&session, profile_file);
     
     // Free all memory
-    graph_destroy(graph);
+    free_session(&session);
     
     return SUCCESS;
-}
\ No newline at end of file
+}
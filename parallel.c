@@ -0,0 +1,214 @@
+/**
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * CS 5008
+ * Implementation of parallel_for on POSIX threads
+ */
+
+#define _POSIX_C_SOURCE 200809L  // For sysconf
+
+#include "parallel.h"
+#include <pthread.h>    // For pthread_create, pthread_join
+#include <stdatomic.h>  // For atomic_int, atomic_fetch_add
+#include <stdbool.h>    // For bool
+#include <stdlib.h>     // For malloc, free
+#include <unistd.h>     // For sysconf
+
+#define CHUNKS_PER_THREAD 8  // Chunks handed out per worker, so uneven tasks still balance
+
+// State shared by the workers of one parallel_for call
+typedef struct ParallelJob {
+    ParallelTask task;
+    void* context;
+    int count;        // Indices to run
+    int chunk;        // Indices claimed per grab
+    atomic_int next;  // First index not yet claimed
+} ParallelJob;
+
+// Arguments for one spawned worker
+typedef struct Worker {
+    ParallelJob* job;
+    int id;
+    pthread_t thread;
+} Worker;
+
+/**
+ * Claim chunks of indices until none are left
+ */
+static void run_worker(ParallelJob* job, int id) {
+    while (1) {
+        int begin = atomic_fetch_add(&job->next, job->chunk);
+        if (begin >= job->count) return;
+        int end = begin + job->chunk < job->count ? begin + job->chunk : job->count;
+        for (int i = begin; i < end; i++) {
+            job->task(job->context, id, i);
+        }
+    }
+}
+
+/**
+ * pthread entry point
+ */
+static void* worker_main(void* arg) {
+    Worker* worker = (Worker*)arg;
+    run_worker(worker->job, worker->id);
+    return NULL;
+}
+
+/**
+ * Run task over [0, count) on up to num_threads threads
+ * The calling thread is worker 0; if a thread cannot be started the
+ * remaining workers simply pick up its share.
+ */
+void parallel_for(int count, int num_threads, ParallelTask task, void* context) {
+    if (count <= 0) return;
+    if (num_threads > count) num_threads = count;
+    if (num_threads < 1) num_threads = 1;
+
+    ParallelJob job;
+    job.task = task;
+    job.context = context;
+    job.count = count;
+    job.chunk = count / (num_threads * CHUNKS_PER_THREAD);
+    if (job.chunk < 1) job.chunk = 1;
+    atomic_init(&job.next, 0);
+
+    Worker* workers = (Worker*)malloc(sizeof(Worker) * num_threads);
+    int started = 1;
+    for (int t = 1; t < num_threads; t++) {
+        workers[started].job = &job;
+        workers[started].id = t;
+        if (pthread_create(&workers[started].thread, NULL, worker_main, &workers[started]) == 0) {
+            started++;
+        }
+    }
+
+    run_worker(&job, 0);
+
+    for (int t = 1; t < started; t++) {
+        pthread_join(workers[t].thread, NULL);
+    }
+    free(workers);
+}
+
+typedef struct PoolHelper PoolHelper;
+
+// Helper threads parked between rounds
+struct ParallelPool {
+    ParallelJob job;         // Current round
+    PoolHelper* helpers;     // Helpers in [1, started)
+    int started;             // 1 + helpers actually running
+    unsigned int round;      // Bumped to post a new job
+    int busy;                // Helpers still working on the current round
+    bool stop;               // Set by parallel_pool_destroy
+    pthread_mutex_t lock;
+    pthread_cond_t wake;     // A round was posted or the pool is stopping
+    pthread_cond_t done;     // The last helper finished the round
+};
+
+// One pool helper thread
+struct PoolHelper {
+    ParallelPool* pool;
+    int id;
+    pthread_t thread;
+};
+
+/**
+ * Pool helper entry point: wait for a round, run it, report back, repeat
+ */
+static void* pool_main(void* arg) {
+    PoolHelper* helper = (PoolHelper*)arg;
+    ParallelPool* pool = helper->pool;
+    unsigned int seen = 0;
+    pthread_mutex_lock(&pool->lock);
+    while (1) {
+        while (!pool->stop && pool->round == seen) pthread_cond_wait(&pool->wake, &pool->lock);
+        if (pool->stop) break;
+        seen = pool->round;
+        pthread_mutex_unlock(&pool->lock);
+
+        run_worker(&pool->job, helper->id);
+
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->busy == 0) pthread_cond_signal(&pool->done);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+/**
+ * Start num_threads - 1 helpers; threads that cannot be started are left out
+ */
+ParallelPool* parallel_pool_create(int num_threads) {
+    if (num_threads < 1) num_threads = 1;
+    ParallelPool* pool = (ParallelPool*)malloc(sizeof(ParallelPool));
+    pool->helpers = (PoolHelper*)malloc(sizeof(PoolHelper) * num_threads);
+    pool->round = 0;
+    pool->busy = 0;
+    pool->stop = false;
+    atomic_init(&pool->job.next, 0);
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->wake, NULL);
+    pthread_cond_init(&pool->done, NULL);
+
+    pool->started = 1;
+    for (int t = 1; t < num_threads; t++) {
+        PoolHelper* helper = &pool->helpers[pool->started];
+        helper->pool = pool;
+        helper->id = pool->started;
+        if (pthread_create(&helper->thread, NULL, pool_main, helper) == 0) pool->started++;
+    }
+    return pool;
+}
+
+/**
+ * Stop and join the helpers
+ */
+void parallel_pool_destroy(ParallelPool* pool) {
+    if (!pool) return;
+    pthread_mutex_lock(&pool->lock);
+    pool->stop = true;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+    for (int t = 1; t < pool->started; t++) {
+        pthread_join(pool->helpers[t].thread, NULL);
+    }
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->wake);
+    pthread_cond_destroy(&pool->done);
+    free(pool->helpers);
+    free(pool);
+}
+
+/**
+ * Post one round to the helpers, work on it too, and wait until every helper is done
+ */
+void parallel_pool_run(ParallelPool* pool, int count, ParallelTask task, void* context) {
+    if (count <= 0) return;
+
+    pthread_mutex_lock(&pool->lock);
+    pool->job.task = task;
+    pool->job.context = context;
+    pool->job.count = count;
+    pool->job.chunk = count / (pool->started * CHUNKS_PER_THREAD);
+    if (pool->job.chunk < 1) pool->job.chunk = 1;
+    atomic_store(&pool->job.next, 0);
+    pool->busy = pool->started - 1;
+    pool->round++;
+    pthread_cond_broadcast(&pool->wake);
+    pthread_mutex_unlock(&pool->lock);
+
+    run_worker(&pool->job, 0);
+
+    pthread_mutex_lock(&pool->lock);
+    while (pool->busy > 0) pthread_cond_wait(&pool->done, &pool->lock);
+    pthread_mutex_unlock(&pool->lock);
+}
+
+/**
+ * Number of processors online (at least 1)
+ */
+int parallel_default_threads(void) {
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    return online > 0 ? (int)online : 1;
+}
@@ -0,0 +1,31 @@
+/**
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * CS 5008
+ * Minimal thread pool helper: run a task over an index range on N threads,
+ * either with threads started for one call or with a pool kept across calls
+ */
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+// Work for one index; worker is in [0, num_threads) so tasks can own per-thread state
+typedef void (*ParallelTask)(void* context, int worker, int index);
+
+// Run task for every index in [0, count) and return when all are done
+void parallel_for(int count, int num_threads, ParallelTask task, void* context);
+
+// Worker threads started once and reused by every parallel_pool_run, for
+// callers that run many short rounds (the caller is always worker 0)
+typedef struct ParallelPool ParallelPool;
+
+ParallelPool* parallel_pool_create(int num_threads);
+void parallel_pool_destroy(ParallelPool* pool);
+
+// Same contract as parallel_for, on the pool's threads
+void parallel_pool_run(ParallelPool* pool, int count, ParallelTask task, void* context);
+
+// Number of processors online (at least 1)
+int parallel_default_threads(void);
+
+#endif
@@ -0,0 +1,159 @@
+/**
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * CS 5008
+ * Implementation of the search counters and latency histograms
+ */
+
+#define _POSIX_C_SOURCE 200809L  // For clock_gettime
+
+#include "profile.h"
+#include <math.h>   // For log2, pow
+#include <string.h> // For memset
+#include <time.h>   // For clock_gettime
+
+/**
+ * Monotonic wall clock in seconds
+ */
+double profile_now(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+/**
+ * Add one set of search counters to another
+ */
+void search_counters_add(SearchCounters* into, const SearchCounters* from) {
+    into->searches += from->searches;
+    into->settled += from->settled;
+    into->relaxed += from->relaxed;
+    into->heap_pushes += from->heap_pushes;
+}
+
+/**
+ * Forget every recorded query
+ */
+void latency_clear(LatencyHistogram* histogram) {
+    memset(histogram, 0, sizeof(LatencyHistogram));
+}
+
+/**
+ * Bucket holding a latency: LATENCY_STEPS buckets per doubling from 1 ns
+ */
+static int bucket_of(double seconds) {
+    double ns = seconds * 1e9;
+    if (ns < 1) return 0;
+    int bucket = (int)(log2(ns) * LATENCY_STEPS);
+    return bucket < LATENCY_BUCKETS ? bucket : LATENCY_BUCKETS - 1;
+}
+
+/**
+ * Upper edge of a bucket in seconds
+ */
+static double bucket_limit(int bucket) {
+    return pow(2.0, (double)(bucket + 1) / LATENCY_STEPS) / 1e9;
+}
+
+/**
+ * Record one query and the vertices its search settled
+ */
+void latency_record(LatencyHistogram* histogram, double seconds, int settled) {
+    int bucket = bucket_of(seconds);
+    histogram->counts[bucket]++;
+    histogram->settled[bucket] += settled;
+    histogram->total++;
+    histogram->sum_seconds += seconds;
+    if (seconds > histogram->max_seconds) histogram->max_seconds = seconds;
+}
+
+/**
+ * Add the queries of one histogram to another (e.g. per-thread histograms)
+ */
+void latency_merge(LatencyHistogram* into, const LatencyHistogram* from) {
+    for (int b = 0; b < LATENCY_BUCKETS; b++) {
+        into->counts[b] += from->counts[b];
+        into->settled[b] += from->settled[b];
+    }
+    into->total += from->total;
+    into->sum_seconds += from->sum_seconds;
+    if (from->max_seconds > into->max_seconds) into->max_seconds = from->max_seconds;
+}
+
+/**
+ * Latency below which the given fraction of queries fell (0.5 = median)
+ * Reported as the upper edge of the bucket, so it overstates by at most a bucket width.
+ */
+double latency_percentile(const LatencyHistogram* histogram, double fraction) {
+    if (histogram->total == 0) return 0;
+    long rank = (long)ceil(fraction * histogram->total);
+    if (rank < 1) rank = 1;
+
+    long seen = 0;
+    for (int b = 0; b < LATENCY_BUCKETS; b++) {
+        seen += histogram->counts[b];
+        if (seen >= rank) {
+            double limit = bucket_limit(b);
+            return limit < histogram->max_seconds ? limit : histogram->max_seconds;
+        }
+    }
+    return histogram->max_seconds;
+}
+
+/**
+ * Print a readable summary
+ */
+void profile_print(FILE* out, const LatencyHistogram* latency, const SearchCounters* search,
+                   const GraphCounters* graph) {
+    if (!PROFILE_ENABLED) {
+        fprintf(out, "Profiling: disabled at compile time (build with make PROFILE=on)\n");
+        return;
+    }
+
+    fprintf(out, "Queries: %ld\n", latency->total);
+    if (latency->total > 0) {
+        fprintf(out, "\tLatency (us): mean %.1f, p50 %.1f, p90 %.1f, p99 %.1f, max %.1f\n",
+                latency->sum_seconds / latency->total * 1e6, latency_percentile(latency, 0.5) * 1e6,
+                latency_percentile(latency, 0.9) * 1e6, latency_percentile(latency, 0.99) * 1e6,
+                latency->max_seconds * 1e6);
+    }
+    fprintf(out, "Searches: %ld\n", search->searches);
+    if (search->searches > 0) {
+        fprintf(out, "\tPer search: %.1f settled, %.1f relaxed, %.1f heap pushes\n",
+                (double)search->settled / search->searches, (double)search->relaxed / search->searches,
+                (double)search->heap_pushes / search->searches);
+    }
+    fprintf(out, "Graph: freezes %ld (%.1f ms), roads added %ld, updated %ld, removed %ld\n",
+            graph->freezes, graph->freeze_seconds * 1000, graph->roads_added, graph->roads_updated,
+            graph->roads_removed);
+}
+
+/**
+ * Print everything as one JSON object on one line
+ * The histogram lists non-empty buckets with their upper edge and the mean
+ * vertices settled by their queries, so slow buckets can be tied to big searches.
+ */
+void profile_print_json(FILE* out, const LatencyHistogram* latency, const SearchCounters* search,
+                        const GraphCounters* graph) {
+    double mean = latency->total > 0 ? latency->sum_seconds / latency->total : 0;
+    fprintf(out, "{\"profiling\": %s, \"queries\": %ld, ", PROFILE_ENABLED ? "true" : "false", latency->total);
+    fprintf(out, "\"latency_us\": {\"mean\": %.3f, \"p50\": %.3f, \"p90\": %.3f, \"p99\": %.3f, \"max\": %.3f}, ",
+            mean * 1e6, latency_percentile(latency, 0.5) * 1e6, latency_percentile(latency, 0.9) * 1e6,
+            latency_percentile(latency, 0.99) * 1e6, latency->max_seconds * 1e6);
+    fprintf(out, "\"search\": {\"searches\": %ld, \"settled\": %ld, \"relaxed\": %ld, \"heap_pushes\": %ld}, ",
+            search->searches, search->settled, search->relaxed, search->heap_pushes);
+    fprintf(out, "\"graph\": {\"freezes\": %ld, \"freeze_ms\": %.3f, \"roads_added\": %ld, "
+                 "\"roads_updated\": %ld, \"roads_removed\": %ld}, ",
+            graph->freezes, graph->freeze_seconds * 1000, graph->roads_added, graph->roads_updated,
+            graph->roads_removed);
+
+    fprintf(out, "\"histogram\": [");
+    bool first = true;
+    for (int b = 0; b < LATENCY_BUCKETS; b++) {
+        if (latency->counts[b] == 0) continue;
+        fprintf(out, "%s{\"le_us\": %.3f, \"count\": %ld, \"mean_settled\": %.1f}", first ? "" : ", ",
+                bucket_limit(b) * 1e6, latency->counts[b], (double)latency->settled[b] / latency->counts[b]);
+        first = false;
+    }
+    fprintf(out, "]}\n");
+}
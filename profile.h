@@ -0,0 +1,82 @@
+/**
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * CS 5008
+ * Search counters, timers and query latency histograms
+ *
+ * Counters are bumped on the hot path with PROFILE_COUNT, timers use
+ * PROFILE_START/PROFILE_STOP and query latencies go into a histogram with
+ * PROFILE_RECORD. All of them compile to nothing unless
+ * SEARCH_PROFILE is defined (make PROFILE=on, the default; make
+ * PROFILE=off builds without them). The structures always exist, so code
+ * reading them compiles either way and just sees zeros.
+ */
+
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <stdbool.h>
+#include <stdio.h>
+
+#ifdef SEARCH_PROFILE
+#define PROFILE_ENABLED 1
+#define PROFILE_COUNT(counter, amount) ((counter) += (amount))
+#define PROFILE_START(timer) double timer = profile_now()
+#define PROFILE_STOP(total, timer) ((total) += profile_now() - (timer))
+#define PROFILE_RECORD(histogram, timer, settled) latency_record(histogram, profile_now() - (timer), settled)
+#else
+#define PROFILE_ENABLED 0
+#define PROFILE_COUNT(counter, amount) ((void)0)
+#define PROFILE_START(timer) ((void)0)
+#define PROFILE_STOP(total, timer) ((void)0)
+#define PROFILE_RECORD(histogram, timer, settled) ((void)0)
+#endif
+
+#define LATENCY_STEPS 4      // Buckets per doubling of latency (each about 19% wide)
+#define LATENCY_BUCKETS 160  // 1 ns up to 2^40 ns (about 18 minutes)
+
+// Work done by the searches on one workspace, summed over its lifetime
+typedef struct SearchCounters {
+    long searches;      // Searches started (a bidirectional query starts two)
+    long settled;       // Vertices settled (one heap pop each)
+    long relaxed;       // Edges examined
+    long heap_pushes;   // Inserts and decrease-keys (relaxations that improved a distance)
+} SearchCounters;
+
+// Changes and layout rebuilds of one graph
+typedef struct GraphCounters {
+    long freezes;          // CSR layouts built
+    double freeze_seconds; // Time spent building them
+    long roads_added;
+    long roads_updated;    // Weight changes (patched into the CSR in place)
+    long roads_removed;
+} GraphCounters;
+
+// Query latencies in logarithmic buckets, with the search effort behind each bucket
+typedef struct LatencyHistogram {
+    long counts[LATENCY_BUCKETS];
+    long settled[LATENCY_BUCKETS];  // Vertices settled by the queries in each bucket
+    long total;                     // Queries recorded
+    double sum_seconds;
+    double max_seconds;
+} LatencyHistogram;
+
+// Monotonic wall clock in seconds
+double profile_now(void);
+
+// Counter operations
+void search_counters_add(SearchCounters* into, const SearchCounters* from);
+
+// Histogram operations
+void latency_clear(LatencyHistogram* histogram);
+void latency_record(LatencyHistogram* histogram, double seconds, int settled);
+void latency_merge(LatencyHistogram* into, const LatencyHistogram* from);
+double latency_percentile(const LatencyHistogram* histogram, double fraction);
+
+// Reports: readable text, or one JSON object for scripts
+void profile_print(FILE* out, const LatencyHistogram* latency, const SearchCounters* search,
+                   const GraphCounters* graph);
+void profile_print_json(FILE* out, const LatencyHistogram* latency, const SearchCounters* search,
+                        const GraphCounters* graph);
+
+#endif
@@ -0,0 +1,227 @@
+/**
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * CS 5008
+ * Implementation of Cuthill-McKee and Hilbert curve vertex orders
+ */
+
+#include "reorder.h"
+#include <math.h>   // For INFINITY
+#include <stdio.h>  // For fprintf
+#include <stdint.h> // For uint32_t, uint64_t
+#include <stdlib.h> // For malloc, calloc, qsort, free
+
+#define HILBERT_BITS 16       // Grid of 2^16 x 2^16 cells over the bounding box
+#define SMALL_SORT 32         // Neighbour lists up to this size use insertion sort
+
+/**
+ * qsort comparator for packed (key << 32 | vertex) values
+ */
+static int compare_keys(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Sort vertices by degree, ties by index; hubs go through qsort on packed keys
+ */
+static void sort_by_degree(int* vertices, int count, const CsrGraph* csr, uint64_t* scratch) {
+    if (count <= SMALL_SORT) {
+        for (int i = 1; i < count; i++) {
+            int v = vertices[i];
+            int degree = csr->offsets[v + 1] - csr->offsets[v];
+            int j = i - 1;
+            while (j >= 0) {
+                int other = csr->offsets[vertices[j] + 1] - csr->offsets[vertices[j]];
+                if (other < degree || (other == degree && vertices[j] < v)) break;
+                vertices[j + 1] = vertices[j];
+                j--;
+            }
+            vertices[j + 1] = v;
+        }
+        return;
+    }
+
+    for (int i = 0; i < count; i++) {
+        int v = vertices[i];
+        scratch[i] = (uint64_t)(csr->offsets[v + 1] - csr->offsets[v]) << 32 | (uint32_t)v;
+    }
+    qsort(scratch, count, sizeof(uint64_t), compare_keys);
+    for (int i = 0; i < count; i++) {
+        vertices[i] = (int)(uint32_t)scratch[i];
+    }
+}
+
+/**
+ * Breadth-first search from root over unplaced vertices; returns the last vertex reached,
+ * which lies about as far from root as possible (a pseudo-peripheral start)
+ */
+static int farthest_vertex(const CsrGraph* csr, int root, int* queue, int* probed) {
+    int head = 0, tail = 0;
+    queue[tail++] = root;
+    probed[root] = root + 1;  // Each component is probed from its own root
+    while (head < tail) {
+        int u = queue[head++];
+        for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++) {
+            int v = csr->dest[e];
+            if (probed[v] != root + 1) {
+                probed[v] = root + 1;
+                queue[tail++] = v;
+            }
+        }
+    }
+    return queue[tail - 1];
+}
+
+/**
+ * Cuthill-McKee order: every component is numbered breadth-first from a
+ * far-out vertex, visiting each vertex's neighbours from lowest degree up.
+ * Neighbours end up a BFS level apart at most, which bounds the index gap.
+ */
+int* reorder_cuthill_mckee(Graph* graph) {
+    const CsrGraph* csr = graph_freeze(graph);
+    int n = graph->num_vertices;
+    int* order = (int*)malloc(sizeof(int) * (n > 0 ? n : 1));  // Also the BFS queue
+    int* queue = (int*)malloc(sizeof(int) * (n > 0 ? n : 1));  // Queue of the probing search
+    int* probed = (int*)calloc(n > 0 ? n : 1, sizeof(int));
+    bool* placed = (bool*)calloc(n > 0 ? n : 1, sizeof(bool));
+
+    int max_degree = 0;
+    for (int v = 0; v < n; v++) {
+        int degree = csr->offsets[v + 1] - csr->offsets[v];
+        if (degree > max_degree) max_degree = degree;
+    }
+    uint64_t* scratch = (uint64_t*)malloc(sizeof(uint64_t) * (max_degree > 0 ? max_degree : 1));
+
+    int tail = 0;
+    for (int root = 0; root < n; root++) {
+        if (placed[root]) continue;  // Already numbered with its component
+
+        int start = farthest_vertex(csr, root, queue, probed);
+        int head = tail;
+        order[tail++] = start;
+        placed[start] = true;
+        while (head < tail) {
+            int u = order[head++];
+            int first = tail;
+            for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++) {
+                int v = csr->dest[e];
+                if (!placed[v]) {
+                    placed[v] = true;
+                    order[tail++] = v;
+                }
+            }
+            sort_by_degree(order + first, tail - first, csr, scratch);
+        }
+    }
+
+    free(scratch);
+    free(placed);
+    free(probed);
+    free(queue);
+    return order;
+}
+
+/**
+ * Distance along a Hilbert curve of the cell (x, y) in a 2^bits grid
+ */
+static uint64_t hilbert_index(uint32_t x, uint32_t y, int bits) {
+    uint32_t side = 1u << bits;
+    uint64_t d = 0;
+    for (uint32_t s = side / 2; s > 0; s /= 2) {
+        uint32_t rx = (x & s) > 0;
+        uint32_t ry = (y & s) > 0;
+        d += (uint64_t)s * s * ((3 * rx) ^ ry);
+
+        // Rotate the quadrant so the curve inside it starts where the last one ended
+        if (ry == 0) {
+            if (rx == 1) {
+                x = side - 1 - x;
+                y = side - 1 - y;
+            }
+            uint32_t swap = x;
+            x = y;
+            y = swap;
+        }
+    }
+    return d;
+}
+
+/**
+ * Hilbert curve order: cities are sorted by where the curve passes through
+ * their cell, so cities close on the map get close indices whatever the roads
+ */
+int* reorder_hilbert(const Graph* graph) {
+    if (!graph_has_coordinates(graph)) return NULL;
+    int n = graph->num_vertices;
+
+    // Bounding box of all cities
+    double min_lat = INFINITY, max_lat = -INFINITY, min_lon = INFINITY, max_lon = -INFINITY;
+    for (int v = 0; v < n; v++) {
+        Coordinate c = graph->coords[v];
+        if (c.latitude < min_lat) min_lat = c.latitude;
+        if (c.latitude > max_lat) max_lat = c.latitude;
+        if (c.longitude < min_lon) min_lon = c.longitude;
+        if (c.longitude > max_lon) max_lon = c.longitude;
+    }
+    double cells = (double)((1u << HILBERT_BITS) - 1);
+    double lat_scale = max_lat > min_lat ? cells / (max_lat - min_lat) : 0;
+    double lon_scale = max_lon > min_lon ? cells / (max_lon - min_lon) : 0;
+
+    // The curve index fits in 32 bits, so it packs with the vertex for one sort
+    uint64_t* keys = (uint64_t*)malloc(sizeof(uint64_t) * (n > 0 ? n : 1));
+    for (int v = 0; v < n; v++) {
+        uint32_t x = (uint32_t)((graph->coords[v].longitude - min_lon) * lon_scale);
+        uint32_t y = (uint32_t)((graph->coords[v].latitude - min_lat) * lat_scale);
+        keys[v] = hilbert_index(x, y, HILBERT_BITS) << 32 | (uint32_t)v;
+    }
+    qsort(keys, n, sizeof(uint64_t), compare_keys);
+
+    int* order = (int*)malloc(sizeof(int) * (n > 0 ? n : 1));
+    for (int i = 0; i < n; i++) {
+        order[i] = (int)(uint32_t)keys[i];
+    }
+    free(keys);
+    return order;
+}
+
+/**
+ * Relabel the graph in the requested order
+ */
+bool reorder_graph(Graph* graph, VertexOrder order) {
+    if (order == ORDER_FILE) return true;
+    if (graph_is_read_only(graph)) {
+        fprintf(stderr, "Error: Cannot reorder, graph snapshot is read-only\n");
+        return false;
+    }
+
+    int* permutation = order == ORDER_HILBERT ? reorder_hilbert(graph) : reorder_cuthill_mckee(graph);
+    if (!permutation) return false;  // Hilbert order without coordinates
+    bool relabeled = graph_relabel(graph, permutation);
+    free(permutation);
+    return relabeled;
+}
+
+/**
+ * Map every vertex of a path back to its position in the vertices file
+ */
+void reorder_path_to_original(const Graph* graph, PathResult* result) {
+    for (int i = 0; i < result->path_length; i++) {
+        result->path[i] = graph_original_index(graph, result->path[i]);
+    }
+}
+
+/**
+ * Average index distance between the two ends of an edge
+ */
+double reorder_edge_span(Graph* graph) {
+    const CsrGraph* csr = graph_freeze(graph);
+    double total = 0;
+    for (int u = 0; u < csr->num_vertices; u++) {
+        for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++) {
+            total += abs(csr->dest[e] - u);
+        }
+    }
+    return csr->num_edges > 0 ? total / csr->num_edges : 0;
+}
@@ -0,0 +1,41 @@
+/**
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * CS 5008
+ * Vertex reordering for memory locality
+ *
+ * Cities are numbered in file order, which has nothing to do with where they
+ * are on the map, so a search jumps all over the dist/parent arrays and the
+ * CSR. Renumbering them so that neighbours get nearby indices keeps each
+ * search inside a few cache lines and pages. Names keep finding their cities
+ * and graph_original_index maps a vertex back to its file position.
+ */
+
+#ifndef REORDER_H
+#define REORDER_H
+
+#include "graph.h"
+#include "dijkstra.h"
+#include <stdbool.h>
+
+// How to number the vertices
+typedef enum VertexOrder {
+    ORDER_FILE,     // As read from the vertices file (no relabeling)
+    ORDER_BFS,      // Cuthill-McKee: breadth-first from a far vertex, low degree first
+    ORDER_HILBERT   // Along a Hilbert curve through the coordinates
+} VertexOrder;
+
+// Orders as arrays where order[new] is the old vertex index (caller frees)
+int* reorder_cuthill_mckee(Graph* graph);
+int* reorder_hilbert(const Graph* graph);  // NULL unless every city has coordinates
+
+// Compute an order and relabel the graph with it; false if it could not be applied
+bool reorder_graph(Graph* graph, VertexOrder order);
+
+// Rewrite the vertices of a path as file positions
+void reorder_path_to_original(const Graph* graph, PathResult* result);
+
+// Mean |u - v| over all edges: how far apart neighbours sit in the arrays
+double reorder_edge_span(Graph* graph);
+
+#endif
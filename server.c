@@ -0,0 +1,485 @@
+/**
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * CS 5008
+ * Implementation of the Unix socket route server
+ */
+
+#define _POSIX_C_SOURCE 200809L  // For clock_gettime, strtok_r, MSG_NOSIGNAL
+
+#include "server.h"
+#include <errno.h>      // For errno, EAGAIN, EINTR
+#include <fcntl.h>      // For fcntl, O_NONBLOCK
+#include <poll.h>       // For poll (waiting for room to write)
+#include <pthread.h>    // For pthread_create, mutexes, condition variables
+#include <stdio.h>      // For fprintf, snprintf
+#include <stdlib.h>     // For malloc, realloc, free
+#include <string.h>     // For memchr, memmove, strtok_r
+#include <sys/epoll.h>  // For epoll_create1, epoll_ctl, epoll_wait
+#include <sys/socket.h> // For socket, bind, listen, accept, send
+#include <sys/stat.h>   // For lstat, S_ISSOCK
+#include <sys/un.h>     // For sockaddr_un
+#include <time.h>       // For clock_gettime
+#include <unistd.h>     // For read, write, close, pipe, unlink
+
+#define SERVER_BACKLOG 128          // Pending connections the kernel queues for accept
+#define SERVER_EVENTS 64            // Events taken per epoll_wait
+#define SERVER_MAX_LINE 1024        // Longest request line; longer ones close the connection
+#define SERVER_WRITE_TIMEOUT 5000   // ms a client may leave a full socket before it is dropped
+#define SERVER_OUTPUT 4096          // Starting size of a worker's response buffer
+#define SERVER_FLUSH 65536          // Responses held before they are sent mid-turn
+#define SERVER_READS_PER_TURN 64    // Reads before a busy client goes back behind the others
+
+// One client; only the worker holding it (or the epoll thread before handing it on) touches it
+typedef struct Connection {
+    int fd;
+    char input[SERVER_MAX_LINE];  // Bytes received and not yet answered (at most one partial line)
+    int input_length;
+    struct Connection* next_ready; // Ready queue link
+    struct Connection* prev_open;  // Open connections list links, guarded by the server lock
+    struct Connection* next_open;
+} Connection;
+
+// One pool thread with its own search state
+typedef struct ServerWorker {
+    struct Server* server;
+    pthread_t thread;
+    bool started;
+    DijkstraWorkspace* forward;
+    DijkstraWorkspace* backward;
+    LatencyHistogram latency;
+    long queries;
+    long invalid;
+    char* output;           // Responses for the lines answered in one turn
+    size_t output_length;
+    size_t output_capacity;
+} ServerWorker;
+
+struct Server {
+    const RouteEngine* engine;
+    char path[sizeof(((struct sockaddr_un*)0)->sun_path)];
+    int listen_fd;
+    int epoll_fd;
+    int wake[2];               // Self-pipe: a byte written to wake[1] stops server_run
+    int num_workers;
+    ServerWorker* workers;
+    pthread_mutex_t lock;      // Guards everything below
+    pthread_cond_t ready;
+    Connection* ready_head;    // Connections with input waiting for a worker
+    Connection* ready_tail;
+    Connection* open;          // Every open connection, so shutdown can close them
+    bool stopping;
+    long connections;
+    double started;
+};
+
+/**
+ * Monotonic clock in seconds
+ */
+static double now_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * Switch a descriptor to non-blocking mode
+ */
+static bool set_nonblocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags != -1 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+/**
+ * Append text to the worker's response buffer
+ */
+static void append_output(ServerWorker* worker, const char* text, size_t length) {
+    if (worker->output_length + length > worker->output_capacity) {
+        while (worker->output_length + length > worker->output_capacity) worker->output_capacity *= 2;
+        worker->output = (char*)realloc(worker->output, worker->output_capacity);
+    }
+    memcpy(worker->output + worker->output_length, text, length);
+    worker->output_length += length;
+}
+
+/**
+ * Send everything, waiting (briefly) whenever the socket buffer is full
+ */
+static bool send_all(int fd, const char* data, size_t length) {
+    while (length > 0) {
+        ssize_t sent = send(fd, data, length, MSG_NOSIGNAL);  // A vanished client is an error, not SIGPIPE
+        if (sent > 0) {
+            data += sent;
+            length -= (size_t)sent;
+        } else if (sent < 0 && errno == EINTR) {
+            continue;
+        } else if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            struct pollfd wait = {fd, POLLOUT, 0};
+            if (poll(&wait, 1, SERVER_WRITE_TIMEOUT) <= 0) return false;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Answer one request line; returns false when the client asked to quit
+ */
+static bool answer_line(ServerWorker* worker, char* line) {
+    const RouteEngine* engine = worker->server->engine;
+    char* save = NULL;
+    char* token1 = strtok_r(line, " \t\r", &save);
+    char* token2 = token1 ? strtok_r(NULL, " \t\r", &save) : NULL;
+    char* extra = token2 ? strtok_r(NULL, " \t\r", &save) : NULL;
+    char number[32];
+
+    if (!token1) return true;  // Blank lines get no answer
+    if (!token2 && strcmp(token1, "quit") == 0) return false;
+    if (!token2 && strcmp(token1, "ping") == 0) {
+        append_output(worker, "PONG\n", 5);
+        return true;
+    }
+    if (!token2 || extra) {
+        worker->invalid++;
+        const char* message = "ERROR expected <city1> <city2>\n";
+        append_output(worker, message, strlen(message));
+        return true;
+    }
+
+    int start = graph_find_vertex(engine->graph, token1);
+    int end = graph_find_vertex(engine->graph, token2);
+    if (start == -1 || end == -1) {
+        worker->invalid++;
+        const char* message = "ERROR unknown city\n";
+        append_output(worker, message, strlen(message));
+        return true;
+    }
+
+    PROFILE_START(begin);
+    PathResult result = route_find(engine, worker->forward, worker->backward, start, end);
+    PROFILE_RECORD(&worker->latency, begin, result.settled);
+    worker->queries++;
+
+    if (!result.found) {
+        append_output(worker, "NONE\n", 5);
+        return true;
+    }
+    int length = snprintf(number, sizeof(number), "OK %d", result.total_distance);
+    append_output(worker, number, (size_t)length);
+    for (int i = 0; i < result.path_length; i++) {
+        const char* name = engine->graph->vertices[result.path[i]].name;
+        append_output(worker, " ", 1);
+        append_output(worker, name, strlen(name));
+    }
+    append_output(worker, "\n", 1);
+    path_result_destroy(&result);
+    return true;
+}
+
+/**
+ * Answer every complete line in the connection's buffer and keep the partial rest
+ * Returns false when the client quit
+ */
+static bool answer_buffered(ServerWorker* worker, Connection* connection) {
+    char* begin = connection->input;
+    char* finish = connection->input + connection->input_length;
+    bool keep = true;
+    char* newline;
+    while (keep && (newline = (char*)memchr(begin, '\n', finish - begin)) != NULL) {
+        *newline = '\0';
+        keep = answer_line(worker, begin);
+        begin = newline + 1;
+    }
+    connection->input_length = (int)(finish - begin);
+    memmove(connection->input, begin, connection->input_length);
+    return keep;
+}
+
+/**
+ * Unlink a connection from the open list and close it
+ */
+static void close_connection(Server* server, Connection* connection) {
+    pthread_mutex_lock(&server->lock);
+    if (connection->prev_open) connection->prev_open->next_open = connection->next_open;
+    else server->open = connection->next_open;
+    if (connection->next_open) connection->next_open->prev_open = connection->prev_open;
+    pthread_mutex_unlock(&server->lock);
+
+    close(connection->fd);  // Also removes it from the epoll set
+    free(connection);
+}
+
+/**
+ * Read what the client sent, answer the complete lines, then hand the
+ * connection back to epoll (or close it). A client that keeps sending is
+ * re-armed after a bounded number of reads so it cannot hold a worker.
+ */
+static void serve_connection(ServerWorker* worker, Connection* connection) {
+    Server* server = worker->server;
+    bool open = true;
+    worker->output_length = 0;
+
+    for (int reads = 0; open && reads < SERVER_READS_PER_TURN; reads++) {
+        int room = SERVER_MAX_LINE - connection->input_length;
+        ssize_t received = read(connection->fd, connection->input + connection->input_length, room);
+        if (received > 0) {
+            connection->input_length += (int)received;
+            open = answer_buffered(worker, connection);
+            if (open && connection->input_length == SERVER_MAX_LINE) {
+                const char* message = "ERROR line too long\n";
+                append_output(worker, message, strlen(message));
+                worker->invalid++;
+                open = false;
+            }
+            if (open && worker->output_length >= SERVER_FLUSH) {
+                open = send_all(connection->fd, worker->output, worker->output_length);
+                worker->output_length = 0;
+            }
+        } else if (received < 0 && errno == EINTR) {
+            continue;
+        } else if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;  // Everything sent so far is answered
+        } else {
+            open = false;  // Client hung up or the socket failed
+        }
+    }
+
+    if (worker->output_length > 0 && !send_all(connection->fd, worker->output, worker->output_length)) {
+        open = false;
+    }
+
+    // Re-arm: the next input hands the connection to whichever worker is free.
+    // Holding the lock orders this worker's writes before the epoll thread queues it again.
+    struct epoll_event event;
+    event.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+    event.data.ptr = connection;
+    pthread_mutex_lock(&server->lock);
+    bool armed = open && epoll_ctl(server->epoll_fd, EPOLL_CTL_MOD, connection->fd, &event) == 0;
+    pthread_mutex_unlock(&server->lock);
+    if (!armed) close_connection(server, connection);
+}
+
+/**
+ * Pool thread: take ready connections until the server stops
+ */
+static void* worker_main(void* arg) {
+    ServerWorker* worker = (ServerWorker*)arg;
+    Server* server = worker->server;
+    while (1) {
+        pthread_mutex_lock(&server->lock);
+        while (!server->ready_head && !server->stopping) {
+            pthread_cond_wait(&server->ready, &server->lock);
+        }
+        if (server->stopping) {
+            pthread_mutex_unlock(&server->lock);
+            return NULL;
+        }
+        Connection* connection = server->ready_head;
+        server->ready_head = connection->next_ready;
+        if (!server->ready_head) server->ready_tail = NULL;
+        pthread_mutex_unlock(&server->lock);
+
+        serve_connection(worker, connection);
+    }
+}
+
+/**
+ * Accept every pending client and register it with epoll
+ */
+static void accept_clients(Server* server) {
+    while (1) {
+        int fd = accept(server->listen_fd, NULL, NULL);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) perror("Error: accept");
+            return;
+        }
+        Connection* connection = (Connection*)malloc(sizeof(Connection));
+        if (!connection || !set_nonblocking(fd)) {
+            free(connection);
+            close(fd);
+            continue;
+        }
+        connection->fd = fd;
+        connection->input_length = 0;
+        connection->next_ready = NULL;
+
+        pthread_mutex_lock(&server->lock);
+        connection->prev_open = NULL;
+        connection->next_open = server->open;
+        if (server->open) server->open->prev_open = connection;
+        server->open = connection;
+        server->connections++;
+        pthread_mutex_unlock(&server->lock);
+
+        struct epoll_event event;
+        event.events = EPOLLIN | EPOLLRDHUP | EPOLLONESHOT;
+        event.data.ptr = connection;
+        if (epoll_ctl(server->epoll_fd, EPOLL_CTL_ADD, fd, &event) != 0) close_connection(server, connection);
+    }
+}
+
+/**
+ * Bind the listening socket, replacing a stale socket file left by an earlier run
+ */
+static int open_listener(const char* socket_path) {
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (strlen(socket_path) >= sizeof(address.sun_path)) {
+        fprintf(stderr, "Error: Socket path %s is too long\n", socket_path);
+        return -1;
+    }
+    strcpy(address.sun_path, socket_path);
+
+    // Only ever remove a socket, never some other file that happens to be there
+    struct stat info;
+    if (lstat(socket_path, &info) == 0 && S_ISSOCK(info.st_mode)) unlink(socket_path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || bind(fd, (struct sockaddr*)&address, sizeof(address)) != 0 ||
+        listen(fd, SERVER_BACKLOG) != 0 || !set_nonblocking(fd)) {
+        fprintf(stderr, "Error: Cannot listen on %s: %s\n", socket_path, strerror(errno));
+        if (fd >= 0) close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+/**
+ * Create the server: socket, epoll set, wake pipe and worker pool
+ */
+Server* server_create(const RouteEngine* engine, const char* socket_path, int num_threads) {
+    if (num_threads < 1) num_threads = 1;
+    // Workers only read; the layout must exist before they start (a packed adjacency replaces it)
+    if (!engine->compact) graph_freeze(engine->graph);
+
+    int listen_fd = open_listener(socket_path);
+    if (listen_fd < 0) return NULL;
+
+    Server* server = (Server*)calloc(1, sizeof(Server));
+    server->engine = engine;
+    strcpy(server->path, socket_path);
+    server->listen_fd = listen_fd;
+    server->epoll_fd = epoll_create1(0);
+    server->wake[0] = server->wake[1] = -1;
+    if (server->epoll_fd < 0 || pipe(server->wake) != 0) {
+        fprintf(stderr, "Error: Cannot set up the event loop: %s\n", strerror(errno));
+        if (server->epoll_fd >= 0) close(server->epoll_fd);
+        close(listen_fd);
+        unlink(socket_path);
+        free(server);
+        return NULL;
+    }
+
+    // The listener and the wake pipe are told apart from clients by their data pointers
+    struct epoll_event event;
+    event.events = EPOLLIN;
+    event.data.ptr = &server->listen_fd;
+    epoll_ctl(server->epoll_fd, EPOLL_CTL_ADD, listen_fd, &event);
+    event.data.ptr = &server->wake;
+    epoll_ctl(server->epoll_fd, EPOLL_CTL_ADD, server->wake[0], &event);
+
+    pthread_mutex_init(&server->lock, NULL);
+    pthread_cond_init(&server->ready, NULL);
+    server->started = now_seconds();
+    server->num_workers = num_threads;
+    server->workers = (ServerWorker*)calloc(num_threads, sizeof(ServerWorker));
+    for (int t = 0; t < num_threads; t++) {
+        ServerWorker* worker = &server->workers[t];
+        worker->server = server;
+        worker->forward = dijkstra_workspace_create(engine->graph->num_vertices);
+        worker->backward = dijkstra_workspace_create(engine->graph->num_vertices);
+        latency_clear(&worker->latency);
+        worker->output_capacity = SERVER_OUTPUT;
+        worker->output = (char*)malloc(worker->output_capacity);
+        worker->started = pthread_create(&worker->thread, NULL, worker_main, worker) == 0;
+    }
+    return server;
+}
+
+/**
+ * Event loop: accept clients and queue connections that have input
+ */
+bool server_run(Server* server) {
+    struct epoll_event events[SERVER_EVENTS];
+    while (1) {
+        int count = epoll_wait(server->epoll_fd, events, SERVER_EVENTS, -1);
+        if (count < 0) {
+            if (errno == EINTR) continue;  // A signal handler ran, maybe server_stop
+            perror("Error: epoll_wait");
+            return false;
+        }
+
+        for (int i = 0; i < count; i++) {
+            void* source = events[i].data.ptr;
+            if (source == &server->wake) return true;
+            if (source == &server->listen_fd) {
+                accept_clients(server);
+                continue;
+            }
+
+            Connection* connection = (Connection*)source;
+            pthread_mutex_lock(&server->lock);
+            connection->next_ready = NULL;
+            if (server->ready_tail) server->ready_tail->next_ready = connection;
+            else server->ready_head = connection;
+            server->ready_tail = connection;
+            pthread_cond_signal(&server->ready);
+            pthread_mutex_unlock(&server->lock);
+        }
+    }
+}
+
+/**
+ * Wake server_run so it returns (write() is async-signal-safe)
+ */
+void server_stop(Server* server) {
+    char byte = 1;
+    ssize_t ignored = write(server->wake[1], &byte, 1);
+    (void)ignored;  // A full pipe already holds a wake-up
+}
+
+/**
+ * Shut down and free the server
+ */
+void server_destroy(Server* server, ServerStats* stats) {
+    if (!server) return;
+
+    pthread_mutex_lock(&server->lock);
+    server->stopping = true;
+    pthread_cond_broadcast(&server->ready);
+    pthread_mutex_unlock(&server->lock);
+
+    ServerStats totals;
+    memset(&totals, 0, sizeof(ServerStats));
+    for (int t = 0; t < server->num_workers; t++) {
+        ServerWorker* worker = &server->workers[t];
+        if (worker->started) pthread_join(worker->thread, NULL);
+        totals.queries += worker->queries;
+        totals.invalid += worker->invalid;
+        latency_merge(&totals.latency, &worker->latency);
+        search_counters_add(&totals.search, &worker->forward->counters);
+        search_counters_add(&totals.search, &worker->backward->counters);
+        dijkstra_workspace_destroy(worker->forward);
+        dijkstra_workspace_destroy(worker->backward);
+        free(worker->output);
+    }
+    totals.connections = server->connections;
+    totals.seconds = now_seconds() - server->started;
+
+    // Workers are gone, so nothing else touches the connections
+    while (server->open) close_connection(server, server->open);
+    close(server->listen_fd);
+    close(server->epoll_fd);
+    close(server->wake[0]);
+    close(server->wake[1]);
+    unlink(server->path);
+    pthread_mutex_destroy(&server->lock);
+    pthread_cond_destroy(&server->ready);
+    free(server->workers);
+    free(server);
+
+    if (stats) *stats = totals;
+}
@@ -0,0 +1,52 @@
+/**
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * CS 5008
+ * Route server over a Unix domain socket
+ *
+ * The graph is loaded once and shared by every client. Requests are lines,
+ * answered one line each and in order (clients may pipeline):
+ *   <city1> <city2>  ->  OK <distance> <city1> ... <city2>   or   NONE
+ *   ping             ->  PONG
+ *   quit             ->  (connection closed)
+ *   anything else    ->  ERROR <reason>
+ *
+ * One thread runs an epoll loop that accepts connections and waits for
+ * input. A connection with input is handed to a fixed pool of workers, each
+ * with its own search workspaces; EPOLLONESHOT keeps a connection with one
+ * worker at a time, and the worker re-arms it once every complete line has
+ * been answered. The server never changes the graph.
+ */
+
+#ifndef SERVER_H
+#define SERVER_H
+
+#include "batch.h"
+#include "profile.h"
+#include <stdbool.h>
+
+// Totals for one server run
+typedef struct ServerStats {
+    long connections; // Clients accepted
+    long queries;     // Route requests answered (OK or NONE)
+    long invalid;     // ERROR responses
+    double seconds;   // Wall time from create to destroy
+    LatencyHistogram latency; // Per-query search time (empty unless built with PROFILE=on)
+    SearchCounters search;    // Work done by every worker's searches
+} ServerStats;
+
+typedef struct Server Server;
+
+// Bind and listen on socket_path (a stale socket file is replaced) and start the workers
+Server* server_create(const RouteEngine* engine, const char* socket_path, int num_threads);
+
+// Serve until server_stop; returns false on an epoll failure
+bool server_run(Server* server);
+
+// Ask server_run to return; safe from a signal handler or another thread
+void server_stop(Server* server);
+
+// Stop the workers, close every connection, remove the socket file and report totals
+void server_destroy(Server* server, ServerStats* stats);
+
+#endif
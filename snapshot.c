@@ -0,0 +1,344 @@
+/**
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * CS 5008
+ * Implementation of binary graph snapshots
+ */
+
+#define _POSIX_C_SOURCE 200809L // For mmap, fstat
+
+#include "snapshot.h"
+#include <fcntl.h>    // For open
+#include <stdio.h>    // For FILE, fwrite, fprintf
+#include <stdlib.h>   // For malloc, calloc, free
+#include <string.h>   // For memcpy, memcmp, memset, strlen
+#include <sys/mman.h> // For mmap, munmap
+#include <sys/stat.h> // For fstat
+#include <unistd.h>   // For close
+
+#define CHECKSUM_SEED 14695981039346656037ull // FNV-1a 64-bit offset basis
+#define CHECKSUM_PRIME 1099511628211ull       // FNV-1a 64-bit prime
+
+// Byte offset of each section from the start of the file
+typedef struct SnapshotLayout {
+    size_t offsets;
+    size_t dest;
+    size_t weight;
+    size_t hashes;
+    size_t name_offsets;
+    size_t index;
+    size_t names;
+    size_t coords;
+    size_t original;
+    size_t component;
+    size_t component_size;
+    size_t total;   // File size
+} SnapshotLayout;
+
+/**
+ * Round up to the next multiple of 8
+ */
+static size_t align8(size_t bytes) {
+    return (bytes + 7) & ~(size_t)7;
+}
+
+/**
+ * Work out where every section starts from the counts in the header
+ */
+static void compute_layout(const SnapshotHeader* header, SnapshotLayout* layout) {
+    size_t n = (size_t)header->num_vertices;
+    size_t m = (size_t)header->num_edges;
+    size_t at = sizeof(SnapshotHeader);
+
+    layout->offsets = at;
+    at = align8(at + sizeof(int32_t) * (n + 1));
+    layout->dest = at;
+    at = align8(at + sizeof(int32_t) * m);
+    layout->weight = at;
+    at = align8(at + sizeof(int32_t) * m);
+    layout->hashes = at;
+    at = align8(at + sizeof(uint32_t) * n);
+    layout->name_offsets = at;
+    at = align8(at + sizeof(uint32_t) * n);
+    layout->index = at;
+    at = align8(at + sizeof(int32_t) * (size_t)header->index_capacity);
+    layout->names = at;
+    at = align8(at + header->name_bytes);
+    layout->coords = at;
+    if (header->flags & SNAPSHOT_HAS_COORDS) at = align8(at + sizeof(Coordinate) * n);
+    layout->original = at;
+    if (header->flags & SNAPSHOT_HAS_ORDER) at = align8(at + sizeof(int32_t) * n);
+    layout->component = at;
+    at = align8(at + sizeof(int32_t) * n);
+    layout->component_size = at;
+    at = align8(at + sizeof(int32_t) * n);
+    layout->total = at;
+}
+
+/**
+ * FNV-1a over 64-bit words of the body (everything after the header)
+ */
+static uint64_t checksum_body(const unsigned char* file, size_t total) {
+    uint64_t hash = CHECKSUM_SEED;
+    for (size_t at = sizeof(SnapshotHeader); at < total; at += sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, file + at, sizeof(word));
+        hash ^= word;
+        hash *= CHECKSUM_PRIME;
+    }
+    return hash;
+}
+
+/**
+ * Write the graph to a snapshot file
+ * The file is assembled in memory so the checksum can go in the header.
+ */
+bool snapshot_write(Graph* graph, const char* filename) {
+    const CsrGraph* csr = graph_freeze(graph);
+    int n = graph->num_vertices;
+
+    SnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.byte_order = SNAPSHOT_BYTE_ORDER;
+    header.flags = graph_has_coordinates(graph) ? SNAPSHOT_HAS_COORDS : 0;
+    if (graph->original) header.flags |= SNAPSHOT_HAS_ORDER;
+    header.num_vertices = n;
+    header.num_edges = csr->num_edges;
+    header.index_capacity = graph->index_capacity;
+    header.max_weight = csr->max_weight;
+    for (int e = 0; e < csr->num_edges; e++) {
+        if (csr->weight[e] < 0) {
+            fprintf(stderr, "Error: Cannot write snapshot %s, a road has a negative length\n", filename);
+            return false;
+        }
+    }
+    for (int v = 0; v < n; v++) {
+        header.name_bytes += strlen(graph->vertices[v].name) + 1;
+    }
+    if (header.name_bytes > UINT32_MAX) {
+        fprintf(stderr, "Error: City names too large for a snapshot\n");
+        return false;
+    }
+
+    SnapshotLayout layout;
+    compute_layout(&header, &layout);
+    header.file_bytes = layout.total;
+
+    unsigned char* file = (unsigned char*)calloc(layout.total, 1);  // Zeroed padding
+    if (!file) {
+        fprintf(stderr, "Error: Out of memory writing snapshot %s\n", filename);
+        return false;
+    }
+
+    // Sections are copied exactly as they sit in memory
+    memcpy(file + layout.offsets, csr->offsets, sizeof(int32_t) * ((size_t)n + 1));
+    memcpy(file + layout.dest, csr->dest, sizeof(int32_t) * (size_t)csr->num_edges);
+    memcpy(file + layout.weight, csr->weight, sizeof(int32_t) * (size_t)csr->num_edges);
+    memcpy(file + layout.index, graph->index, sizeof(int32_t) * (size_t)graph->index_capacity);
+    uint32_t* hashes = (uint32_t*)(file + layout.hashes);
+    uint32_t* name_offsets = (uint32_t*)(file + layout.name_offsets);
+    size_t name_at = 0;
+    for (int v = 0; v < n; v++) {
+        size_t length = strlen(graph->vertices[v].name) + 1;
+        hashes[v] = graph->vertices[v].hash;
+        name_offsets[v] = (uint32_t)name_at;
+        memcpy(file + layout.names + name_at, graph->vertices[v].name, length);
+        name_at += length;
+    }
+    if (header.flags & SNAPSHOT_HAS_COORDS) {
+        memcpy(file + layout.coords, graph->coords, sizeof(Coordinate) * (size_t)n);
+    }
+    if (header.flags & SNAPSHOT_HAS_ORDER) {
+        memcpy(file + layout.original, graph->original, sizeof(int32_t) * (size_t)n);
+    }
+    memcpy(file + layout.component, graph->component, sizeof(int32_t) * (size_t)n);  // Fresh after the freeze
+    memcpy(file + layout.component_size, graph->component_size, sizeof(int32_t) * (size_t)n);
+
+    header.checksum = checksum_body(file, layout.total);
+    memcpy(file, &header, sizeof(header));
+
+    FILE* out = fopen(filename, "wb");
+    if (!out) {
+        fprintf(stderr, "Error: Cannot open file %s\n", filename);
+        free(file);
+        return false;
+    }
+    bool ok = fwrite(file, 1, layout.total, out) == layout.total;
+    ok = fclose(out) == 0 && ok;
+    free(file);
+    if (!ok) fprintf(stderr, "Error: Failed writing snapshot %s\n", filename);
+    return ok;
+}
+
+/**
+ * True if every offset, destination, weight, index slot, name and label stays in range
+ * One pass over each section, after the checksum has paged them all in.
+ * Weights must lie in [0, max_weight]: searches assume no road is negative
+ * and Dial's buckets are sized from max_weight.
+ */
+static bool sections_in_bounds(const unsigned char* file, const SnapshotHeader* header,
+                               const SnapshotLayout* layout) {
+    int n = header->num_vertices;
+    int m = header->num_edges;
+    const int32_t* offsets = (const int32_t*)(file + layout->offsets);
+    if (offsets[0] != 0 || offsets[n] != m) return false;
+    for (int v = 0; v < n; v++) {
+        if (offsets[v + 1] < offsets[v]) return false;
+    }
+    const int32_t* dest = (const int32_t*)(file + layout->dest);
+    for (int e = 0; e < m; e++) {
+        if (dest[e] < 0 || dest[e] >= n) return false;
+    }
+    const int32_t* weight = (const int32_t*)(file + layout->weight);
+    for (int e = 0; e < m; e++) {
+        if (weight[e] < 0 || weight[e] > header->max_weight) return false;
+    }
+
+    // Names must start inside the section, which ends with a terminator
+    if (header->name_bytes > 0 && file[layout->names + header->name_bytes - 1] != '\0') return false;
+    const uint32_t* name_offsets = (const uint32_t*)(file + layout->name_offsets);
+    for (int v = 0; v < n; v++) {
+        if (name_offsets[v] >= header->name_bytes) return false;
+    }
+    const int32_t* index = (const int32_t*)(file + layout->index);
+    for (int slot = 0; slot < header->index_capacity; slot++) {
+        if (index[slot] < -1 || index[slot] >= n) return false;
+    }
+    if (header->flags & SNAPSHOT_HAS_ORDER) {
+        const int32_t* original = (const int32_t*)(file + layout->original);
+        for (int v = 0; v < n; v++) {
+            if (original[v] < 0 || original[v] >= n) return false;
+        }
+    }
+
+    const int32_t* component = (const int32_t*)(file + layout->component);
+    const int32_t* component_size = (const int32_t*)(file + layout->component_size);
+    for (int v = 0; v < n; v++) {
+        if (component[v] < 0 || component[v] >= n || component_size[component[v]] < 1 ||
+            component_size[component[v]] > n) return false;
+    }
+    return true;
+}
+
+/**
+ * Check the header and body of a mapped snapshot
+ */
+static bool snapshot_valid(const unsigned char* file, size_t size, const char* filename,
+                           SnapshotLayout* layout) {
+    const SnapshotHeader* header = (const SnapshotHeader*)file;
+    if (size < sizeof(SnapshotHeader) || memcmp(header->magic, SNAPSHOT_MAGIC, 8) != 0) {
+        fprintf(stderr, "Error: %s is not a graph snapshot\n", filename);
+        return false;
+    }
+    if (header->byte_order != SNAPSHOT_BYTE_ORDER || header->version != SNAPSHOT_VERSION) {
+        fprintf(stderr, "Error: %s is snapshot version %u, expected %d (recompile it)\n", filename,
+                header->byte_order == SNAPSHOT_BYTE_ORDER ? header->version : 0, SNAPSHOT_VERSION);
+        return false;
+    }
+
+    // Counts must describe exactly this file before any section is touched
+    int capacity = header->index_capacity;
+    bool counts_ok = header->num_vertices >= 0 && header->num_edges >= 0 && capacity > header->num_vertices &&
+                     (capacity & (capacity - 1)) == 0 && header->file_bytes == size;
+    if (counts_ok) {
+        compute_layout(header, layout);
+        counts_ok = layout->total == size;
+    }
+    if (!counts_ok) {
+        fprintf(stderr, "Error: Snapshot %s is truncated or malformed\n", filename);
+        return false;
+    }
+
+    if (checksum_body(file, size) != header->checksum) {
+        fprintf(stderr, "Error: Snapshot %s failed its checksum\n", filename);
+        return false;
+    }
+
+    // A file can match its checksum and still be wrong (hand-edited, or written
+    // by a buggy tool), so check every index a search will follow
+    if (!sections_in_bounds(file, header, layout)) {
+        fprintf(stderr, "Error: Snapshot %s is malformed\n", filename);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Map a snapshot and wrap it in a read-only graph
+ * Only the vertex array and two small structs are allocated; everything
+ * else points into the mapped pages.
+ */
+Graph* snapshot_load(const char* filename) {
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "Error: Cannot open file %s\n", filename);
+        return NULL;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+        fprintf(stderr, "Error: %s is not a graph snapshot\n", filename);
+        close(fd);
+        return NULL;
+    }
+    size_t size = (size_t)info.st_size;
+    void* mapped = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  // The mapping keeps the file alive
+    if (mapped == MAP_FAILED) {
+        fprintf(stderr, "Error: Cannot map file %s\n", filename);
+        return NULL;
+    }
+
+    const unsigned char* file = (const unsigned char*)mapped;
+    SnapshotLayout layout;
+    if (!snapshot_valid(file, size, filename, &layout)) {
+        munmap(mapped, size);
+        return NULL;
+    }
+    const SnapshotHeader* header = (const SnapshotHeader*)file;
+    int n = header->num_vertices;
+
+    Graph* graph = (Graph*)malloc(sizeof(Graph));
+    graph->vertices = (Vertex*)malloc(sizeof(Vertex) * (n > 0 ? n : 1));
+    graph->num_vertices = n;
+    graph->capacity = n;
+    graph->arena = NULL;  // Nothing to allocate from: the graph never changes
+    graph->free_edges = NULL;
+    graph->mapped = mapped;
+    graph->mapped_bytes = size;
+    graph->version = 0;  // Never changes
+    memset(&graph->counters, 0, sizeof(GraphCounters));
+
+    // Vertices point at their names in place; hashes were stored so lookups skip rehashing
+    const uint32_t* hashes = (const uint32_t*)(file + layout.hashes);
+    const uint32_t* name_offsets = (const uint32_t*)(file + layout.name_offsets);
+    for (int v = 0; v < n; v++) {
+        graph->vertices[v].name = (char*)(file + layout.names + name_offsets[v]);
+        graph->vertices[v].edges = NULL;  // Edges are only in the CSR arrays
+        graph->vertices[v].hash = hashes[v];
+    }
+
+    graph->index = (int*)(file + layout.index);
+    graph->index_capacity = header->index_capacity;
+    graph->coords = (header->flags & SNAPSHOT_HAS_COORDS) ? (Coordinate*)(file + layout.coords) : NULL;
+    graph->original = (header->flags & SNAPSHOT_HAS_ORDER) ? (int*)(file + layout.original) : NULL;
+
+    CsrGraph* csr = (CsrGraph*)malloc(sizeof(CsrGraph));
+    csr->num_vertices = n;
+    csr->num_edges = header->num_edges;
+    csr->offsets = (int*)(file + layout.offsets);
+    csr->dest = (int*)(file + layout.dest);
+    csr->weight = (int*)(file + layout.weight);
+    csr->max_weight = header->max_weight;
+    csr->min_weight = 0;  // Checked above: no weight is negative
+    graph->csr = csr;
+
+    // Labels are read in place; the member lists are only needed to merge, which never happens here
+    graph->component = (int*)(file + layout.component);
+    graph->component_size = (int*)(file + layout.component_size);
+    graph->component_next = NULL;
+    graph->components_stale = false;
+
+    return graph;
+}
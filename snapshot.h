@@ -0,0 +1,64 @@
+/**
+ * Name: Siddharth Kakked
+ * Semester: Fall 2025
+ * CS 5008
+ * Binary graph snapshots loaded with mmap
+ *
+ * A snapshot stores the frozen CSR arrays, the name hash index, the city
+ * names and the connected component labels (plus coordinates when the
+ * graph has them) exactly as they sit in memory. Loading maps the file and
+ * points the graph at the mapped pages, so startup does no parsing and no
+ * per-edge allocation. Snapshot graphs are read-only.
+ *
+ * Loading is not free of reads, though: the checksum covers the whole body,
+ * so every page of the file is touched at startup, and a bounds pass then
+ * checks every offset, destination, weight, index slot and label before the graph
+ * is handed out.
+ *
+ * File layout (native byte order, every section 8-byte aligned):
+ *   SnapshotHeader
+ *   offsets[num_vertices + 1], dest[num_edges], weight[num_edges]   (int32)
+ *   hashes[num_vertices], name_offsets[num_vertices]                (uint32)
+ *   index[index_capacity]                                           (int32)
+ *   names (NUL-terminated, name_bytes in total)
+ *   coords[num_vertices]                                (only with coordinates)
+ *   original[num_vertices]                       (int32, only for a relabeled graph)
+ *   component[num_vertices], component_size[num_vertices]          (int32)
+ */
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "graph.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#define SNAPSHOT_MAGIC "CITYSNAP"     // First 8 bytes of every snapshot
+#define SNAPSHOT_VERSION 4            // Bumped whenever the layout changes
+#define SNAPSHOT_BYTE_ORDER 0x01020304u // Reads back differently on a foreign-endian machine
+#define SNAPSHOT_HAS_COORDS 0x1u      // Flag: a coordinates section follows the names
+#define SNAPSHOT_HAS_ORDER 0x2u       // Flag: file positions of relabeled vertices come last
+
+// Fixed-size header at the start of the file
+typedef struct SnapshotHeader {
+    char magic[8];          // SNAPSHOT_MAGIC
+    uint32_t version;       // SNAPSHOT_VERSION
+    uint32_t byte_order;    // SNAPSHOT_BYTE_ORDER as written
+    uint32_t flags;         // SNAPSHOT_HAS_COORDS, SNAPSHOT_HAS_ORDER
+    int32_t num_vertices;
+    int32_t num_edges;      // Directed edges in the CSR arrays
+    int32_t index_capacity; // Slots in the name index (power of two)
+    int32_t max_weight;     // Longest road (CsrGraph.max_weight); loading checks every weight against it
+    int32_t padding;        // Zero; keeps the 64-bit fields aligned
+    uint64_t name_bytes;    // Size of the names section
+    uint64_t file_bytes;    // Total file size, header included
+    uint64_t checksum;      // Hash of everything after the header
+} SnapshotHeader;
+
+// Write a graph (frozen first if needed) to a snapshot file
+bool snapshot_write(Graph* graph, const char* filename);
+
+// Map a snapshot and return a read-only graph over it, NULL on any error
+Graph* snapshot_load(const char* filename);
+
+#endif
@@ -8,12 +8,32 @@
  // Project Headers
 #include "graph.h" 
 #include "dijkstra.h"
+#include "heap.h"
+#include "arena.h"
+#include "loader.h"
+#include "astar.h"
+#include "ch.h"
+#include "parallel.h"
+#include "batch.h"
+#include "snapshot.h"
+#include "cache.h"
+#include "profile.h"
+#include "reorder.h"
+#include "server.h"
+#include "delta.h"
+#include "apsp.h"
+#include "compact.h"
 
 // Standard Libraries
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
 
 // Test counters
 static int tests_run = 0;
@@ -32,6 +52,51 @@ void assert_test(bool condition, const char* test_name) {
     }
 }
 
+/**
+ * Build a random graph named v0..v(n-1) from a fixed linear congruential generator
+ * Fewer edges than vertices leaves some of them disconnected
+ */
+Graph* build_random_graph(int n, int num_edges, unsigned int seed, int max_weight) {
+    Graph* graph = graph_create(n);
+    char name[16];
+    for (int i = 0; i < n; i++) {
+        snprintf(name, sizeof(name), "v%d", i);
+        graph_add_vertex(graph, name);
+    }
+    for (int e = 0; e < num_edges; e++) {
+        seed = seed * 1103515245u + 12345u;
+        int a = (seed >> 8) % n;
+        seed = seed * 1103515245u + 12345u;
+        int b = (seed >> 8) % n;
+        seed = seed * 1103515245u + 12345u;
+        if (a != b) graph_add_edge_index(graph, a, b, 1 + (seed >> 8) % max_weight);
+    }
+    return graph;
+}
+
+/**
+ * Check that a path runs start -> end over real edges and sums to its distance
+ */
+bool path_is_valid(Graph* graph, const PathResult* result, int start, int end) {
+    if (!result->found) return result->path == NULL;
+    if (result->path_length < 1 || result->path[0] != start ||
+        result->path[result->path_length - 1] != end) return false;
+    
+    long total = 0;
+    for (int i = 0; i + 1 < result->path_length; i++) {
+        // Cheapest edge between consecutive vertices (parallel roads may exist)
+        int best = -1;
+        for (EdgeNode* edge = graph->vertices[result->path[i]].edges; edge; edge = edge->next) {
+            if (edge->dest == result->path[i + 1] && (best == -1 || edge->weight < best)) {
+                best = edge->weight;
+            }
+        }
+        if (best == -1) return false;
+        total += best;
+    }
+    return total == result->total_distance;
+}
+
 // Test 1: Graph Creation
 void test_graph_creation() {
     printf("\n=== Test 1: Graph Creation ===\n");
@@ -130,6 +195,1744 @@ void test_shortest_path() {
     graph_destroy(graph);
 }
 
+/**
+ * Test 6: Priority Queue Ordering
+ */
+void test_priority_queue() {
+    printf("\n=== Test 6: Priority Queue Ordering ===\n");
+    
+    PriorityQueue* pq = pq_create(6);
+    pq_push(pq, 0, 50);
+    pq_push(pq, 1, 20);
+    pq_push(pq, 2, 40);
+    pq_push(pq, 3, 10);
+    pq_push(pq, 4, 30);
+    
+    bool lowered = pq_push(pq, 2, 5);   // Decrease key
+    bool raised = pq_push(pq, 3, 99);   // Larger key is ignored
+    assert_test(lowered && !raised, "Decrease-key only accepts smaller keys");
+    assert_test(pq_min_key(pq) == 5, "Minimum key reflects decrease-key");
+    
+    int expected[] = {2, 3, 1, 4, 0};
+    bool in_order = true;
+    for (int i = 0; i < 5; i++) {
+        if (pq_pop(pq, NULL) != expected[i]) in_order = false;
+    }
+    assert_test(in_order, "Vertices come out in key order");
+    assert_test(pq_is_empty(pq) && !pq_contains(pq, 0), "Queue is empty after popping everything");
+    
+    pq_push(pq, 5, 1);
+    pq_push(pq, 1, 2);
+    pq_clear(pq);
+    assert_test(pq_is_empty(pq) && !pq_contains(pq, 5), "Clear empties the queue");
+    
+    pq_destroy(pq);
+}
+
+/**
+ * Test 7: Heap Dijkstra matches the linear scan version
+ */
+void test_heap_matches_scan() {
+    printf("\n=== Test 7: Heap Dijkstra Matches Scan ===\n");
+    
+    // Random sparse graph from a fixed linear congruential generator
+    int n = 200;
+    unsigned int seed = 42;
+    Graph* graph = graph_create(n);
+    char name[16];
+    for (int i = 0; i < n; i++) {
+        snprintf(name, sizeof(name), "v%d", i);
+        graph_add_vertex(graph, name);
+    }
+    for (int e = 0; e < n * 2; e++) {
+        seed = seed * 1103515245u + 12345u;
+        int a = (seed >> 8) % n;
+        seed = seed * 1103515245u + 12345u;
+        int b = (seed >> 8) % n;
+        seed = seed * 1103515245u + 12345u;
+        if (a != b) graph_add_edge_index(graph, a, b, 1 + (seed >> 8) % 100);
+    }
+    
+    bool all_match = true;
+    for (int q = 0; q < 50; q++) {
+        int start = (q * 37) % n;
+        int end = (q * 91 + 5) % n;
+        PathResult heap = dijkstra_shortest_path(graph, start, end);
+        PathResult scan = dijkstra_shortest_path_scan(graph, start, end);
+        if (heap.found != scan.found || heap.total_distance != scan.total_distance) {
+            all_match = false;
+        }
+        path_result_destroy(&heap);
+        path_result_destroy(&scan);
+    }
+    assert_test(all_match, "Heap and scan agree on 50 random queries");
+    
+    graph_destroy(graph);
+}
+
+/**
+ * Test 8: Hash Index Lookups
+ */
+void test_hash_index() {
+    printf("\n=== Test 8: Hash Index Lookups ===\n");
+    
+    // Start tiny so the index has to grow several times
+    Graph* graph = graph_create(2);
+    char name[16];
+    int n = 5000;
+    for (int i = 0; i < n; i++) {
+        snprintf(name, sizeof(name), "city%d", i);
+        graph_add_vertex(graph, name);
+    }
+    assert_test(graph->num_vertices == n, "All 5000 vertices added");
+    assert_test(graph->index_capacity >= 2 * n, "Index keeps load factor at most 1/2");
+    
+    bool all_found = true;
+    for (int i = 0; i < n; i++) {
+        snprintf(name, sizeof(name), "city%d", i);
+        if (graph_find_vertex(graph, name) != i) all_found = false;
+    }
+    assert_test(all_found, "Every vertex found at its insertion index");
+    
+    snprintf(name, sizeof(name), "city%d", 1234);
+    assert_test(graph_add_vertex(graph, name) == 1234, "Duplicate insert returns existing index after growth");
+    assert_test(graph_find_vertex(graph, "city5000") == -1, "Missing name returns -1");
+    assert_test(graph_find_vertex(graph, "") == -1, "Empty name returns -1");
+    
+    graph_destroy(graph);
+}
+
+/**
+ * Test 9: Frozen CSR Layout
+ */
+void test_csr_layout() {
+    printf("\n=== Test 9: Frozen CSR Layout ===\n");
+    
+    Graph* graph = graph_create(5);
+    graph_add_vertex(graph, "a");
+    graph_add_vertex(graph, "b");
+    graph_add_vertex(graph, "c");
+    graph_add_vertex(graph, "d");
+    graph_add_edge(graph, "a", "b", 5);
+    graph_add_edge(graph, "a", "c", 2);
+    graph_add_edge(graph, "b", "d", 1);
+    graph_add_edge(graph, "c", "d", 1);
+    
+    const CsrGraph* csr = graph_freeze(graph);
+    assert_test(csr == graph->csr && csr->num_edges == 8, "Freeze stores both directions of 4 roads");
+    assert_test(csr->offsets[0] == 0 && csr->offsets[1] == 2 && csr->offsets[4] == 8, "Offsets follow vertex degrees");
+    assert_test(csr->dest[0] == 2 && csr->weight[0] == 2, "Edges keep adjacency list order");
+    
+    PathResult frozen = dijkstra_shortest_path(graph, 0, 3);
+    PathResult scan = dijkstra_shortest_path_scan(graph, 0, 3);
+    assert_test(frozen.found && frozen.total_distance == scan.total_distance, "CSR search matches list search");
+    path_result_destroy(&frozen);
+    path_result_destroy(&scan);
+    
+    graph_add_edge(graph, "a", "d", 1);
+    assert_test(graph->csr == NULL, "Adding an edge thaws the graph");
+    
+    graph_destroy(graph);
+}
+
+/**
+ * Test 10: Arena Allocation
+ */
+void test_arena() {
+    printf("\n=== Test 10: Arena Allocation ===\n");
+    
+    Arena* arena = arena_create(64);
+    char* name = arena_strdup(arena, "boston");
+    void* block = arena_alloc(arena, 24);
+    assert_test(strcmp(name, "boston") == 0, "strdup copies the string");
+    assert_test((uintptr_t)block % sizeof(void*) == 0, "Allocations are pointer aligned");
+    
+    // Larger than the first block forces a new, bigger block
+    void* big = arena_alloc(arena, 1000);
+    assert_test(big != NULL && arena->num_blocks == 2, "Oversized request gets its own block");
+    assert_test(arena->bytes_used == 7 + 24 + 1000, "Used bytes are tracked");
+    arena_destroy(arena);
+    
+    // Graph names and edges come out of the graph's arena
+    Graph* graph = graph_create(4);
+    graph_add_vertex(graph, "a");
+    graph_add_vertex(graph, "b");
+    graph_add_edge(graph, "a", "b", 3);
+    GraphMemoryStats stats;
+    graph_memory_stats(graph, &stats);
+    assert_test(stats.name_bytes == 4 && stats.edge_bytes == 2 * sizeof(EdgeNode), "Stats count names and edges");
+    assert_test(stats.arena_blocks == 1 && stats.total_bytes >= stats.arena_reserved, "Whole graph fits one arena block");
+    graph_destroy(graph);
+}
+
+/**
+ * Test 11: Reused Query Workspace
+ */
+void test_workspace_reuse() {
+    printf("\n=== Test 11: Reused Query Workspace ===\n");
+    
+    Graph* graph = graph_create(5);
+    graph_add_vertex(graph, "a");
+    graph_add_vertex(graph, "b");
+    graph_add_vertex(graph, "c");
+    graph_add_vertex(graph, "d");
+    graph_add_vertex(graph, "e");
+    graph_add_edge(graph, "a", "b", 5);
+    graph_add_edge(graph, "a", "c", 2);
+    graph_add_edge(graph, "b", "d", 1);
+    graph_add_edge(graph, "c", "d", 1);
+    
+    // Workspace starts smaller than the graph and must grow
+    DijkstraWorkspace* ws = dijkstra_workspace_create(2);
+    bool all_match = true;
+    for (int round = 0; round < 3; round++) {
+        for (int start = 0; start < 5; start++) {
+            for (int end = 0; end < 5; end++) {
+                PathResult reused = dijkstra_shortest_path_ws(graph, ws, start, end);
+                PathResult fresh = dijkstra_shortest_path_scan(graph, start, end);
+                if (reused.found != fresh.found || reused.total_distance != fresh.total_distance ||
+                    reused.path_length != fresh.path_length) {
+                    all_match = false;
+                }
+                path_result_destroy(&reused);
+                path_result_destroy(&fresh);
+            }
+        }
+    }
+    assert_test(all_match, "75 queries on one workspace match fresh searches");
+    assert_test(ws->capacity >= 5, "Workspace grew to the graph size");
+    
+    PathResult isolated = dijkstra_shortest_path_ws(graph, ws, 0, 4);
+    assert_test(!isolated.found && isolated.path == NULL, "Stale entries do not leak into unreachable queries");
+    
+    dijkstra_workspace_destroy(ws);
+    graph_destroy(graph);
+}
+
+/**
+ * Compare bidirectional search against the unidirectional search on every pair
+ * Returns false on the first disagreement
+ */
+bool bidirectional_matches(Graph* graph, int* uni_settled, int* bi_settled) {
+    int n = graph->num_vertices;
+    DijkstraWorkspace* ws = dijkstra_workspace_create(n);
+    DijkstraWorkspace* forward = dijkstra_workspace_create(n);
+    DijkstraWorkspace* backward = dijkstra_workspace_create(n);
+    bool ok = true;
+    
+    for (int start = 0; start < n && ok; start++) {
+        for (int end = 0; end < n && ok; end++) {
+            PathResult uni = dijkstra_shortest_path_ws(graph, ws, start, end);
+            PathResult bi = dijkstra_bidirectional_ws(graph, forward, backward, start, end);
+            ok = uni.found == bi.found && uni.total_distance == bi.total_distance &&
+                 path_is_valid(graph, &bi, start, end);
+            *uni_settled += uni.settled;
+            *bi_settled += bi.settled;
+            path_result_destroy(&uni);
+            path_result_destroy(&bi);
+        }
+    }
+    
+    dijkstra_workspace_destroy(ws);
+    dijkstra_workspace_destroy(forward);
+    dijkstra_workspace_destroy(backward);
+    return ok;
+}
+
+/**
+ * Test 12: Bidirectional Dijkstra
+ */
+void test_bidirectional() {
+    printf("\n=== Test 12: Bidirectional Dijkstra ===\n");
+    
+    // Bundled data set, every ordered pair of cities
+    Graph* graph = graph_create(50);
+    bool loaded = load_vertices(graph, "cities_large.txt") &&
+                  load_distances(graph, "cities_distances_large.txt");
+    assert_test(loaded, "Loaded cities_large.txt and cities_distances_large.txt");
+    
+    int uni_settled = 0, bi_settled = 0;
+    assert_test(loaded && bidirectional_matches(graph, &uni_settled, &bi_settled),
+                "Bidirectional matches unidirectional on every bundled pair");
+    graph_freeze(graph);
+    assert_test(bidirectional_matches(graph, &uni_settled, &bi_settled),
+                "Bidirectional matches unidirectional on the frozen layout");
+    graph_destroy(graph);
+    
+    // Random graphs, sparse enough that some pairs are disconnected
+    bool random_ok = true;
+    for (unsigned int seed = 1; seed <= 5 && random_ok; seed++) {
+        Graph* random = build_random_graph(60, 50 + 10 * seed, seed, 20);
+        random_ok = bidirectional_matches(random, &uni_settled, &bi_settled);
+        graph_destroy(random);
+    }
+    assert_test(random_ok, "Bidirectional matches unidirectional on random graphs");
+    
+    Graph* tiny = graph_create(2);
+    graph_add_vertex(tiny, "a");
+    PathResult same = dijkstra_bidirectional(tiny, 0, 0);
+    assert_test(same.found && same.total_distance == 0 && same.path_length == 1, "Start equal to end is a one-city path");
+    path_result_destroy(&same);
+    graph_destroy(tiny);
+    
+    printf("  settled vertices: unidirectional %d, bidirectional %d\n", uni_settled, bi_settled);
+}
+
+/**
+ * Test 13: A* With Coordinate and Landmark Heuristics
+ */
+void test_astar() {
+    printf("\n=== Test 13: A* Heuristics ===\n");
+    
+    // Jittered 12x12 grid of cities; roads follow the grid with a detour factor
+    int side = 12;
+    Graph* graph = graph_create(side * side);
+    char name[16];
+    unsigned int seed = 7;
+    for (int i = 0; i < side * side; i++) {
+        snprintf(name, sizeof(name), "g%d", i);
+        graph_add_vertex(graph, name);
+        seed = seed * 1103515245u + 12345u;
+        double jitter = ((seed >> 8) % 100) / 1000.0;
+        graph_set_coordinates(graph, i, 40.0 + (i / side) * 0.2 + jitter, -90.0 + (i % side) * 0.2 - jitter);
+    }
+    for (int i = 0; i < side * side; i++) {
+        int neighbours[2] = {i % side + 1 < side ? i + 1 : -1, i + side < side * side ? i + side : -1};
+        for (int k = 0; k < 2; k++) {
+            if (neighbours[k] == -1) continue;
+            seed = seed * 1103515245u + 12345u;
+            double km = great_circle_km(graph->coords[i], graph->coords[neighbours[k]]);
+            graph_add_edge_index(graph, i, neighbours[k], (int)(km * (1.0 + ((seed >> 8) % 50) / 100.0)) + 1);
+        }
+    }
+    graph_freeze(graph);
+    
+    Heuristic* coords = heuristic_coordinates(graph);
+    Heuristic* landmarks = heuristic_landmarks(graph, 4);
+    assert_test(coords != NULL && coords->scale > 0, "Coordinate heuristic built with a positive scale");
+    assert_test(landmarks->num_landmarks == 4, "Four landmarks chosen");
+    
+    bool coords_match = true, landmarks_match = true, admissible = true;
+    int dijkstra_settled = 0, coords_settled = 0;
+    for (int q = 0; q < 60; q++) {
+        int start = (q * 53) % (side * side);
+        int end = (q * 29 + 11) % (side * side);
+        PathResult plain = dijkstra_shortest_path(graph, start, end);
+        PathResult a = astar_shortest_path(graph, coords, start, end);
+        PathResult alt = astar_shortest_path(graph, landmarks, start, end);
+        coords_match = coords_match && a.total_distance == plain.total_distance && path_is_valid(graph, &a, start, end);
+        landmarks_match = landmarks_match && alt.total_distance == plain.total_distance && path_is_valid(graph, &alt, start, end);
+        admissible = admissible && heuristic_estimate(coords, start, end) <= plain.total_distance &&
+                     heuristic_estimate(landmarks, start, end) <= plain.total_distance;
+        dijkstra_settled += plain.settled;
+        coords_settled += a.settled;
+        path_result_destroy(&plain);
+        path_result_destroy(&a);
+        path_result_destroy(&alt);
+    }
+    assert_test(coords_match, "Coordinate A* matches Dijkstra");
+    assert_test(landmarks_match, "Landmark A* matches Dijkstra");
+    assert_test(admissible, "Estimates never exceed the true distance");
+    assert_test(coords_settled < dijkstra_settled, "Coordinate A* settles fewer vertices");
+    heuristic_destroy(coords);
+    heuristic_destroy(landmarks);
+    graph_destroy(graph);
+    
+    // ALT on the bundled data (no coordinates available)
+    Graph* cities = graph_create(50);
+    load_vertices(cities, "cities_large.txt");
+    load_distances(cities, "cities_distances_large.txt");
+    assert_test(heuristic_coordinates(cities) == NULL, "No coordinate heuristic without coordinates");
+    Heuristic* alt = heuristic_landmarks(cities, DEFAULT_LANDMARKS);
+    bool bundled_match = true;
+    for (int start = 0; start < cities->num_vertices; start++) {
+        for (int end = 0; end < cities->num_vertices; end++) {
+            PathResult plain = dijkstra_shortest_path(cities, start, end);
+            PathResult a = astar_shortest_path(cities, alt, start, end);
+            bundled_match = bundled_match && plain.found == a.found && plain.total_distance == a.total_distance;
+            path_result_destroy(&plain);
+            path_result_destroy(&a);
+        }
+    }
+    assert_test(bundled_match, "Landmark A* matches Dijkstra on every bundled pair");
+    heuristic_destroy(alt);
+    graph_destroy(cities);
+}
+
+/**
+ * Compare hierarchy queries with Dijkstra on every pair, checking unpacked paths
+ */
+bool ch_matches(Graph* graph, const ContractionHierarchy* ch) {
+    int n = graph->num_vertices;
+    DijkstraWorkspace* ws = dijkstra_workspace_create(n);
+    DijkstraWorkspace* forward = dijkstra_workspace_create(n);
+    DijkstraWorkspace* backward = dijkstra_workspace_create(n);
+    bool ok = true;
+    
+    for (int start = 0; start < n && ok; start++) {
+        for (int end = 0; end < n && ok; end++) {
+            PathResult plain = dijkstra_shortest_path_ws(graph, ws, start, end);
+            PathResult hierarchy = ch_shortest_path_ws(ch, forward, backward, start, end);
+            ok = plain.found == hierarchy.found && plain.total_distance == hierarchy.total_distance &&
+                 path_is_valid(graph, &hierarchy, start, end);
+            path_result_destroy(&plain);
+            path_result_destroy(&hierarchy);
+        }
+    }
+    
+    dijkstra_workspace_destroy(ws);
+    dijkstra_workspace_destroy(forward);
+    dijkstra_workspace_destroy(backward);
+    return ok;
+}
+
+/**
+ * Test 14: Contraction Hierarchies
+ */
+void test_contraction_hierarchy() {
+    printf("\n=== Test 14: Contraction Hierarchies ===\n");
+    
+    Graph* graph = graph_create(50);
+    load_vertices(graph, "cities_large.txt");
+    load_distances(graph, "cities_distances_large.txt");
+    ContractionHierarchy* ch = ch_build(graph);
+    
+    bool ranks_unique = true;
+    bool* seen = (bool*)calloc(graph->num_vertices, sizeof(bool));
+    for (int v = 0; v < graph->num_vertices; v++) {
+        int r = ch->rank[v];
+        if (r < 0 || r >= graph->num_vertices || seen[r]) ranks_unique = false;
+        else seen[r] = true;
+    }
+    free(seen);
+    assert_test(ranks_unique, "Every vertex gets a distinct rank");
+    assert_test(ch_matches(graph, ch), "Hierarchy matches Dijkstra on every bundled pair");
+    ch_destroy(ch);
+    graph_destroy(graph);
+    
+    // Random graphs with disconnected parts and parallel roads
+    bool random_ok = true;
+    for (unsigned int seed = 11; seed <= 15 && random_ok; seed++) {
+        Graph* random = build_random_graph(80, 120 + 20 * (seed - 11), seed, 30);
+        ContractionHierarchy* random_ch = ch_build(random);
+        random_ok = ch_matches(random, random_ch);
+        ch_destroy(random_ch);
+        graph_destroy(random);
+    }
+    assert_test(random_ok, "Hierarchy matches Dijkstra on random graphs");
+    
+    // Zero-length roads still need shortcuts when their middle city is contracted
+    Graph* free_roads = graph_create(4);
+    graph_add_vertex(free_roads, "a");
+    graph_add_vertex(free_roads, "b");
+    graph_add_vertex(free_roads, "c");
+    graph_add_edge(free_roads, "a", "b", 0);
+    graph_add_edge(free_roads, "b", "c", 0);
+    ContractionHierarchy* free_ch = ch_build(free_roads);
+    bool zero_ok = ch_matches(free_roads, free_ch);
+    ch_destroy(free_ch);
+    graph_destroy(free_roads);
+    for (unsigned int seed = 31; seed <= 35 && zero_ok; seed++) {
+        Graph* random = build_random_graph(80, 160, seed, 2);
+        for (int u = 0; u < random->num_vertices; u++) {
+            for (EdgeNode* edge = random->vertices[u].edges; edge; edge = edge->next) {
+                if (edge->weight == 1 && u < edge->dest) graph_update_edge_index(random, u, edge->dest, 0);
+            }
+        }
+        ContractionHierarchy* random_ch = ch_build(random);
+        zero_ok = ch_matches(random, random_ch);
+        ch_destroy(random_ch);
+        graph_destroy(random);
+    }
+    assert_test(zero_ok, "Hierarchy matches Dijkstra over zero-length roads");
+}
+
+/**
+ * parallel_for task: count visits of each index
+ */
+void count_visit(void* context, int worker, int index) {
+    (void)worker;
+    ((int*)context)[index]++;
+}
+
+/**
+ * Read a whole stream back from the start into a malloc'd string
+ */
+char* read_stream(FILE* file) {
+    long size = ftell(file);
+    char* text = (char*)malloc(size + 1);
+    rewind(file);
+    size_t got = fread(text, 1, size, file);
+    text[got] = '\0';
+    return text;
+}
+
+/**
+ * Test 15: Parallel Batch Queries
+ */
+void test_batch_queries() {
+    printf("\n=== Test 15: Parallel Batch Queries ===\n");
+    
+    // Every index runs exactly once whatever the thread count
+    bool each_once = true;
+    int thread_counts[] = {1, 3, 8};
+    for (int t = 0; t < 3; t++) {
+        int visits[1000] = {0};
+        parallel_for(1000, thread_counts[t], count_visit, visits);
+        for (int i = 0; i < 1000; i++) {
+            if (visits[i] != 1) each_once = false;
+        }
+    }
+    assert_test(each_once, "parallel_for runs every index exactly once");
+    
+    // A pool runs round after round on the same threads, tiny and empty rounds included
+    ParallelPool* pool = parallel_pool_create(3);
+    int round_sizes[] = {1000, 0, 1, 2, 1000};
+    for (int r = 0; r < 5; r++) {
+        int visits[1000] = {0};
+        parallel_pool_run(pool, round_sizes[r], count_visit, visits);
+        for (int i = 0; i < 1000; i++) {
+            if (visits[i] != (i < round_sizes[r])) each_once = false;
+        }
+    }
+    parallel_pool_destroy(pool);
+    assert_test(each_once, "Thread pool runs every index once per round");
+    
+    Graph* graph = graph_create(50);
+    load_vertices(graph, "cities_large.txt");
+    load_distances(graph, "cities_distances_large.txt");
+    graph_freeze(graph);
+    RouteEngine engine = {graph, NULL, NULL, false, NULL, NULL};
+    
+    // All ordered pairs plus a few bad lines, answered one by one for reference
+    FILE* queries = tmpfile();
+    FILE* expected = tmpfile();
+    DijkstraWorkspace* ws = dijkstra_workspace_create(graph->num_vertices);
+    for (int a = 0; a < graph->num_vertices; a++) {
+        for (int b = 0; b < graph->num_vertices; b++) {
+            fprintf(queries, "%s %s\n", graph->vertices[a].name, graph->vertices[b].name);
+            PathResult result = dijkstra_shortest_path_ws(graph, ws, a, b);
+            route_print(expected, graph, &result);
+            path_result_destroy(&result);
+        }
+        if (a % 10 == 0) {
+            fprintf(queries, "\nnowhere %s\n", graph->vertices[a].name);
+            fputs("Invalid Command\n", expected);
+        }
+    }
+    dijkstra_workspace_destroy(ws);
+    char* reference = read_stream(expected);
+    
+    bool ordered = true;
+    bool counted = true;
+    for (int t = 0; t < 3; t++) {
+        FILE* out = tmpfile();
+        BatchStats stats;
+        rewind(queries);
+        batch_run(&engine, queries, out, thread_counts[t], &stats);
+        char* text = read_stream(out);
+        if (strcmp(text, reference) != 0) ordered = false;
+        if (stats.queries != graph->num_vertices * graph->num_vertices ||
+            stats.invalid != (graph->num_vertices + 9) / 10) counted = false;
+        free(text);
+        fclose(out);
+    }
+    assert_test(ordered, "Batch output matches sequential answers in input order");
+    assert_test(counted, "Batch counts valid and invalid lines, skipping blank ones");
+    
+    free(reference);
+    fclose(queries);
+    fclose(expected);
+    graph_destroy(graph);
+}
+
+/**
+ * Test 16: Distance Tables
+ */
+void test_distance_table() {
+    printf("\n=== Test 16: Distance Tables ===\n");
+    
+    // Sparse random graph: some pairs unreachable; a repeated target and source itself
+    Graph* graph = build_random_graph(120, 110, 16, 40);
+    int sources[] = {0, 5, 17, 42, 99, 119};
+    int targets[] = {3, 0, 17, 64, 3, 100, 118};
+    int n_src = 6, n_tgt = 7;
+    
+    int* table = (int*)malloc(sizeof(int) * n_src * n_tgt);
+    dijkstra_distance_table(graph, sources, n_src, targets, n_tgt, table);
+    
+    bool matches = true;
+    bool saw_unreachable = false;
+    for (int i = 0; i < n_src; i++) {
+        for (int j = 0; j < n_tgt; j++) {
+            PathResult single = dijkstra_shortest_path(graph, sources[i], targets[j]);
+            int expected = single.found ? single.total_distance : INT_MAX;
+            if (table[i * n_tgt + j] != expected) matches = false;
+            if (!single.found) saw_unreachable = true;
+            path_result_destroy(&single);
+        }
+    }
+    assert_test(matches && saw_unreachable, "Table matches pairwise Dijkstra, INT_MAX when unreachable");
+    
+    // Parallel variant with paths
+    int* parallel = (int*)malloc(sizeof(int) * n_src * n_tgt);
+    PathResult* paths = (PathResult*)malloc(sizeof(PathResult) * n_src * n_tgt);
+    DistanceTableOptions options = {3, paths};
+    dijkstra_distance_table_parallel(graph, sources, n_src, targets, n_tgt, parallel, &options);
+    
+    bool same = memcmp(table, parallel, sizeof(int) * n_src * n_tgt) == 0;
+    bool paths_ok = true;
+    for (int i = 0; i < n_src; i++) {
+        for (int j = 0; j < n_tgt; j++) {
+            PathResult* path = &paths[i * n_tgt + j];
+            if (!path_is_valid(graph, path, sources[i], targets[j]) ||
+                (path->found ? path->total_distance : INT_MAX) != table[i * n_tgt + j]) {
+                paths_ok = false;
+            }
+            path_result_destroy(path);
+        }
+    }
+    assert_test(same, "Parallel table matches the sequential one");
+    assert_test(paths_ok, "Optional paths are valid and agree with the table");
+    
+    free(table);
+    free(parallel);
+    free(paths);
+    graph_destroy(graph);
+}
+
+/**
+ * Recompute a snapshot's checksum after its body was edited (FNV-1a over 64-bit words)
+ */
+void reseal_snapshot(const char* filename) {
+    FILE* file = fopen(filename, "r+b");
+    SnapshotHeader header;
+    if (fread(&header, sizeof(header), 1, file) != 1) {
+        fclose(file);
+        return;
+    }
+    uint64_t hash = 14695981039346656037ull;
+    uint64_t word;
+    while (fread(&word, sizeof(word), 1, file) == 1) {
+        hash ^= word;
+        hash *= 1099511628211ull;
+    }
+    header.checksum = hash;
+    fseek(file, 0, SEEK_SET);
+    fwrite(&header, sizeof(header), 1, file);
+    fclose(file);
+}
+
+/**
+ * Test 17: Graph Snapshots
+ */
+void test_snapshot() {
+    printf("\n=== Test 17: Graph Snapshots ===\n");
+    const char* filename = "test_snapshot.bin";
+    
+    Graph* graph = graph_create(50);
+    load_vertices(graph, "cities_large.txt");
+    load_distances(graph, "cities_distances_large.txt");
+    assert_test(snapshot_write(graph, filename), "Snapshot written");
+    
+    Graph* mapped = snapshot_load(filename);
+    assert_test(mapped != NULL && graph_is_read_only(mapped), "Snapshot maps back as a read-only graph");
+    
+    // Same names, same lookups and the same answer for every pair
+    bool same = mapped && mapped->num_vertices == graph->num_vertices;
+    for (int v = 0; same && v < graph->num_vertices; v++) {
+        same = strcmp(mapped->vertices[v].name, graph->vertices[v].name) == 0 &&
+               graph_find_vertex(mapped, graph->vertices[v].name) == v;
+    }
+    same = same && graph_find_vertex(mapped, "Atlantis") == -1 &&
+           mapped->csr->max_weight == graph->csr->max_weight;
+    for (int a = 0; same && a < graph->num_vertices; a++) {
+        for (int b = 0; same && b < graph->num_vertices; b++) {
+            PathResult expected = dijkstra_shortest_path(graph, a, b);
+            PathResult actual = dijkstra_shortest_path(mapped, a, b);
+            same = expected.found == actual.found && expected.total_distance == actual.total_distance &&
+                   expected.path_length == actual.path_length &&
+                   (!expected.found || memcmp(expected.path, actual.path, sizeof(int) * expected.path_length) == 0);
+            path_result_destroy(&expected);
+            path_result_destroy(&actual);
+        }
+    }
+    assert_test(same, "Snapshot answers every pair like the text-loaded graph");
+    
+    if (mapped) {
+        assert_test(graph_add_vertex(mapped, "Atlantis") == -1 && !graph_add_edge_index(mapped, 0, 1, 5),
+                    "Snapshot graph refuses changes");
+        graph_destroy(mapped);
+    }
+    
+    // Flip one byte in the body: the checksum must catch it
+    FILE* file = fopen(filename, "r+b");
+    fseek(file, (long)sizeof(SnapshotHeader) + 3, SEEK_SET);
+    int byte = fgetc(file);
+    fseek(file, (long)sizeof(SnapshotHeader) + 3, SEEK_SET);
+    fputc(byte ^ 0x40, file);
+    fclose(file);
+    assert_test(snapshot_load(filename) == NULL, "Corrupted snapshot is rejected");
+    
+    // Point the first road past the last city and fix up the checksum: the bounds pass must catch it
+    snapshot_write(graph, filename);
+    long dest_at = (long)(sizeof(SnapshotHeader) + ((sizeof(int32_t) * (graph->num_vertices + 1) + 7) & ~(size_t)7));
+    int32_t far = graph->num_vertices + 5;
+    file = fopen(filename, "r+b");
+    fseek(file, dest_at, SEEK_SET);
+    fwrite(&far, sizeof(far), 1, file);
+    fclose(file);
+    reseal_snapshot(filename);
+    assert_test(snapshot_load(filename) == NULL, "Out-of-range road with a valid checksum is rejected");
+    
+    // Negative lengths and lengths above the header's max_weight are caught the same way
+    long weight_at = dest_at + (long)((sizeof(int32_t) * graph->csr->num_edges + 7) & ~(size_t)7);
+    int32_t bad_weights[2] = {-4, graph->csr->max_weight + 1};
+    bool weights_rejected = true;
+    for (int i = 0; i < 2; i++) {
+        snapshot_write(graph, filename);
+        file = fopen(filename, "r+b");
+        fseek(file, weight_at, SEEK_SET);
+        fwrite(&bad_weights[i], sizeof(int32_t), 1, file);
+        fclose(file);
+        reseal_snapshot(filename);
+        if (snapshot_load(filename) != NULL) weights_rejected = false;
+    }
+    assert_test(weights_rejected, "Negative or understated road lengths with a valid checksum are rejected");
+    
+    // A text file is not a snapshot
+    assert_test(snapshot_load("cities_large.txt") == NULL, "Non-snapshot file is rejected");
+    
+    remove(filename);
+    graph_destroy(graph);
+}
+
+/**
+ * Test 18: Streaming Loader
+ */
+void test_streaming_loader() {
+    printf("\n=== Test 18: Streaming Loader ===\n");
+    const char* vertices_file = "test_loader_vertices.txt";
+    const char* distances_file = "test_loader_distances.txt";
+    
+    // A name longer than one 1 MB read block, plus CRLF and a last line with no newline
+    size_t long_length = 3 * 1024 * 1024;
+    char* long_name = (char*)malloc(long_length + 1);
+    memset(long_name, 'x', long_length);
+    long_name[long_length] = '\0';
+    
+    FILE* file = fopen(vertices_file, "w");
+    fprintf(file, "alpha\r\n\n%s\nbeta\ngamma", long_name);
+    fclose(file);
+    
+    // Good lines mixed with malformed ones (which must be skipped)
+    file = fopen(distances_file, "w");
+    fprintf(file, "alpha beta 7\n");
+    fprintf(file, "alpha gamma\n");             // Missing distance
+    fprintf(file, "alpha gamma 12km\n");        // Not an integer
+    fprintf(file, "alpha gamma 99999999999\n"); // Overflows int
+    fprintf(file, "alpha gamma -3\n");          // Negative
+    fprintf(file, "alpha nowhere 3\n");         // Unknown city
+    fprintf(file, "\t beta\t%s  40 trailing words\r\n", long_name);
+    fprintf(file, "beta beta 4\n");            // Self loop, stored once
+    fprintf(file, "\n");
+    fprintf(file, "gamma alpha 5");
+    fclose(file);
+    
+    Graph* graph = graph_create(2);
+    bool loaded = load_vertices(graph, vertices_file) && load_distances(graph, distances_file);
+    assert_test(loaded && graph->num_vertices == 4, "Long, CRLF and unterminated lines load as cities");
+    
+    int alpha = graph_find_vertex(graph, "alpha");
+    int beta = graph_find_vertex(graph, "beta");
+    int gamma = graph_find_vertex(graph, "gamma");
+    int longest = graph_find_vertex(graph, long_name);
+    assert_test(alpha == 0 && longest == 1 && beta == 2 && gamma == 3, "Names are kept whole and in file order");
+    
+    int edges = 0;
+    for (int v = 0; v < graph->num_vertices; v++) {
+        for (EdgeNode* edge = graph->vertices[v].edges; edge; edge = edge->next) edges++;
+    }
+    PathResult result = dijkstra_shortest_path(graph, gamma, longest);
+    assert_test(edges == 7 && result.found && result.total_distance == 5 + 7 + 40,
+                "Only the well-formed roads are added");
+    path_result_destroy(&result);
+    
+    // Bulk loading stores a self loop once, like graph_add_edge
+    Graph* incremental = graph_create(4);
+    graph_add_vertex(incremental, "beta");
+    graph_add_edge(incremental, "beta", "beta", 4);
+    const CsrGraph* loaded_csr = graph_freeze(graph);
+    const CsrGraph* incremental_csr = graph_freeze(incremental);
+    assert_test(loaded_csr->offsets[beta + 1] - loaded_csr->offsets[beta] == 3 && incremental_csr->num_edges == 1,
+                "Self loop is one edge in both the loaded and the incremental graph");
+    graph_destroy(incremental);
+    
+    free(long_name);
+    remove(vertices_file);
+    remove(distances_file);
+    graph_destroy(graph);
+}
+
+/**
+ * Check that two graphs have identical adjacency lists, order included
+ */
+bool same_adjacency(Graph* a, Graph* b) {
+    if (a->num_vertices != b->num_vertices) return false;
+    for (int v = 0; v < a->num_vertices; v++) {
+        EdgeNode* x = a->vertices[v].edges;
+        EdgeNode* y = b->vertices[v].edges;
+        for (; x && y; x = x->next, y = y->next) {
+            if (x->dest != y->dest || x->weight != y->weight) return false;
+        }
+        if (x || y) return false;
+    }
+    return true;
+}
+
+/**
+ * Test 19: Parallel Loading
+ */
+void test_parallel_loading() {
+    printf("\n=== Test 19: Parallel Loading ===\n");
+    const char* vertices_file = "test_parallel_vertices.txt";
+    const char* distances_file = "test_parallel_distances.txt";
+    
+    FILE* file = fopen(vertices_file, "w");
+    for (int i = 0; i < 200; i++) fprintf(file, "v%d\n", i);
+    fclose(file);
+    
+    // Random roads with parallel roads, self loops, blank and malformed lines
+    file = fopen(distances_file, "w");
+    unsigned int seed = 19;
+    for (int line = 0; line < 5000; line++) {
+        seed = seed * 1103515245u + 12345u;
+        int a = (seed >> 8) % 200;
+        seed = seed * 1103515245u + 12345u;
+        int b = (seed >> 8) % 200;
+        if (line % 997 == 0) fprintf(file, "v%d oops\n", a);
+        else if (line % 499 == 0) fprintf(file, "\n");
+        else fprintf(file, "v%d v%d %d\n", a, b, 1 + (int)((seed >> 4) % 500));
+    }
+    fprintf(file, "v1 v2 3");  // No trailing newline
+    fclose(file);
+    
+    Graph* sequential = graph_create(50);
+    load_vertices(sequential, vertices_file);
+    graph_add_edge(sequential, "v0", "v1", 9);  // Existing roads stay behind the new ones
+    load_distances(sequential, distances_file);
+    
+    bool identical = true;
+    int thread_counts[] = {1, 2, 3, 8, 64};
+    for (int t = 0; t < 5; t++) {
+        Graph* parallel = graph_create(50);
+        load_vertices(parallel, vertices_file);
+        graph_add_edge(parallel, "v0", "v1", 9);
+        bool loaded = load_distances_parallel(parallel, distances_file, thread_counts[t]);
+        if (!loaded || !same_adjacency(sequential, parallel)) identical = false;
+        graph_destroy(parallel);
+    }
+    assert_test(identical, "Parallel load matches the sequential loader for any thread count");
+    
+    // The small bundled files split into more ranges than lines
+    Graph* small = graph_create(50);
+    Graph* small_parallel = graph_create(50);
+    load_vertices(small, "vertices.txt");
+    load_distances(small, "distances.txt");
+    load_vertices(small_parallel, "vertices.txt");
+    load_distances_parallel(small_parallel, "distances.txt", 16);
+    assert_test(same_adjacency(small, small_parallel), "More threads than lines still loads correctly");
+    
+    graph_destroy(small);
+    graph_destroy(small_parallel);
+    graph_destroy(sequential);
+    remove(vertices_file);
+    remove(distances_file);
+}
+
+/**
+ * Query through the cache the way map.out does
+ */
+PathResult cached_route(RouteCache* cache, Graph* graph, int start, int end) {
+    PathResult result;
+    if (!route_cache_lookup(cache, graph, start, end, &result)) {
+        result = dijkstra_shortest_path(graph, start, end);
+        route_cache_store(cache, graph, start, end, &result);
+    }
+    return result;
+}
+
+/**
+ * Test 20: Route Cache
+ */
+void test_route_cache() {
+    printf("\n=== Test 20: Route Cache ===\n");
+    
+    Graph* graph = graph_create(50);
+    load_vertices(graph, "cities_large.txt");
+    load_distances(graph, "cities_distances_large.txt");
+    RouteCache* cache = route_cache_create(3);
+    
+    // Second query is a hit, in either direction, with a valid path
+    PathResult first = cached_route(cache, graph, 0, 20);
+    PathResult again = cached_route(cache, graph, 0, 20);
+    PathResult reverse = cached_route(cache, graph, 20, 0);
+    assert_test(cache->hits == 2 && cache->misses == 1, "Repeated and reversed pairs are hits");
+    assert_test(again.total_distance == first.total_distance && reverse.total_distance == first.total_distance &&
+                path_is_valid(graph, &reverse, 20, 0), "Reversed hit returns the path walked backwards");
+    path_result_destroy(&first);
+    path_result_destroy(&again);
+    path_result_destroy(&reverse);
+    
+    // Fill past capacity: (0, 20) is used again before (4, 5) arrives, so (0, 3) is the oldest
+    PathResult scratch;
+    int pairs[][2] = {{0, 3}, {1, 2}, {0, 20}, {4, 5}};
+    for (int i = 0; i < 4; i++) {
+        scratch = cached_route(cache, graph, pairs[i][0], pairs[i][1]);
+        path_result_destroy(&scratch);
+    }
+    bool evicted = !route_cache_lookup(cache, graph, 3, 0, &scratch);
+    bool kept = route_cache_lookup(cache, graph, 20, 0, &scratch);
+    if (kept) path_result_destroy(&scratch);
+    assert_test(evicted && kept && cache->evictions == 1 && cache->size == 3,
+                "Least recently used pair is evicted first");
+    
+    // Any change to the graph empties the cache
+    graph_add_edge_index(graph, 0, 20, 1);
+    PathResult after = cached_route(cache, graph, 0, 20);
+    assert_test(cache->invalidations == 1 && cache->size == 1 && after.total_distance == 1,
+                "Changing the graph invalidates cached answers");
+    path_result_destroy(&after);
+    
+    // Capacity 0 never stores anything
+    RouteCache* disabled = route_cache_create(0);
+    scratch = cached_route(disabled, graph, 0, 1);
+    path_result_destroy(&scratch);
+    assert_test(!route_cache_lookup(disabled, graph, 0, 1, &scratch), "Zero capacity disables the cache");
+    
+    route_cache_destroy(disabled);
+    route_cache_destroy(cache);
+    graph_destroy(graph);
+}
+
+/**
+ * Test 21: Shortest Path Trees
+ */
+void test_path_tree() {
+    printf("\n=== Test 21: Shortest Path Trees ===\n");
+    
+    // Sparse random graph so some destinations are unreachable
+    Graph* graph = build_random_graph(300, 330, 21, 50);
+    ShortestPathTree* tree = path_tree_create(graph, 7);
+    
+    bool same = true;
+    bool monotonic = true;
+    int last_settled = 0;
+    unsigned int seed = 21;
+    for (int q = 0; q < 100; q++) {
+        seed = seed * 1103515245u + 12345u;
+        int end = (seed >> 8) % graph->num_vertices;
+        PathResult fresh = dijkstra_shortest_path(graph, 7, end);
+        PathResult kept = path_tree_path(tree, end);
+        same = same && fresh.found == kept.found && fresh.total_distance == kept.total_distance &&
+               fresh.path_length == kept.path_length &&
+               (!fresh.found || memcmp(fresh.path, kept.path, sizeof(int) * fresh.path_length) == 0) &&
+               path_tree_distance(tree, end) == (fresh.found ? fresh.total_distance : INT_MAX);
+        if (kept.settled < last_settled) monotonic = false;
+        last_settled = kept.settled;
+        path_result_destroy(&fresh);
+        path_result_destroy(&kept);
+    }
+    assert_test(same, "Tree answers match fresh Dijkstra paths exactly");
+    assert_test(monotonic, "The tree only grows between queries");
+    
+    // Once a destination is settled, asking for it again needs no more searching
+    path_tree_reset(tree, 0);
+    int far_end = -1;
+    for (int v = 0; v < graph->num_vertices; v++) {
+        if (path_tree_distance(tree, v) != INT_MAX) far_end = v;  // Settles everything reachable
+    }
+    int settled_before = tree->ws->settled_count;
+    PathResult again = path_tree_path(tree, far_end);
+    assert_test(tree->ws->settled_count == settled_before && again.found, "Settled destinations are answered from the tree");
+    path_result_destroy(&again);
+    
+    // A new road invalidates the tree
+    graph_add_edge_index(graph, 0, 299, 1);
+    assert_test(path_tree_distance(tree, 299) == 1, "Changing the graph restarts the tree");
+    
+    path_tree_destroy(tree);
+    graph_destroy(graph);
+}
+
+/**
+ * Number of edges in the adjacency list of v
+ */
+int count_edges(Graph* graph, int v) {
+    int count = 0;
+    for (EdgeNode* edge = graph->vertices[v].edges; edge; edge = edge->next) count++;
+    return count;
+}
+
+/**
+ * Test 22: Road Updates And Incremental Repair
+ */
+void test_road_updates() {
+    printf("\n=== Test 22: Road Updates ===\n");
+    
+    Graph* graph = graph_create(4);
+    graph_add_vertex(graph, "a");
+    graph_add_vertex(graph, "b");
+    graph_add_vertex(graph, "c");
+    
+    // Adding a road twice changes its distance instead of duplicating it
+    graph_add_edge(graph, "a", "b", 5);
+    graph_add_edge(graph, "b", "a", 7);
+    int weight = 0;
+    assert_test(count_edges(graph, 0) == 1 && count_edges(graph, 1) == 1 &&
+                graph_find_edge(graph, 0, 1, &weight) && weight == 7, "Repeated road keeps the last distance");
+    
+    // A weight change patches the frozen layout in place
+    const CsrGraph* csr = graph_freeze(graph);
+    unsigned int version = graph->version;
+    bool updated = graph_update_edge(graph, "a", "b", 3);
+    assert_test(updated && graph->csr == csr && csr->weight[csr->offsets[1]] == 3 && graph->version == version + 1,
+                "Updating a road keeps the frozen layout");
+    assert_test(!graph_update_edge(graph, "a", "c", 1), "Updating a missing road fails");
+    
+    // Removal unlinks both directions and recycles the nodes
+    assert_test(graph_remove_edge(graph, "b", "a") && !graph_find_edge(graph, 0, 1, NULL) &&
+                !graph_find_edge(graph, 1, 0, NULL) && graph->csr == NULL, "Removing a road drops both directions");
+    assert_test(!graph_remove_edge(graph, "a", "b"), "Removing a missing road fails");
+    EdgeNode* recycled = graph->free_edges;
+    graph_add_edge(graph, "a", "c", 4);
+    assert_test(graph->vertices[0].edges == recycled, "Removed edge nodes are reused");
+    graph_destroy(graph);
+    
+    // Loaders merge repeated roads the same way
+    FILE* file = fopen("test_updates_distances.txt", "w");
+    fprintf(file, "a b 5\nb a 7\na a 2\na a 1\n");
+    fclose(file);
+    graph = graph_create(4);
+    graph_add_vertex(graph, "a");
+    graph_add_vertex(graph, "b");
+    load_distances(graph, "test_updates_distances.txt");
+    graph_find_edge(graph, 0, 1, &weight);
+    assert_test(count_edges(graph, 0) == 2 && count_edges(graph, 1) == 1 && weight == 7,
+                "Loading merges repeated roads");
+    graph_destroy(graph);
+    remove("test_updates_distances.txt");
+    
+    // Random changes with the tree, cache and landmarks repaired instead of rebuilt
+    graph = build_random_graph(200, 400, 22, 50);
+    graph_freeze(graph);
+    ShortestPathTree* tree = path_tree_create(graph, 3);
+    RouteCache* cache = route_cache_create(64);
+    Heuristic* landmarks = heuristic_landmarks(graph, 4);
+    DijkstraWorkspace* ws = dijkstra_workspace_create(graph->num_vertices);
+    
+    bool tree_ok = true;
+    bool cache_ok = true;
+    bool landmarks_ok = true;
+    unsigned int seed = 22;
+    for (int step = 0; step < 300; step++) {
+        seed = seed * 1103515245u + 12345u;
+        int kind = (seed >> 8) % 4;
+        seed = seed * 1103515245u + 12345u;
+        int a = (seed >> 8) % graph->num_vertices;
+        seed = seed * 1103515245u + 12345u;
+        int b = (seed >> 8) % graph->num_vertices;
+        
+        // Lengthen, shorten or close a's first road, or add a new one to b
+        RoadChange change;
+        change.from = a;
+        change.to = kind < 3 && graph->vertices[a].edges ? graph->vertices[a].edges->dest : b;
+        change.existed = graph_find_edge(graph, change.from, change.to, &change.old_weight);
+        change.exists = kind != 2;
+        change.new_weight = 1 + (seed >> 4) % 50;
+        if (change.existed && kind == 0) change.new_weight = change.old_weight + 5;
+        if (change.existed && kind == 1) change.new_weight = change.old_weight / 2;
+        if (!change.existed && !change.exists) continue;
+        if (change.exists) graph_add_edge_index(graph, change.from, change.to, change.new_weight);
+        else graph_remove_edge_index(graph, change.from, change.to);
+        
+        path_tree_repair(tree, &change);
+        route_cache_repair(cache, graph, &change);
+        heuristic_repair(landmarks, graph, &change);
+        
+        for (int q = 0; q < 5; q++) {
+            seed = seed * 1103515245u + 12345u;
+            int start = q == 0 ? 3 : (seed >> 8) % 20;  // Few origins, so the cache gets hits
+            int end = (seed >> 12) % graph->num_vertices;
+            PathResult fresh = dijkstra_shortest_path_ws(graph, ws, start, end);
+            int expected = fresh.found ? fresh.total_distance : INT_MAX;
+            path_result_destroy(&fresh);
+            
+            if (start == 3 && path_tree_distance(tree, end) != expected) tree_ok = false;
+            PathResult astar = astar_shortest_path(graph, landmarks, start, end);
+            if ((astar.found ? astar.total_distance : INT_MAX) != expected) landmarks_ok = false;
+            path_result_destroy(&astar);
+            PathResult cached = cached_route(cache, graph, start, end);
+            if ((cached.found ? cached.total_distance : INT_MAX) != expected) cache_ok = false;
+            path_result_destroy(&cached);
+        }
+    }
+    assert_test(tree_ok, "Repaired shortest path tree matches Dijkstra after every change");
+    assert_test(landmarks_ok, "Repaired landmarks keep A* exact after every change");
+    assert_test(cache_ok && cache->repairs > 0, "Cache repairs drop only answers through a longer road");
+    
+    dijkstra_workspace_destroy(ws);
+    heuristic_destroy(landmarks);
+    route_cache_destroy(cache);
+    path_tree_destroy(tree);
+    graph_destroy(graph);
+}
+
+/**
+ * Test 23: Search Counters And Latency Histograms
+ */
+void test_profile() {
+    printf("\n=== Test 23: Profiling ===\n");
+    
+    // 99 fast queries and one slow one
+    LatencyHistogram latency;
+    latency_clear(&latency);
+    for (int i = 0; i < 99; i++) latency_record(&latency, 10e-6, 5);
+    latency_record(&latency, 10e-3, 5000);
+    double p50 = latency_percentile(&latency, 0.5);
+    double p99 = latency_percentile(&latency, 0.99);
+    assert_test(p50 >= 10e-6 && p50 < 12e-6 && p99 == p50, "Percentiles land in the bucket of the bulk");
+    assert_test(latency_percentile(&latency, 1.0) == 10e-3, "Top percentile is the slowest query");
+    
+    LatencyHistogram merged;
+    latency_clear(&merged);
+    latency_merge(&merged, &latency);
+    latency_merge(&merged, &latency);
+    assert_test(merged.total == 200 && merged.max_seconds == latency.max_seconds &&
+                latency_percentile(&merged, 0.5) == p50, "Merged histograms add their counts");
+    
+    // Counters follow the search (or stay at zero when compiled out)
+    Graph* graph = build_random_graph(100, 300, 23, 20);
+    graph_freeze(graph);
+    DijkstraWorkspace* ws = dijkstra_workspace_create(graph->num_vertices);
+    PathResult result = dijkstra_shortest_path_ws(graph, ws, 0, 99);
+    const SearchCounters* counters = &ws->counters;
+    if (PROFILE_ENABLED) {
+        assert_test(counters->searches == 1 && counters->settled == result.settled &&
+                    counters->heap_pushes >= counters->settled && counters->relaxed >= counters->heap_pushes - 1,
+                    "Search counters match the search");
+        assert_test(graph->counters.freezes == 1, "Graph counts its freezes");
+    } else {
+        assert_test(counters->searches == 0 && counters->settled == 0 && graph->counters.freezes == 0,
+                    "Counters stay at zero when profiling is compiled out");
+    }
+    path_result_destroy(&result);
+    
+    // The JSON dump is one object with the percentiles in it
+    FILE* file = tmpfile();
+    profile_print_json(file, &latency, counters, &graph->counters);
+    rewind(file);
+    char line[4096] = "";
+    bool read = fgets(line, sizeof(line), file) != NULL;
+    fclose(file);
+    assert_test(read && line[0] == '{' && strstr(line, "\"p99\"") && strstr(line, "\"histogram\": [{"),
+                "JSON dump holds latencies and the histogram");
+    
+    dijkstra_workspace_destroy(ws);
+    graph_destroy(graph);
+}
+
+/**
+ * Test 24: Vertex Reordering
+ */
+void test_reorder() {
+    printf("\n=== Test 24: Vertex Reordering ===\n");
+    
+    // Random graph with a few components, renumbered breadth-first
+    Graph* graph = build_random_graph(80, 120, 24, 30);
+    Graph* reordered = build_random_graph(80, 120, 24, 30);
+    int* order = reorder_cuthill_mckee(reordered);
+    bool permutation = true;
+    bool* seen = (bool*)calloc(80, sizeof(bool));
+    for (int i = 0; i < 80; i++) {
+        permutation = permutation && order[i] >= 0 && order[i] < 80 && !seen[order[i]];
+        if (permutation) seen[order[i]] = true;
+    }
+    free(seen);
+    assert_test(permutation && graph_relabel(reordered, order), "Cuthill-McKee order is a permutation");
+    free(order);
+    
+    // Names follow their cities and the original positions point back at them
+    bool names_ok = true;
+    for (int v = 0; v < reordered->num_vertices; v++) {
+        int original = graph_original_index(reordered, v);
+        names_ok = names_ok && strcmp(reordered->vertices[v].name, graph->vertices[original].name) == 0 &&
+                   graph_find_vertex(reordered, reordered->vertices[v].name) == v;
+    }
+    assert_test(names_ok, "Names and original positions survive relabeling");
+    
+    // Same distance for every pair; paths mapped back are real paths in file order
+    bool same = true;
+    for (int a = 0; same && a < 80; a++) {
+        for (int b = 0; same && b < 80; b++) {
+            int ra = graph_find_vertex(reordered, graph->vertices[a].name);
+            int rb = graph_find_vertex(reordered, graph->vertices[b].name);
+            PathResult expected = dijkstra_shortest_path(graph, a, b);
+            PathResult actual = dijkstra_shortest_path(reordered, ra, rb);
+            reorder_path_to_original(reordered, &actual);
+            same = expected.found == actual.found && expected.total_distance == actual.total_distance &&
+                   path_is_valid(graph, &actual, a, b);
+            path_result_destroy(&expected);
+            path_result_destroy(&actual);
+        }
+    }
+    assert_test(same, "Reordered graph answers every pair in file order");
+    
+    // A second relabeling composes with the first
+    int reverse[80];
+    for (int i = 0; i < 80; i++) reverse[i] = 79 - i;
+    int before = graph_original_index(reordered, 79);
+    assert_test(graph_relabel(reordered, reverse) && graph_original_index(reordered, 0) == before,
+                "Relabeling twice keeps original positions");
+    reverse[1] = reverse[0];
+    assert_test(!graph_relabel(reordered, reverse), "Order with a repeated vertex is rejected");
+    
+    // Snapshots carry the order along
+    const char* filename = "test_reorder.bin";
+    Graph* mapped = snapshot_write(reordered, filename) ? snapshot_load(filename) : NULL;
+    bool kept = mapped != NULL;
+    for (int v = 0; kept && v < 80; v++) {
+        kept = graph_original_index(mapped, v) == graph_original_index(reordered, v);
+    }
+    assert_test(kept && !reorder_graph(mapped, ORDER_BFS), "Snapshot keeps the order and stays read-only");
+    graph_destroy(mapped);
+    remove(filename);
+    
+    // A grid listed in scrambled order: both orders bring neighbours closer
+    Graph* grid = graph_create(16);
+    char name[16];
+    for (int i = 0; i < 100; i++) {
+        int cell = (i * 37) % 100;  // 37 is coprime to 100, so every cell appears once
+        snprintf(name, sizeof(name), "g%d", cell);
+        int v = graph_add_vertex(grid, name);
+        graph_set_coordinates(grid, v, 40.0 + (cell / 10) * 0.01, -70.0 + (cell % 10) * 0.01);
+    }
+    for (int cell = 0; cell < 100; cell++) {
+        char next[16];
+        snprintf(name, sizeof(name), "g%d", cell);
+        if (cell % 10 < 9) {
+            snprintf(next, sizeof(next), "g%d", cell + 1);
+            graph_add_edge(grid, name, next, 1);
+        }
+        if (cell < 90) {
+            snprintf(next, sizeof(next), "g%d", cell + 10);
+            graph_add_edge(grid, name, next, 1);
+        }
+    }
+    double scrambled = reorder_edge_span(grid);
+    assert_test(reorder_graph(grid, ORDER_HILBERT) && reorder_edge_span(grid) < scrambled / 2,
+                "Hilbert order shortens the index gap across roads");
+    assert_test(reorder_graph(grid, ORDER_BFS) && reorder_edge_span(grid) < scrambled / 2,
+                "Cuthill-McKee order shortens the index gap across roads");
+    assert_test(reorder_hilbert(graph) == NULL, "Hilbert order needs coordinates");
+    
+    graph_destroy(grid);
+    graph_destroy(reordered);
+    graph_destroy(graph);
+}
+
+/**
+ * Server thread body for test 25
+ */
+void* run_test_server(void* server) {
+    server_run((Server*)server);
+    return NULL;
+}
+
+/**
+ * Connect to a Unix socket, send text and read until the server closes the connection
+ */
+bool server_exchange(const char* socket_path, const char* request, size_t request_length,
+                     char* response, size_t capacity) {
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, socket_path, sizeof(address.sun_path) - 1);
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, (struct sockaddr*)&address, sizeof(address)) != 0) {
+        if (fd >= 0) close(fd);
+        return false;
+    }
+    
+    bool ok = send(fd, request, request_length, MSG_NOSIGNAL) == (ssize_t)request_length;
+    size_t length = 0;
+    ssize_t received;
+    while (ok && length + 1 < capacity && (received = read(fd, response + length, capacity - 1 - length)) > 0) {
+        length += (size_t)received;
+    }
+    response[length] = '\0';
+    close(fd);
+    return ok;
+}
+
+/**
+ * Test 25: Route Server
+ */
+void test_server() {
+    printf("\n=== Test 25: Route Server ===\n");
+    const char* socket_path = "test_server.sock";
+    
+    Graph* graph = graph_create(50);
+    load_vertices(graph, "cities_large.txt");
+    load_distances(graph, "cities_distances_large.txt");
+    RouteEngine engine = {graph, NULL, NULL, false, NULL, NULL};
+    Server* server = server_create(&engine, socket_path, 3);
+    assert_test(server != NULL, "Server listens on a Unix socket");
+    if (!server) {
+        graph_destroy(graph);
+        return;
+    }
+    pthread_t thread;
+    pthread_create(&thread, NULL, run_test_server, server);
+    
+    // Pipelined requests come back one line each, in order
+    char request[4096] = "";
+    char expected[8192] = "";
+    int pairs = 0;
+    for (int a = 0; a < graph->num_vertices; a += 5) {
+        for (int b = 1; b < graph->num_vertices; b += 7) {
+            size_t used = strlen(request);
+            snprintf(request + used, sizeof(request) - used, "%s %s\n", graph->vertices[a].name,
+                     graph->vertices[b].name);
+            PathResult result = dijkstra_shortest_path(graph, a, b);
+            used = strlen(expected);
+            if (!result.found) {
+                snprintf(expected + used, sizeof(expected) - used, "NONE\n");
+            } else {
+                used += snprintf(expected + used, sizeof(expected) - used, "OK %d", result.total_distance);
+                for (int i = 0; i < result.path_length; i++) {
+                    used += snprintf(expected + used, sizeof(expected) - used, " %s",
+                                     graph->vertices[result.path[i]].name);
+                }
+                snprintf(expected + used, sizeof(expected) - used, "\n");
+            }
+            path_result_destroy(&result);
+            pairs++;
+        }
+    }
+    strcat(request, "ping\n\nAtlantis austin\nhello\nquit\nping\n");
+    strcat(expected, "PONG\nERROR unknown city\nERROR expected <city1> <city2>\n");
+    char response[8192];
+    bool exchanged = server_exchange(socket_path, request, strlen(request), response, sizeof(response));
+    assert_test(exchanged && strcmp(response, expected) == 0, "Answers match Dijkstra line for line");
+    
+    // A line longer than the buffer is refused and the connection dropped
+    char flood[2048];
+    memset(flood, 'x', sizeof(flood));
+    exchanged = server_exchange(socket_path, flood, sizeof(flood), response, sizeof(response));
+    assert_test(strcmp(response, "ERROR line too long\n") == 0, "Overlong line closes the connection");
+    
+    server_stop(server);
+    pthread_join(thread, NULL);
+    ServerStats stats;
+    server_destroy(server, &stats);
+    assert_test(stats.connections == 2 && stats.queries == pairs && stats.invalid == 3,
+                "Server counts connections, queries and errors");
+    assert_test(access(socket_path, F_OK) != 0, "Socket file is removed on shutdown");
+    
+    graph_destroy(graph);
+}
+
+/**
+ * Test 26: Bucket Queue Dijkstra
+ */
+void test_bucket_queue() {
+    printf("\n=== Test 26: Bucket Queue Dijkstra ===\n");
+    
+    // Keys within the span come out in order; decrease-key moves a vertex between buckets
+    BucketQueue* queue = bucket_queue_create(6, 10);
+    bucket_queue_push(queue, 0, 7);
+    bucket_queue_push(queue, 1, 3);
+    bucket_queue_push(queue, 2, 10);
+    bool lowered = bucket_queue_push(queue, 2, 1);
+    bool raised = bucket_queue_push(queue, 0, 9);
+    int k1, k2, k3;
+    int v1 = bucket_queue_pop(queue, &k1);
+    bucket_queue_push(queue, 3, 11);  // Within the span of the popped key 1
+    int v2 = bucket_queue_pop(queue, &k2);
+    int v3 = bucket_queue_pop(queue, &k3);
+    assert_test(lowered && !raised && v1 == 2 && k1 == 1 && v2 == 1 && k2 == 3 && v3 == 0 && k3 == 7,
+                "Bucket queue pops in key order with decrease-key");
+    bucket_queue_clear(queue);
+    bucket_queue_push(queue, 4, 2);
+    assert_test(bucket_queue_pop(queue, &k1) == 4 && k1 == 2 && bucket_queue_is_empty(queue),
+                "Cleared bucket queue starts over at key 0");
+    bucket_queue_destroy(queue);
+    
+    // Same distances as the heap for every pair, with one workspace reused throughout
+    Graph* graph = build_random_graph(150, 260, 26, 40);
+    graph_freeze(graph);
+    DijkstraWorkspace* heap_ws = dijkstra_workspace_create(150);
+    DijkstraWorkspace* dial_ws = dijkstra_workspace_create(150);
+    bool same = true;
+    for (int a = 0; same && a < 150; a++) {
+        for (int b = 0; same && b < 150; b++) {
+            PathResult expected = dijkstra_shortest_path_ws(graph, heap_ws, a, b);
+            PathResult actual = dijkstra_shortest_path_dial(graph, dial_ws, a, b);
+            same = expected.found == actual.found && expected.total_distance == actual.total_distance &&
+                   path_is_valid(graph, &actual, a, b);
+            path_result_destroy(&expected);
+            path_result_destroy(&actual);
+        }
+    }
+    assert_test(same && dial_ws->buckets != NULL && dial_ws->buckets->num_buckets == graph->csr->max_weight + 1,
+                "Bucket queue engine matches heap Dijkstra on every pair");
+    
+    // A road too long for the buckets falls back to the heap with the same answers
+    int u = 0;
+    while (!graph->vertices[u].edges) u++;
+    int v = graph->vertices[u].edges->dest;
+    graph_update_edge_index(graph, u, v, DIAL_MAX_WEIGHT + 1);
+    RouteEngine engine = {graph, NULL, NULL, true, NULL, NULL};
+    bool fallback = graph->csr->max_weight > DIAL_MAX_WEIGHT;
+    for (int b = 0; fallback && b < 150; b++) {
+        PathResult expected = dijkstra_shortest_path_ws(graph, heap_ws, u, b);
+        PathResult actual = route_find(&engine, dial_ws, NULL, u, b);
+        fallback = expected.found == actual.found && expected.total_distance == actual.total_distance;
+        path_result_destroy(&expected);
+        path_result_destroy(&actual);
+    }
+    assert_test(fallback, "Long road falls back to the heap");
+    
+    // A negative road would index a bucket below zero: the heap takes it too
+    Graph* negative = graph_create(4);
+    graph_add_vertex(negative, "a");
+    graph_add_vertex(negative, "b");
+    graph_add_vertex(negative, "c");
+    graph_add_edge(negative, "a", "b", 5);
+    graph_add_edge(negative, "b", "c", -2);
+    graph_freeze(negative);
+    PathResult expected = dijkstra_shortest_path_ws(negative, heap_ws, 1, 0);
+    PathResult actual = dijkstra_shortest_path_dial(negative, dial_ws, 1, 0);
+    assert_test(negative->csr->min_weight == -2 && actual.found == expected.found &&
+                actual.total_distance == expected.total_distance, "Negative road falls back to the heap");
+    path_result_destroy(&expected);
+    path_result_destroy(&actual);
+    graph_destroy(negative);
+    
+    dijkstra_workspace_destroy(heap_ws);
+    dijkstra_workspace_destroy(dial_ws);
+    graph_destroy(graph);
+}
+
+/**
+ * Check that parent[] is a shortest path tree for dist[] rooted at source
+ */
+bool tree_is_valid(const Graph* graph, int source, const int* dist, const int* parent) {
+    for (int v = 0; v < graph->num_vertices; v++) {
+        int weight;
+        if (v == source || dist[v] == INT_MAX) {
+            if (parent[v] != -1) return false;
+        } else if (parent[v] < 0 || !graph_find_edge(graph, parent[v], v, &weight) ||
+                   dist[parent[v]] + weight != dist[v]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Test 27: Delta-Stepping
+ */
+void test_delta_stepping() {
+    printf("\n=== Test 27: Delta-Stepping ===\n");
+    
+    // Exact distances for every thread count and bucket width, some vertices unreachable
+    Graph* graph = build_random_graph(400, 520, 27, 60);
+    int n = graph->num_vertices;
+    int* dist = (int*)malloc(sizeof(int) * n);
+    int* parent = (int*)malloc(sizeof(int) * n);
+    int* first_parent = (int*)malloc(sizeof(int) * n);
+    DijkstraWorkspace* ws = dijkstra_workspace_create(n);
+    int thread_counts[] = {1, 2, 4};
+    int deltas[] = {0, 1, 25, 1000};
+    bool exact = true, trees = true, same_parents = true;
+    for (int source = 0; source < n; source += 37) {
+        dijkstra_search_all(graph, ws, source);
+        for (int t = 0; t < 3; t++) {
+            for (int d = 0; d < 4; d++) {
+                DeltaOptions options = {thread_counts[t], deltas[d]};
+                delta_stepping(graph, source, dist, parent, &options);
+                for (int v = 0; v < n; v++) {
+                    exact = exact && dist[v] == dijkstra_workspace_distance(ws, v);
+                    if (t == 0 && d == 0) first_parent[v] = parent[v];
+                    same_parents = same_parents && parent[v] == first_parent[v];
+                }
+                trees = trees && tree_is_valid(graph, source, dist, parent);
+            }
+        }
+    }
+    assert_test(exact, "Delta-stepping distances match Dijkstra");
+    assert_test(trees, "Delta-stepping parents form a shortest path tree");
+    assert_test(same_parents, "Parents do not depend on threads or bucket width");
+    
+    // A road of length 0 sends the search to sequential Dijkstra
+    int u = 0;
+    while (!graph->vertices[u].edges) u++;
+    graph_update_edge_index(graph, u, graph->vertices[u].edges->dest, 0);
+    DeltaOptions options = {4, 0};
+    int rounds = delta_stepping(graph, u, dist, parent, &options);
+    dijkstra_search_all(graph, ws, u);
+    bool fallback = rounds == 1 && tree_is_valid(graph, u, dist, parent);
+    for (int v = 0; v < n; v++) fallback = fallback && dist[v] == dijkstra_workspace_distance(ws, v);
+    assert_test(fallback, "Zero-length road falls back to Dijkstra");
+    
+    free(dist);
+    free(parent);
+    free(first_parent);
+    dijkstra_workspace_destroy(ws);
+    graph_destroy(graph);
+}
+
+/**
+ * Check the component labels against full searches from every vertex
+ */
+bool components_match_search(Graph* graph, DijkstraWorkspace* ws) {
+    for (int a = 0; a < graph->num_vertices; a++) {
+        dijkstra_search_all(graph, ws, a);
+        int reachable = 0;
+        for (int b = 0; b < graph->num_vertices; b++) {
+            bool reached = dijkstra_workspace_distance(ws, b) != INT_MAX;
+            if (reached) reachable++;
+            if (graph_same_component(graph, a, b) != reached) return false;
+        }
+        if (graph_component_size(graph, a) != reachable) return false;
+    }
+    return true;
+}
+
+/**
+ * Test 28: Connected Components
+ */
+void test_components() {
+    printf("\n=== Test 28: Connected Components ===\n");
+    
+    // Fewer roads than cities: plenty of separate components, merged as roads are added
+    Graph* graph = build_random_graph(200, 170, 28, 30);
+    DijkstraWorkspace* ws = dijkstra_workspace_create(200);
+    assert_test(components_match_search(graph, ws), "Labels merged while adding roads match reachability");
+    
+    // A pair in different components is answered without settling anything
+    int a = 0, b = 1;
+    while (graph_same_component(graph, a, b)) b++;
+    RouteEngine engine = {graph, NULL, NULL, false, NULL, NULL};
+    PathResult result = dijkstra_shortest_path_ws(graph, ws, a, b);
+    PathResult routed = route_find(&engine, ws, NULL, a, b);
+    assert_test(!result.found && result.settled == 0 && !routed.found && routed.settled == 0,
+                "Cross-component pair is rejected without a search");
+    
+    // Closing roads leaves the labels unsure until the next freeze recomputes them
+    for (int u = 0, closed = 0; u < 200 && closed < 20; u++) {
+        if (graph->vertices[u].edges && graph_remove_edge_index(graph, u, graph->vertices[u].edges->dest)) closed++;
+    }
+    bool unsure = graph_same_component(graph, a, b);
+    graph_freeze(graph);
+    assert_test(unsure && components_match_search(graph, ws), "Closed roads relabel components on freeze");
+    
+    // Relabeling and snapshots keep the labels
+    int* order = reorder_cuthill_mckee(graph);
+    graph_relabel(graph, order);
+    free(order);
+    bool relabeled = components_match_search(graph, ws);
+    const char* filename = "test_components.bin";
+    Graph* mapped = snapshot_write(graph, filename) ? snapshot_load(filename) : NULL;
+    assert_test(relabeled && mapped && components_match_search(mapped, ws),
+                "Relabeled and snapshot graphs keep their components");
+    
+    graph_destroy(mapped);
+    remove(filename);
+    dijkstra_workspace_destroy(ws);
+    graph_destroy(graph);
+}
+
+/**
+ * Check every pair of an all-pairs table against Dijkstra, paths included
+ */
+bool apsp_matches_search(Graph* graph, const AllPairsTable* table, DijkstraWorkspace* ws) {
+    bool match = true;
+    for (int start = 0; start < graph->num_vertices; start++) {
+        dijkstra_search_all(graph, ws, start);
+        for (int end = 0; end < graph->num_vertices; end++) {
+            PathResult result = apsp_path(table, start, end);
+            match = match && apsp_distance(table, start, end) == dijkstra_workspace_distance(ws, end) &&
+                    (result.found ? result.total_distance : INT_MAX) == dijkstra_workspace_distance(ws, end) &&
+                    path_is_valid(graph, &result, start, end);
+            path_result_destroy(&result);
+        }
+    }
+    return match;
+}
+
+/**
+ * Test 29: All-pairs table
+ */
+void test_apsp() {
+    printf("\n=== Test 29: All-Pairs Table ===\n");
+    
+    // 100 cities span two tiles, so every blocked phase runs; some cities stay unreachable
+    Graph* graph = build_random_graph(100, 140, 29, 40);
+    DijkstraWorkspace* ws = dijkstra_workspace_create(100);
+    AllPairsTable* floyd = apsp_build(graph, APSP_FLOYD, 2);
+    AllPairsTable* rows = apsp_build(graph, APSP_DIJKSTRA, 2);
+    assert_test(floyd->method == APSP_FLOYD && apsp_matches_search(graph, floyd, ws),
+                "Blocked Floyd-Warshall matches Dijkstra on every pair");
+    assert_test(rows->method == APSP_DIJKSTRA && apsp_matches_search(graph, rows, ws),
+                "Repeated Dijkstra matches Dijkstra on every pair");
+    
+    // The route engine reads the table before anything else
+    RouteEngine engine = {graph, NULL, NULL, false, floyd, NULL};
+    PathResult routed = route_find(&engine, ws, NULL, 0, 1);
+    PathResult searched = dijkstra_shortest_path_ws(graph, ws, 0, 1);
+    assert_test(routed.settled == 0 && routed.found == searched.found &&
+                (!routed.found || routed.total_distance == searched.total_distance),
+                "Route engine answers from the table");
+    path_result_destroy(&routed);
+    path_result_destroy(&searched);
+    apsp_destroy(floyd);
+    apsp_destroy(rows);
+    
+    // Roads of length 0 always get Floyd-Warshall, whose next hops cannot go round in circles
+    graph_add_edge_index(graph, 0, 1, 0);
+    graph_add_edge_index(graph, 1, 2, 0);
+    AllPairsTable* free_roads = apsp_build(graph, APSP_DIJKSTRA, 1);
+    assert_test(free_roads->method == APSP_FLOYD && apsp_choose(graph) == APSP_FLOYD &&
+                apsp_matches_search(graph, free_roads, ws), "Zero-length roads fall back to Floyd-Warshall");
+    apsp_destroy(free_roads);
+    
+    // A snapshot graph has no adjacency lists: roads are counted and checked in its CSR
+    // (paths are checked against the text-built graph, which has the same indices)
+    const char* filename = "test_apsp_snapshot.bin";
+    snapshot_write(graph, filename);
+    Graph* mapped = snapshot_load(filename);
+    AllPairsTable* mapped_table = mapped ? apsp_build(mapped, APSP_DIJKSTRA, 1) : NULL;
+    assert_test(mapped_table && mapped_table->method == APSP_FLOYD && apsp_choose(mapped) == APSP_FLOYD &&
+                apsp_matches_search(graph, mapped_table, ws), "Snapshot graph with zero-length roads gets Floyd-Warshall");
+    apsp_destroy(mapped_table);
+    graph_destroy(mapped);
+    remove(filename);
+    
+    dijkstra_workspace_destroy(ws);
+    graph_destroy(graph);
+}
+
+/**
+ * Test 30: Compressed adjacency
+ */
+void test_compact() {
+    printf("\n=== Test 30: Compressed Adjacency ===\n");
+    
+    // Lengths above 127 and far-apart neighbours need multi-byte varints
+    Graph* graph = build_random_graph(300, 900, 30, 5000);
+    graph_add_edge_index(graph, 0, 299, 70000);
+    CompactGraph* compact = compact_build(graph);
+    int* dest = (int*)malloc(sizeof(int) * 300);
+    int* weight = (int*)malloc(sizeof(int) * 300);
+    bool decoded = compact->num_edges == graph_freeze(graph)->num_edges;
+    for (int u = 0; u < 300; u++) {
+        int degree = compact_neighbours(compact, u, dest, weight);
+        int expected = graph->csr->offsets[u + 1] - graph->csr->offsets[u];
+        decoded = decoded && degree == expected;
+        for (int i = 0; i < degree; i++) {
+            int stored;
+            decoded = decoded && (i == 0 || dest[i] > dest[i - 1]) &&
+                      graph_find_edge(graph, u, dest[i], &stored) && stored == weight[i];
+        }
+    }
+    assert_test(decoded, "Packed neighbours decode to the same roads in index order");
+    assert_test(compact_bytes(compact) < graph->csr->num_edges * 2 * sizeof(int),
+                "Packed adjacency is smaller than the CSR arrays");
+    
+    // Searches decoding the stream agree with the CSR, also through the route engine
+    DijkstraWorkspace* ws = dijkstra_workspace_create(300);
+    RouteEngine engine = {graph, NULL, NULL, false, NULL, compact};
+    bool match = true;
+    for (int q = 0; q < 100; q++) {
+        int start = (q * 37) % 300, end = (q * 91 + 7) % 300;
+        PathResult packed = compact_shortest_path(compact, ws, start, end);
+        PathResult routed = route_find(&engine, ws, NULL, start, end);
+        PathResult plain = dijkstra_shortest_path_ws(graph, ws, start, end);
+        match = match && packed.found == plain.found && routed.found == plain.found &&
+                (!plain.found || (packed.total_distance == plain.total_distance &&
+                                  routed.total_distance == plain.total_distance)) &&
+                path_is_valid(graph, &packed, start, end);
+        path_result_destroy(&packed);
+        path_result_destroy(&routed);
+        path_result_destroy(&plain);
+    }
+    assert_test(match, "Dijkstra over the packed adjacency matches the CSR");
+    
+    // Once the packed copy replaces the lists and CSR, no route query builds them again (buckets included)
+    GraphMemoryStats full, released;
+    graph_memory_stats(graph, &full);
+    compact_destroy(compact);
+    compact = compact_replace_edges(graph);
+    graph_memory_stats(graph, &released);
+    RouteEngine packed_engine = {graph, NULL, NULL, true, NULL, compact};
+    bool thawed = graph->csr == NULL;
+    bool answered = true;
+    for (int q = 0; q < 20; q++) {
+        PathResult routed = route_find(&packed_engine, ws, NULL, q, 299 - q);
+        PathResult packed = compact_shortest_path(compact, ws, q, 299 - q);
+        answered = answered && routed.found == packed.found && routed.total_distance == packed.total_distance;
+        path_result_destroy(&routed);
+        path_result_destroy(&packed);
+    }
+    assert_test(thawed && graph->csr == NULL && answered, "CSR stays freed while the packed copy serves queries");
+    assert_test(released.edge_bytes == 0 && released.arena_reserved < full.arena_reserved &&
+                graph_find_vertex(graph, "v299") == 299, "Edge nodes are freed and the cities kept");
+    
+    // Restoring the roads gives back the same graph: every answer matches the packed copy
+    unsigned int version = graph->version;
+    compact_restore_edges(compact, graph);
+    bool restored = graph->version == version && graph_freeze(graph)->num_edges == compact->num_edges;
+    for (int q = 0; restored && q < 100; q++) {
+        int start = (q * 37) % 300, end = (q * 91 + 7) % 300;
+        PathResult packed = compact_shortest_path(compact, ws, start, end);
+        PathResult plain = dijkstra_shortest_path_ws(graph, ws, start, end);
+        restored = packed.found == plain.found && packed.total_distance == plain.total_distance &&
+                   path_is_valid(graph, &plain, start, end);
+        path_result_destroy(&packed);
+        path_result_destroy(&plain);
+    }
+    assert_test(restored, "Restored roads match the packed copy");
+    
+    // A snapshot graph has no lists: the packed copy comes from its CSR
+    const char* filename = "test_compact_snapshot.bin";
+    snapshot_write(graph, filename);
+    Graph* mapped = snapshot_load(filename);
+    CompactGraph* mapped_compact = mapped ? compact_replace_edges(mapped) : NULL;
+    bool from_snapshot = mapped_compact && mapped_compact->num_edges == graph->csr->num_edges;
+    for (int q = 0; from_snapshot && q < 100; q++) {
+        int start = (q * 37) % 300, end = (q * 91 + 7) % 300;
+        PathResult packed = compact_shortest_path(mapped_compact, ws, start, end);
+        PathResult plain = dijkstra_shortest_path_ws(graph, ws, start, end);
+        from_snapshot = packed.found == plain.found && packed.total_distance == plain.total_distance &&
+                        path_is_valid(graph, &packed, start, end);
+        path_result_destroy(&packed);
+        path_result_destroy(&plain);
+    }
+    assert_test(from_snapshot, "Snapshot graph packs and finds the same paths");
+    compact_destroy(mapped_compact);
+    graph_destroy(mapped);
+    remove(filename);
+    
+    free(dest);
+    free(weight);
+    dijkstra_workspace_destroy(ws);
+    compact_destroy(compact);
+    graph_destroy(graph);
+}
+
 /**
  * Main test runner
  */
@@ -143,6 +1946,31 @@ int main(void) {
     test_find_vertices();
     test_add_edges();
     test_shortest_path();
+    test_priority_queue();
+    test_heap_matches_scan();
+    test_hash_index();
+    test_csr_layout();
+    test_arena();
+    test_workspace_reuse();
+    test_bidirectional();
+    test_astar();
+    test_contraction_hierarchy();
+    test_batch_queries();
+    test_distance_table();
+    test_snapshot();
+    test_streaming_loader();
+    test_parallel_loading();
+    test_route_cache();
+    test_path_tree();
+    test_road_updates();
+    test_profile();
+    test_reorder();
+    test_server();
+    test_bucket_queue();
+    test_delta_stepping();
+    test_components();
+    test_apsp();
+    test_compact();
     
     printf("\n========================================\n");
     printf("  Test Summary\n");